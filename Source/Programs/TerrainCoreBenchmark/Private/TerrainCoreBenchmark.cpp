@@ -0,0 +1,348 @@
+#include "RequiredProgramMainCPPInclude.h"
+#include "TerrainGrid.h"
+#include "TerrainGridMesher.h"
+#include "TerrainMeshTopology.h"
+#include "TerrainEditTimeline.h"
+#include "TerrainVoxelVolume.h"
+#include "TerrainVoxelMesher.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeExit.h"
+
+IMPLEMENT_APPLICATION(TerrainCoreBenchmark, "TerrainCoreBenchmark");
+
+// Micro-benchmark des fonctions de TerrainCore, hors moteur : chaque fonction est mesurée sur Passes passes
+// (médiane retenue), avec une préparation non chronométrée avant chaque passe.
+// TerrainCoreBenchmark [-Resolution=128] [-Passes=9] [-Seed=1234] [-Filter=Grid.] [-Csv=<fichier>]
+struct FTerrainCoreBenchmarkEntry
+{
+    FString Name;
+    int32 CallsPerPass = 1;
+    double MedianMs = 0.0;
+};
+
+static double MeasureMedianMs(int32 Passes, TFunctionRef<void()> Setup, TFunctionRef<void()> Body)
+{
+    TArray<double> Samples;
+    for (int32 Pass = 0; Pass < Passes; ++Pass)
+    {
+        Setup();
+        
+        const double Start = FPlatformTime::Seconds();
+        Body();
+        Samples.Add((FPlatformTime::Seconds() - Start) * 1000.0);
+    }
+    
+    Samples.Sort();
+    return Samples[Samples.Num() / 2];
+}
+
+static void RunBenchmarks(TArray<FTerrainCoreBenchmarkEntry>& OutEntries)
+{
+    int32 Resolution = 128;
+    int32 Passes = 9;
+    int32 Seed = 1234;
+    FString Filter;
+    FParse::Value(FCommandLine::Get(), TEXT("Resolution="), Resolution);
+    FParse::Value(FCommandLine::Get(), TEXT("Passes="), Passes);
+    FParse::Value(FCommandLine::Get(), TEXT("Seed="), Seed);
+    FParse::Value(FCommandLine::Get(), TEXT("Filter="), Filter);
+    Resolution = FMath::Max(Resolution, 2);
+    Passes = FMath::Max(Passes, 1);
+    
+    auto Run = [&OutEntries, Passes, &Filter](const TCHAR* Name, int32 CallsPerPass, TFunctionRef<void()> Setup, TFunctionRef<void()> Body)
+    {
+        if (!Filter.IsEmpty() && !FCString::Stristr(Name, *Filter))
+        {
+            return;
+        }
+        
+        FTerrainCoreBenchmarkEntry& Entry = OutEntries.AddDefaulted_GetRef();
+        Entry.Name = Name;
+        Entry.CallsPerPass = CallsPerPass;
+        Entry.MedianMs = MeasureMedianMs(Passes, Setup, Body);
+        
+        UE_LOG(LogTemp, Display, TEXT("%-36s %6d calls %10.3f ms/pass %10.3f us/call"),
+            Name, CallsPerPass, Entry.MedianMs, Entry.MedianMs * 1000.0 / FMath::Max(CallsPerPass, 1));
+    };
+    auto NoSetup = []() {};
+    
+    // Grille aux dimensions du terrain par défaut
+    FTerrainGridSettings Settings;
+    Settings.ResolutionX = Resolution;
+    Settings.ResolutionY = Resolution;
+    
+    FTerrainGrid Grid;
+    Grid.SetSettings(Settings);
+    
+    // Explosions scriptées, identiques d'une exécution à l'autre (zone carrée centrée sur l'impact, comme en jeu)
+    FRandomStream Stream(Seed);
+    TArray<FVector2D> CraterPositions;
+    TArray<FVector2D> CraterSizes;
+    for (int32 i = 0; i < 100; ++i)
+    {
+        const float Radius = Stream.FRandRange(40.0f, 150.0f);
+        CraterPositions.Add(FVector2D(Stream.FRandRange(0.0f, Settings.Width), Stream.FRandRange(0.0f, Settings.Height)) - FVector2D(Radius));
+        CraterSizes.Add(FVector2D(Radius * 2.0f));
+    }
+    
+    FIntPoint MinSection, MaxSection;
+    auto CarveAll = [&](FTerrainGrid& Target)
+    {
+        for (int32 i = 0; i < CraterPositions.Num(); ++i)
+        {
+            Target.CarveRect(CraterPositions[i], CraterSizes[i], nullptr, MinSection, MaxSection);
+        }
+    };
+    
+    Run(TEXT("Grid.CarveRect"), CraterPositions.Num(), [&]() { Grid.Reset(); }, [&]() { CarveAll(Grid); });
+    
+    FTerrainGrid Damaged;
+    Damaged.SetSettings(Settings);
+    CarveAll(Damaged);
+    const TBitArray<> DamagedMask = Damaged.GetCarvedMask();
+    
+    Run(TEXT("Grid.CarveMask"), 1, [&]() { Grid.Reset(); }, [&]()
+    {
+        Grid.CarveMask(DamagedMask, nullptr, MinSection, MaxSection);
+    });
+    
+    TArray<uint8> Runs;
+    Run(TEXT("Grid.EncodeCarvedRuns"), 10, NoSetup, [&]()
+    {
+        for (int32 i = 0; i < 10; ++i)
+        {
+            Damaged.EncodeCarvedRuns(Runs);
+        }
+    });
+    
+    Run(TEXT("Grid.DecodeCarvedRuns"), 10, NoSetup, [&]()
+    {
+        for (int32 i = 0; i < 10; ++i)
+        {
+            Grid.DecodeCarvedRuns(Runs);
+        }
+    });
+    
+    // Segments aléatoires autour du terrain endommagé
+    TArray<FVector> SegmentStarts;
+    TArray<FVector> SegmentEnds;
+    for (int32 i = 0; i < 1000; ++i)
+    {
+        SegmentStarts.Add(FVector(Stream.FRandRange(-200.0f, Settings.Width + 200.0f), Stream.FRandRange(0.0f, Settings.Depth), Settings.Height + 200.0f));
+        SegmentEnds.Add(FVector(Stream.FRandRange(-200.0f, Settings.Width + 200.0f), Stream.FRandRange(0.0f, Settings.Depth), -200.0f));
+    }
+    
+    FTerrainGridHit Hit;
+    Run(TEXT("Grid.Raycast"), SegmentStarts.Num(), NoSetup, [&]()
+    {
+        for (int32 i = 0; i < SegmentStarts.Num(); ++i)
+        {
+            Damaged.Raycast(SegmentStarts[i], SegmentEnds[i], Hit);
+        }
+    });
+    
+    Run(TEXT("Grid.GetSolidFraction"), SegmentStarts.Num(), NoSetup, [&]()
+    {
+        for (int32 i = 0; i < SegmentStarts.Num(); ++i)
+        {
+            Damaged.GetSolidFraction(SegmentStarts[i], SegmentEnds[i]);
+        }
+    });
+    
+    Run(TEXT("Grid.SweepSphere"), 100, NoSetup, [&]()
+    {
+        for (int32 i = 0; i < 100; ++i)
+        {
+            Damaged.SweepSphere(SegmentStarts[i], SegmentEnds[i], 30.0f, Hit);
+        }
+    });
+    
+    TArray<FIntPoint> StandableCells;
+    Run(TEXT("Grid.GetStandableSurfaceCells"), 1, [&]() { StandableCells.Reset(); }, [&]()
+    {
+        Damaged.GetStandableSurfaceCells(100.0f, StandableCells);
+    });
+    
+    // Meshes pleine résolution et adjacence
+    TArray<FVector> Vertices;
+    TArray<int32> Triangles;
+    Run(TEXT("GridMesher.BuildShell"), 1, NoSetup, [&]()
+    {
+        FTerrainGridMesher::BuildShell(Settings, Vertices, Triangles);
+    });
+    
+    // Données des mesures suivantes, même si celle-ci est écartée par -Filter
+    if (Vertices.Num() == 0)
+    {
+        FTerrainGridMesher::BuildShell(Settings, Vertices, Triangles);
+    }
+    
+    TArray<FVector> LayerVertices;
+    TArray<int32> LayerTriangles;
+    Run(TEXT("GridMesher.BuildInternalLayers"), 1, NoSetup, [&]()
+    {
+        FTerrainGridMesher::BuildInternalLayers(Settings, 3, 50.0f, LayerVertices, LayerTriangles);
+    });
+    
+    FTerrainMeshTopology Topology;
+    Run(TEXT("MeshTopology.Build"), 1, NoSetup, [&]()
+    {
+        Topology.Build(Triangles, Vertices.Num());
+    });
+    if (Topology.VertexCount == 0)
+    {
+        Topology.Build(Triangles, Vertices.Num());
+    }
+    
+    TArray<FVector> Normals;
+    Run(TEXT("MeshTopology.ComputeVertexNormals"), 1, NoSetup, [&]()
+    {
+        Topology.ComputeVertexNormals(Vertices, Normals, 0, Vertices.Num());
+    });
+    
+    TArray<int32> AliveTriangles;
+    Run(TEXT("MeshTopology.GatherAliveTriangles"), 1, NoSetup, [&]()
+    {
+        Topology.GatherAliveTriangles(AliveTriangles);
+    });
+    
+    // Chronologie des creusements : un point de contrôle toutes les 16 modifications
+    FTerrainEditTimeline Timeline;
+    Timeline.SetLimits(16, 64 * 1024 * 1024);
+    Grid.Reset();
+    Timeline.AddCheckpoint(0.0, Grid);
+    for (int32 i = 0; i < CraterPositions.Num(); ++i)
+    {
+        Grid.CarveRect(CraterPositions[i], CraterSizes[i], nullptr, MinSection, MaxSection);
+        Timeline.RecordEdit(i + 1.0, CraterPositions[i], CraterSizes[i], Grid);
+    }
+    
+    FTerrainGrid Reconstructed;
+    Run(TEXT("EditTimeline.ReconstructAt"), 100, NoSetup, [&]()
+    {
+        for (int32 i = 0; i < 100; ++i)
+        {
+            Timeline.ReconstructAt(i + 0.5, Reconstructed);
+        }
+    });
+    
+    // Volume voxel : 8 x 8 x 4 chunks de 16 échantillons, collines douces
+    FTerrainVoxelSettings VoxelSettings;
+    FTerrainVoxelVolume Volume;
+    Volume.Initialize(VoxelSettings);
+    const FIntVector SampleCount = VoxelSettings.GetSampleCount();
+    const float GroundHeight = SampleCount.Z * VoxelSettings.VoxelSize * 0.5f;
+    auto Hills = [GroundHeight](const FVector& Position) -> float
+    {
+        return GroundHeight + 200.0f * FMath::Sin((float)Position.X / 700.0f) * FMath::Cos((float)Position.Y / 900.0f) - (float)Position.Z;
+    };
+    
+    Run(TEXT("VoxelVolume.Fill"), 1, NoSetup, [&]()
+    {
+        Volume.Fill(Hills);
+    });
+    
+    if (Volume.GetAllocatedSize() == 0)
+    {
+        Volume.Fill(Hills);
+    }
+    
+    TArray<FVector> CraterCenters;
+    for (int32 i = 0; i < 20; ++i)
+    {
+        CraterCenters.Add(FVector(Stream.FRandRange(0.0f, SampleCount.X * VoxelSettings.VoxelSize),
+            Stream.FRandRange(0.0f, SampleCount.Y * VoxelSettings.VoxelSize), GroundHeight));
+    }
+    
+    TArray<FIntVector> TouchedChunks;
+    Run(TEXT("VoxelVolume.CarveSphere"), CraterCenters.Num(), [&]() { Volume.Fill(Hills); TouchedChunks.Reset(); }, [&]()
+    {
+        for (const FVector& Center : CraterCenters)
+        {
+            Volume.CarveSphere(Center, 150.0f, TouchedChunks);
+        }
+    });
+    
+    // Tous les chunks traversés par la surface, copiés à l'avance comme pour les threads de travail
+    TArray<FIntVector> SurfaceChunks;
+    TArray<TArray<int8>> PaddedChunks;
+    for (int32 z = 0; z < VoxelSettings.ChunkCount.Z; ++z)
+    {
+        for (int32 y = 0; y < VoxelSettings.ChunkCount.Y; ++y)
+        {
+            for (int32 x = 0; x < VoxelSettings.ChunkCount.X; ++x)
+            {
+                if (Volume.MayContainSurface(FIntVector(x, y, z)))
+                {
+                    SurfaceChunks.Add(FIntVector(x, y, z));
+                    Volume.CopyPaddedChunk(SurfaceChunks.Last(), PaddedChunks.AddDefaulted_GetRef());
+                }
+            }
+        }
+    }
+    
+    FTerrainVoxelChunkMesh ChunkMesh;
+    Run(TEXT("VoxelVolume.CopyPaddedChunk"), SurfaceChunks.Num(), NoSetup, [&]()
+    {
+        for (int32 i = 0; i < SurfaceChunks.Num(); ++i)
+        {
+            Volume.CopyPaddedChunk(SurfaceChunks[i], PaddedChunks[i]);
+        }
+    });
+    
+    Run(TEXT("VoxelMesher.BuildChunkMesh"), SurfaceChunks.Num(), NoSetup, [&]()
+    {
+        for (int32 i = 0; i < SurfaceChunks.Num(); ++i)
+        {
+            const FVector ChunkOrigin = FVector(SurfaceChunks[i] * VoxelSettings.ChunkSize) * VoxelSettings.VoxelSize;
+            FTerrainVoxelMesher::BuildChunkMesh(PaddedChunks[i], VoxelSettings.ChunkSize, ChunkOrigin, VoxelSettings.VoxelSize, ChunkMesh);
+        }
+    });
+}
+
+static bool WriteEntriesCsv(const FString& Path, const TArray<FTerrainCoreBenchmarkEntry>& Entries)
+{
+    TArray<FString> Lines;
+    Lines.Add(TEXT("Function,CallsPerPass,MedianMsPerPass,MicrosecondsPerCall"));
+    for (const FTerrainCoreBenchmarkEntry& Entry : Entries)
+    {
+        Lines.Add(FString::Printf(TEXT("%s,%d,%.4f,%.4f"), *Entry.Name, Entry.CallsPerPass, Entry.MedianMs,
+            Entry.MedianMs * 1000.0 / FMath::Max(Entry.CallsPerPass, 1)));
+    }
+    return FFileHelper::SaveStringArrayToFile(Lines, *Path);
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+    ON_SCOPE_EXIT
+    {
+        RequestEngineExit(TEXT("TerrainCoreBenchmark exiting"));
+        FEngineLoop::AppPreExit();
+        FModuleManager::Get().UnloadModulesAtShutdown();
+        FEngineLoop::AppExit();
+    };
+    
+    if (int32 Ret = GEngineLoop.PreInit(ArgC, ArgV))
+    {
+        return Ret;
+    }
+    
+    TArray<FTerrainCoreBenchmarkEntry> Entries;
+    RunBenchmarks(Entries);
+    
+    FString CsvPath;
+    if (FParse::Value(FCommandLine::Get(), TEXT("Csv="), CsvPath))
+    {
+        if (!WriteEntriesCsv(CsvPath, Entries))
+        {
+            UE_LOG(LogTemp, Error, TEXT("TerrainCoreBenchmark: could not write %s"), *CsvPath);
+            return 1;
+        }
+        UE_LOG(LogTemp, Display, TEXT("TerrainCoreBenchmark results written to %s"), *CsvPath);
+    }
+    
+    return Entries.Num() > 0 ? 0 : 1;
+}
@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+// Micro-benchmark en ligne de commande des fonctions de TerrainCore, sans moteur ni UObject
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class TerrainCoreBenchmarkTarget : TargetRules
+{
+	public TerrainCoreBenchmarkTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "TerrainCoreBenchmark";
+
+		// Core et TerrainCore seulement : quelques secondes de compilation et de lancement
+		bBuildDeveloperTools = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bCompileICU = false;
+		bIsBuildingConsoleApplication = true;
+	}
+}
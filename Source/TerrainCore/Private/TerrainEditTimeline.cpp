@@ -0,0 +1,133 @@
+#include "TerrainEditTimeline.h"
+#include "Algo/BinarySearch.h"
+
+void FTerrainEditTimeline::SetLimits(int32 InCheckpointInterval, int64 InMaxBytes)
+{
+    CheckpointInterval = FMath::Max(InCheckpointInterval, 1);
+    MaxBytes = FMath::Max<int64>(InMaxBytes, 0);
+    EnforceBudget();
+}
+
+void FTerrainEditTimeline::Reset()
+{
+    Edits.Reset();
+    Checkpoints.Reset();
+}
+
+void FTerrainEditTimeline::AddCheckpoint(double Time, const FTerrainGrid& Grid)
+{
+    if (Checkpoints.Num() > 0 && Grid.GetSettings() != Settings)
+    {
+        Reset();
+    }
+    Settings = Grid.GetSettings();
+    
+    // Un point de contrôle au même endroit que le dernier le remplace
+    if (Checkpoints.Num() > 0 && Checkpoints.Last().EditIndex == Edits.Num())
+    {
+        Checkpoints.RemoveAt(Checkpoints.Num() - 1);
+    }
+    
+    FCheckpoint& Checkpoint = Checkpoints.AddDefaulted_GetRef();
+    Checkpoint.Time = Time;
+    Checkpoint.EditIndex = Edits.Num();
+    Grid.EncodeCarvedRuns(Checkpoint.Runs);
+    
+    EnforceBudget();
+}
+
+void FTerrainEditTimeline::RecordEdit(double Time, const FVector2D& Position, const FVector2D& Size, const FTerrainGrid& GridAfter)
+{
+    // Sans point de départ, les creusements ne pourraient pas être rejoués
+    if (Checkpoints.Num() == 0 || GridAfter.GetSettings() != Settings)
+    {
+        return;
+    }
+    
+    FEdit& Edit = Edits.AddDefaulted_GetRef();
+    Edit.Time = Time;
+    Edit.Position = Position;
+    Edit.Size = Size;
+    
+    if (Edits.Num() - Checkpoints.Last().EditIndex >= CheckpointInterval)
+    {
+        AddCheckpoint(Time, GridAfter);
+    }
+}
+
+double FTerrainEditTimeline::GetStartTime() const
+{
+    return Checkpoints.Num() > 0 ? Checkpoints[0].Time : 0.0;
+}
+
+bool FTerrainEditTimeline::ReconstructAt(double Time, FTerrainGrid& OutGrid) const
+{
+    if (Checkpoints.Num() == 0 || Time < Checkpoints[0].Time)
+    {
+        return false;
+    }
+    
+    // Nombre de creusements enregistrés jusqu'à Time (les instants sont croissants)
+    const int32 EditCount = Algo::UpperBoundBy(Edits, Time, [](const FEdit& Edit) { return Edit.Time; });
+    return ReconstructEditCount(EditCount, OutGrid);
+}
+
+bool FTerrainEditTimeline::ReconstructBeforeLastEdits(int32 Count, FTerrainGrid& OutGrid) const
+{
+    return ReconstructEditCount(Edits.Num() - FMath::Max(Count, 0), OutGrid);
+}
+
+bool FTerrainEditTimeline::ReconstructEditCount(int32 EditCount, FTerrainGrid& OutGrid) const
+{
+    if (Checkpoints.Num() == 0 || EditCount < Checkpoints[0].EditIndex || EditCount > Edits.Num())
+    {
+        return false;
+    }
+    
+    // Dernier point de contrôle avant l'état voulu, puis au plus CheckpointInterval creusements
+    int32 CheckpointIndex = Checkpoints.Num() - 1;
+    while (Checkpoints[CheckpointIndex].EditIndex > EditCount)
+    {
+        --CheckpointIndex;
+    }
+    const FCheckpoint& Checkpoint = Checkpoints[CheckpointIndex];
+    
+    OutGrid.SetSettings(Settings);
+    if (!OutGrid.DecodeCarvedRuns(Checkpoint.Runs))
+    {
+        return false;
+    }
+    
+    FIntPoint MinSection, MaxSection;
+    for (int32 i = Checkpoint.EditIndex; i < EditCount; ++i)
+    {
+        OutGrid.CarveRect(Edits[i].Position, Edits[i].Size, nullptr, MinSection, MaxSection);
+    }
+    return true;
+}
+
+SIZE_T FTerrainEditTimeline::GetAllocatedSize() const
+{
+    SIZE_T Size = Edits.GetAllocatedSize() + Checkpoints.GetAllocatedSize();
+    for (const FCheckpoint& Checkpoint : Checkpoints)
+    {
+        Size += Checkpoint.Runs.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void FTerrainEditTimeline::EnforceBudget()
+{
+    // Oublier le plus ancien segment (point de contrôle et creusements jusqu'au suivant) ; le dernier est gardé
+    while (Checkpoints.Num() > 1 && (int64)GetAllocatedSize() > MaxBytes)
+    {
+        const int32 DroppedEdits = Checkpoints[1].EditIndex;
+        Checkpoints.RemoveAt(0);
+        Edits.RemoveAt(0, DroppedEdits);
+        
+        for (FCheckpoint& Checkpoint : Checkpoints)
+        {
+            Checkpoint.EditIndex -= DroppedEdits;
+        }
+    }
+}
@@ -0,0 +1,610 @@
+#include "TerrainGrid.h"
+
+void FTerrainGrid::SetSettings(const FTerrainGridSettings& InSettings)
+{
+    const bool bResolutionChanged = InSettings.ResolutionX != Settings.ResolutionX || InSettings.ResolutionY != Settings.ResolutionY;
+    
+    Settings = InSettings;
+    Settings.ResolutionX = FMath::Max(Settings.ResolutionX, 2);
+    Settings.ResolutionY = FMath::Max(Settings.ResolutionY, 2);
+    
+    if (bResolutionChanged || Carved.Num() != Settings.ResolutionX * Settings.ResolutionY)
+    {
+        Reset();
+    }
+}
+
+void FTerrainGrid::Reset()
+{
+    Carved.Init(false, Settings.ResolutionX * Settings.ResolutionY);
+}
+
+FVector2D FTerrainGrid::GetStep() const
+{
+    return FVector2D(
+        Settings.Width / FMath::Max(Settings.ResolutionX - 1, 1),
+        Settings.Height / FMath::Max(Settings.ResolutionY - 1, 1));
+}
+
+bool FTerrainGrid::IsVertexCarved(int32 X, int32 Y) const
+{
+    int32 Index = Y * Settings.ResolutionX + X;
+    return Carved.IsValidIndex(Index) && Carved[Index];
+}
+
+bool FTerrainGrid::IsCellSolid(int32 X, int32 Y) const
+{
+    if (X < 0 || Y < 0 || X >= GetCellCountX() || Y >= GetCellCountY())
+    {
+        return false;
+    }
+    
+    // Une cellule est pleine tant qu'aucun de ses quatre coins n'a été détruit
+    return !IsVertexCarved(X, Y) && !IsVertexCarved(X + 1, Y) &&
+           !IsVertexCarved(X, Y + 1) && !IsVertexCarved(X + 1, Y + 1);
+}
+
+bool FTerrainGrid::CarveRect(const FVector2D& Position, const FVector2D& Size, TArray<int32>* OutNewlyCarved,
+    FIntPoint& OutMinSection, FIntPoint& OutMaxSection)
+{
+    FVector2D Step = GetStep();
+    
+    // Ne parcourir que les vertices de la grille couverts par le rectangle
+    int32 MinX = FMath::Max(0, FMath::FloorToInt(Position.X / Step.X));
+    int32 MinY = FMath::Max(0, FMath::FloorToInt(Position.Y / Step.Y));
+    int32 MaxX = FMath::Min(Settings.ResolutionX - 1, FMath::CeilToInt((Position.X + Size.X) / Step.X));
+    int32 MaxY = FMath::Min(Settings.ResolutionY - 1, FMath::CeilToInt((Position.Y + Size.Y) / Step.Y));
+    
+    if (MinX > MaxX || MinY > MaxY)
+    {
+        return false;
+    }
+    
+    for (int32 y = MinY; y <= MaxY; ++y)
+    {
+        for (int32 x = MinX; x <= MaxX; ++x)
+        {
+            const float VertexX = x * Step.X;
+            const float VertexZ = y * Step.Y;
+            const bool bInside = VertexX >= Position.X && VertexX <= Position.X + Size.X &&
+                                 VertexZ >= Position.Y && VertexZ <= Position.Y + Size.Y;
+            
+            int32 GridIndex = y * Settings.ResolutionX + x;
+            if (bInside && !Carved[GridIndex])
+            {
+                Carved[GridIndex] = true;
+                
+                if (OutNewlyCarved)
+                {
+                    OutNewlyCarved->Add(GridIndex);
+                }
+            }
+        }
+    }
+    
+    // Un vertex détruit invalide les cellules qui l'entourent, y compris celles des sections voisines
+    OutMinSection = GetSectionForCell(FMath::Max(MinX - 1, 0), FMath::Max(MinY - 1, 0));
+    OutMaxSection = GetSectionForCell(MaxX, MaxY);
+    return true;
+}
+
+bool FTerrainGrid::CarveMask(const TBitArray<>& Mask, TArray<int32>* OutNewlyCarved, FIntPoint& OutMinSection, FIntPoint& OutMaxSection)
+{
+    if (Mask.Num() != Carved.Num())
+    {
+        return false;
+    }
+    
+    FIntPoint MinVertex(MAX_int32, MAX_int32);
+    FIntPoint MaxVertex(INDEX_NONE, INDEX_NONE);
+    
+    for (TConstSetBitIterator<> It(Mask); It; ++It)
+    {
+        const int32 GridIndex = It.GetIndex();
+        if (Carved[GridIndex])
+        {
+            continue;
+        }
+        
+        Carved[GridIndex] = true;
+        if (OutNewlyCarved)
+        {
+            OutNewlyCarved->Add(GridIndex);
+        }
+        
+        const int32 X = GridIndex % Settings.ResolutionX;
+        const int32 Y = GridIndex / Settings.ResolutionX;
+        MinVertex = FIntPoint(FMath::Min(MinVertex.X, X), FMath::Min(MinVertex.Y, Y));
+        MaxVertex = FIntPoint(FMath::Max(MaxVertex.X, X), FMath::Max(MaxVertex.Y, Y));
+    }
+    
+    if (MaxVertex.X == INDEX_NONE)
+    {
+        return false;
+    }
+    
+    // Même couverture des sections voisines que CarveRect()
+    OutMinSection = GetSectionForCell(FMath::Max(MinVertex.X - 1, 0), FMath::Max(MinVertex.Y - 1, 0));
+    OutMaxSection = GetSectionForCell(MaxVertex.X, MaxVertex.Y);
+    return true;
+}
+
+static void WriteRunLength(TArray<uint8>& OutRuns, uint32 Length)
+{
+    // Varint : 7 bits par octet, bit de poids fort = suite
+    while (Length >= 0x80)
+    {
+        OutRuns.Add((uint8)(Length | 0x80));
+        Length >>= 7;
+    }
+    OutRuns.Add((uint8)Length);
+}
+
+void FTerrainGrid::EncodeCarvedRuns(TArray<uint8>& OutRuns) const
+{
+    OutRuns.Reset();
+    
+    bool bRunValue = false;
+    uint32 RunLength = 0;
+    for (TConstBitIterator<> It(Carved); It; ++It)
+    {
+        if ((bool)It.GetValue() != bRunValue)
+        {
+            WriteRunLength(OutRuns, RunLength);
+            bRunValue = !bRunValue;
+            RunLength = 0;
+        }
+        RunLength++;
+    }
+    WriteRunLength(OutRuns, RunLength);
+}
+
+bool FTerrainGrid::DecodeCarvedRuns(const TArray<uint8>& Runs)
+{
+    const int32 NumBits = Settings.ResolutionX * Settings.ResolutionY;
+    TBitArray<> Decoded;
+    Decoded.Reserve(NumBits);
+    
+    bool bRunValue = false;
+    int32 Offset = 0;
+    while (Offset < Runs.Num())
+    {
+        uint32 Length = 0;
+        int32 Shift = 0;
+        uint8 Byte = 0;
+        do
+        {
+            if (Offset >= Runs.Num() || Shift > 28)
+            {
+                return false;
+            }
+            Byte = Runs[Offset++];
+            Length |= (uint32)(Byte & 0x7F) << Shift;
+            Shift += 7;
+        }
+        while (Byte & 0x80);
+        
+        if (Length > (uint32)(NumBits - Decoded.Num()))
+        {
+            return false;
+        }
+        Decoded.Add(bRunValue, Length);
+        bRunValue = !bRunValue;
+    }
+    
+    if (Decoded.Num() != NumBits)
+    {
+        return false;
+    }
+    
+    Carved = MoveTemp(Decoded);
+    return true;
+}
+
+FIntPoint FTerrainGrid::GetSectionForCell(int32 X, int32 Y) const
+{
+    if (!Settings.bUseSections)
+    {
+        return FIntPoint(0, 0);
+    }
+    
+    // Une cellule appartient à la section qui contient son coin minimum
+    FVector2D Step = GetStep();
+    FIntPoint SectionCount = GetSectionCount();
+    return FIntPoint(
+        FMath::Clamp(FMath::FloorToInt(X * Step.X / Settings.SectionSizeX), 0, SectionCount.X - 1),
+        FMath::Clamp(FMath::FloorToInt(Y * Step.Y / Settings.SectionSizeY), 0, SectionCount.Y - 1));
+}
+
+FIntPoint FTerrainGrid::GetSectionCount() const
+{
+    if (!Settings.bUseSections)
+    {
+        return FIntPoint(1, 1);
+    }
+    
+    return FIntPoint(
+        FMath::Max(1, FMath::CeilToInt(Settings.Width / Settings.SectionSizeX)),
+        FMath::Max(1, FMath::CeilToInt(Settings.Height / Settings.SectionSizeY)));
+}
+
+void FTerrainGrid::GetSectionCellRange(const FIntPoint& SectionCoord, FIntPoint& OutMin, FIntPoint& OutMax) const
+{
+    int32 CellsX = GetCellCountX();
+    int32 CellsY = GetCellCountY();
+    
+    if (!Settings.bUseSections)
+    {
+        OutMin = FIntPoint(0, 0);
+        OutMax = FIntPoint(CellsX, CellsY);
+        return;
+    }
+    
+    // Inverse de GetSectionForCell() : les cellules dont le coin minimum est dans la section
+    FVector2D Step = GetStep();
+    float SectionStartX = SectionCoord.X * Settings.SectionSizeX;
+    float SectionStartY = SectionCoord.Y * Settings.SectionSizeY;
+    float SectionEndX = FMath::Min(SectionStartX + Settings.SectionSizeX, Settings.Width);
+    float SectionEndY = FMath::Min(SectionStartY + Settings.SectionSizeY, Settings.Height);
+    
+    OutMin.X = FMath::Clamp(FMath::CeilToInt(SectionStartX / Step.X), 0, CellsX);
+    OutMin.Y = FMath::Clamp(FMath::CeilToInt(SectionStartY / Step.Y), 0, CellsY);
+    OutMax.X = FMath::Clamp(FMath::CeilToInt(SectionEndX / Step.X), 0, CellsX);
+    OutMax.Y = FMath::Clamp(FMath::CeilToInt(SectionEndY / Step.Y), 0, CellsY);
+    
+    // La dernière section récupère toujours les cellules restantes
+    FIntPoint SectionCount = GetSectionCount();
+    if (SectionCoord.X == SectionCount.X - 1)
+    {
+        OutMax.X = CellsX;
+    }
+    if (SectionCoord.Y == SectionCount.Y - 1)
+    {
+        OutMax.Y = CellsY;
+    }
+}
+
+FBox FTerrainGrid::GetCellBox(int32 X, int32 Y) const
+{
+    FVector2D Step = GetStep();
+    return FBox(
+        FVector(X * Step.X, 0.0f, Y * Step.Y),
+        FVector((X + 1) * Step.X, Settings.Depth, (Y + 1) * Step.Y));
+}
+
+bool FTerrainGrid::IsPointInside(const FVector& LocalPoint) const
+{
+    if (LocalPoint.Y < 0.0f || LocalPoint.Y > Settings.Depth)
+    {
+        return false;
+    }
+    
+    FVector2D Step = GetStep();
+    return IsCellSolid(FMath::FloorToInt(LocalPoint.X / Step.X), FMath::FloorToInt(LocalPoint.Z / Step.Y));
+}
+
+// Découpage d'un segment par une boîte (slabs) : plage [TEnter, TExit] utile et axe de la face d'entrée
+static bool ClipSegmentToBox(const FVector& Start, const FVector& Delta, const FVector& BoxMin, const FVector& BoxMax,
+    float& TEnter, float& TExit, int32& EnterAxis)
+{
+    TEnter = 0.0f;
+    TExit = 1.0f;
+    EnterAxis = INDEX_NONE;
+    
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        if (FMath::IsNearlyZero(Delta[Axis]))
+        {
+            if (Start[Axis] < BoxMin[Axis] || Start[Axis] > BoxMax[Axis])
+            {
+                return false;
+            }
+            continue;
+        }
+        
+        float T0 = (BoxMin[Axis] - Start[Axis]) / Delta[Axis];
+        float T1 = (BoxMax[Axis] - Start[Axis]) / Delta[Axis];
+        if (T0 > T1)
+        {
+            Swap(T0, T1);
+        }
+        if (T0 > TEnter)
+        {
+            TEnter = T0;
+            EnterAxis = Axis;
+        }
+        TExit = FMath::Min(TExit, T1);
+        
+        if (TEnter > TExit)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FTerrainGrid::Raycast(const FVector& LocalStart, const FVector& LocalEnd, FTerrainGridHit& OutHit) const
+{
+    const FVector Delta = LocalEnd - LocalStart;
+    
+    // Découpage du segment par la boîte englobante du terrain pour trouver la plage utile
+    float TEnter, TExit;
+    int32 EnterAxis;
+    if (!ClipSegmentToBox(LocalStart, Delta, FVector::ZeroVector, FVector(Settings.Width, Settings.Depth, Settings.Height),
+        TEnter, TExit, EnterAxis))
+    {
+        return false;
+    }
+    
+    // DDA dans le plan X/Z : la profondeur Y n'intervient que dans le découpage ci-dessus
+    const FVector2D Step = GetStep();
+    const FVector EnterPoint = LocalStart + Delta * TEnter;
+    const int32 CellsX = GetCellCountX();
+    const int32 CellsY = GetCellCountY();
+    
+    int32 X = FMath::Clamp(FMath::FloorToInt(EnterPoint.X / Step.X), 0, CellsX - 1);
+    int32 Y = FMath::Clamp(FMath::FloorToInt(EnterPoint.Z / Step.Y), 0, CellsY - 1);
+    
+    const int32 StepX = Delta.X > 0.0f ? 1 : -1;
+    const int32 StepY = Delta.Z > 0.0f ? 1 : -1;
+    
+    // Paramètre t auquel le segment franchit la prochaine frontière de cellule, et incrément par cellule
+    const float InvDX = FMath::IsNearlyZero(Delta.X) ? BIG_NUMBER : 1.0f / Delta.X;
+    const float InvDZ = FMath::IsNearlyZero(Delta.Z) ? BIG_NUMBER : 1.0f / Delta.Z;
+    float TMaxX = FMath::IsNearlyZero(Delta.X) ? BIG_NUMBER : ((X + (StepX > 0 ? 1 : 0)) * Step.X - LocalStart.X) * InvDX;
+    float TMaxY = FMath::IsNearlyZero(Delta.Z) ? BIG_NUMBER : ((Y + (StepY > 0 ? 1 : 0)) * Step.Y - LocalStart.Z) * InvDZ;
+    const float TDeltaX = FMath::Abs(Step.X * InvDX);
+    const float TDeltaY = FMath::Abs(Step.Y * InvDZ);
+    
+    float TCell = TEnter;
+    FVector LocalNormal = FVector::ZeroVector;
+    if (EnterAxis != INDEX_NONE)
+    {
+        LocalNormal[EnterAxis] = Delta[EnterAxis] > 0.0f ? -1.0f : 1.0f;
+    }
+    
+    while (TCell <= TExit)
+    {
+        if (IsCellSolid(X, Y))
+        {
+            OutHit.Time = TCell;
+            OutHit.Cell = FIntPoint(X, Y);
+            OutHit.Location = LocalStart + Delta * TCell;
+            OutHit.Normal = LocalNormal.IsZero() ? -Delta.GetSafeNormal() : LocalNormal;
+            return true;
+        }
+        
+        // Passer à la cellule voisine par la frontière la plus proche
+        if (TMaxX < TMaxY)
+        {
+            TCell = TMaxX;
+            TMaxX += TDeltaX;
+            X += StepX;
+            LocalNormal = FVector(-StepX, 0.0f, 0.0f);
+        }
+        else
+        {
+            TCell = TMaxY;
+            TMaxY += TDeltaY;
+            Y += StepY;
+            LocalNormal = FVector(0.0f, 0.0f, -StepY);
+        }
+        
+        if (X < 0 || Y < 0 || X >= CellsX || Y >= CellsY)
+        {
+            break;
+        }
+    }
+    
+    return false;
+}
+
+float FTerrainGrid::GetSolidFraction(const FVector& LocalStart, const FVector& LocalEnd, float MinTime) const
+{
+    const FVector Delta = LocalEnd - LocalStart;
+    
+    float TEnter, TExit;
+    int32 EnterAxis;
+    if (!ClipSegmentToBox(LocalStart, Delta, FVector::ZeroVector, FVector(Settings.Width, Settings.Depth, Settings.Height),
+        TEnter, TExit, EnterAxis))
+    {
+        return 0.0f;
+    }
+    TEnter = FMath::Max(TEnter, MinTime);
+    if (TEnter >= TExit)
+    {
+        return 0.0f;
+    }
+    
+    // Même parcours DDA que Raycast(), en cumulant la part du segment passée dans des cellules pleines
+    const FVector2D Step = GetStep();
+    const FVector EnterPoint = LocalStart + Delta * TEnter;
+    const int32 CellsX = GetCellCountX();
+    const int32 CellsY = GetCellCountY();
+    
+    int32 X = FMath::Clamp(FMath::FloorToInt(EnterPoint.X / Step.X), 0, CellsX - 1);
+    int32 Y = FMath::Clamp(FMath::FloorToInt(EnterPoint.Z / Step.Y), 0, CellsY - 1);
+    
+    const int32 StepX = Delta.X > 0.0f ? 1 : -1;
+    const int32 StepY = Delta.Z > 0.0f ? 1 : -1;
+    
+    const float InvDX = FMath::IsNearlyZero(Delta.X) ? BIG_NUMBER : 1.0f / Delta.X;
+    const float InvDZ = FMath::IsNearlyZero(Delta.Z) ? BIG_NUMBER : 1.0f / Delta.Z;
+    float TMaxX = FMath::IsNearlyZero(Delta.X) ? BIG_NUMBER : ((X + (StepX > 0 ? 1 : 0)) * Step.X - LocalStart.X) * InvDX;
+    float TMaxY = FMath::IsNearlyZero(Delta.Z) ? BIG_NUMBER : ((Y + (StepY > 0 ? 1 : 0)) * Step.Y - LocalStart.Z) * InvDZ;
+    const float TDeltaX = FMath::Abs(Step.X * InvDX);
+    const float TDeltaY = FMath::Abs(Step.Y * InvDZ);
+    
+    float SolidTime = 0.0f;
+    float TCell = TEnter;
+    while (TCell < TExit)
+    {
+        const float TNext = FMath::Min3(TMaxX, TMaxY, TExit);
+        if (IsCellSolid(X, Y))
+        {
+            SolidTime += TNext - TCell;
+        }
+        
+        if (TMaxX < TMaxY)
+        {
+            TMaxX += TDeltaX;
+            X += StepX;
+        }
+        else
+        {
+            TMaxY += TDeltaY;
+            Y += StepY;
+        }
+        TCell = TNext;
+        
+        if (X < 0 || Y < 0 || X >= CellsX || Y >= CellsY)
+        {
+            break;
+        }
+    }
+    
+    return SolidTime;
+}
+
+bool FTerrainGrid::OverlapSphere(const FVector& Center, float Radius, FVector* OutClosestPoint, FIntPoint* OutCell) const
+{
+    if (Center.Y < -Radius || Center.Y > Settings.Depth + Radius)
+    {
+        return false;
+    }
+    
+    const FVector2D Step = GetStep();
+    const int32 MinX = FMath::Max(0, FMath::FloorToInt((Center.X - Radius) / Step.X));
+    const int32 MinY = FMath::Max(0, FMath::FloorToInt((Center.Z - Radius) / Step.Y));
+    const int32 MaxX = FMath::Min(GetCellCountX() - 1, FMath::FloorToInt((Center.X + Radius) / Step.X));
+    const int32 MaxY = FMath::Min(GetCellCountY() - 1, FMath::FloorToInt((Center.Z + Radius) / Step.Y));
+    
+    // Cellule pleine la plus proche du centre parmi celles que la sphère peut toucher
+    float BestDistanceSquared = FMath::Square(Radius);
+    bool bFound = false;
+    
+    for (int32 y = MinY; y <= MaxY; ++y)
+    {
+        for (int32 x = MinX; x <= MaxX; ++x)
+        {
+            if (!IsCellSolid(x, y))
+            {
+                continue;
+            }
+            
+            FVector Closest = GetCellBox(x, y).GetClosestPointTo(Center);
+            float DistanceSquared = FVector::DistSquared(Closest, Center);
+            if (DistanceSquared <= BestDistanceSquared)
+            {
+                BestDistanceSquared = DistanceSquared;
+                bFound = true;
+                
+                if (OutClosestPoint)
+                {
+                    *OutClosestPoint = Closest;
+                }
+                if (OutCell)
+                {
+                    *OutCell = FIntPoint(x, y);
+                }
+            }
+        }
+    }
+    
+    return bFound;
+}
+
+bool FTerrainGrid::SweepSphere(const FVector& LocalStart, const FVector& LocalEnd, float Radius, FTerrainGridHit& OutHit) const
+{
+    if (Radius <= 0.0f)
+    {
+        return Raycast(LocalStart, LocalEnd, OutHit);
+    }
+    
+    const FVector Delta = LocalEnd - LocalStart;
+    
+    // Rejet rapide : le segment gonflé du rayon ne touche pas le terrain
+    FBox SweepBounds(LocalStart.ComponentMin(LocalEnd) - FVector(Radius), LocalStart.ComponentMax(LocalEnd) + FVector(Radius));
+    if (!SweepBounds.Intersect(FBox(FVector::ZeroVector, FVector(Settings.Width, Settings.Depth, Settings.Height))))
+    {
+        return false;
+    }
+    
+    // Pas d'échantillonnage inférieur au rayon : la sphère ne peut pas traverser une cellule entre deux tests
+    const float Length = Delta.Size();
+    const int32 NumSteps = FMath::Max(1, FMath::CeilToInt(Length / (Radius * 0.5f)));
+    
+    float PreviousT = 0.0f;
+    for (int32 i = 0; i <= NumSteps; ++i)
+    {
+        const float T = static_cast<float>(i) / NumSteps;
+        if (!OverlapSphere(LocalStart + Delta * T, Radius))
+        {
+            PreviousT = T;
+            continue;
+        }
+        
+        // Affiner l'instant du contact par dichotomie entre le dernier échantillon libre et celui-ci
+        float Low = (i == 0) ? 0.0f : PreviousT;
+        float High = T;
+        for (int32 Iteration = 0; Iteration < 8 && i > 0; ++Iteration)
+        {
+            const float Mid = 0.5f * (Low + High);
+            if (OverlapSphere(LocalStart + Delta * Mid, Radius))
+            {
+                High = Mid;
+            }
+            else
+            {
+                Low = Mid;
+            }
+        }
+        
+        const FVector Center = LocalStart + Delta * High;
+        FVector Closest = Center;
+        FIntPoint Cell(INDEX_NONE, INDEX_NONE);
+        OverlapSphere(Center, Radius, &Closest, &Cell);
+        
+        OutHit.Time = High;
+        OutHit.Cell = Cell;
+        OutHit.Location = Closest;
+        OutHit.Normal = (Center - Closest).GetSafeNormal();
+        if (OutHit.Normal.IsNearlyZero())
+        {
+            OutHit.Normal = -Delta.GetSafeNormal();
+        }
+        return true;
+    }
+    
+    return false;
+}
+
+void FTerrainGrid::GetStandableSurfaceCells(float Clearance, TArray<FIntPoint>& OutCells) const
+{
+    const FVector2D Step = GetStep();
+    const int32 CellsX = GetCellCountX();
+    const int32 CellsY = GetCellCountY();
+    const int32 ClearCells = FMath::Max(1, FMath::CeilToInt(Clearance / Step.Y));
+    
+    for (int32 x = 0; x < CellsX; ++x)
+    {
+        // Parcours de la colonne de haut en bas : compter les cellules libres au-dessus de chaque cellule pleine
+        // (le dessus du terrain est toujours dégagé)
+        int32 FreeAbove = ClearCells;
+        for (int32 y = CellsY - 1; y >= 0; --y)
+        {
+            if (IsCellSolid(x, y))
+            {
+                if (FreeAbove >= ClearCells)
+                {
+                    OutCells.Add(FIntPoint(x, y));
+                }
+                FreeAbove = 0;
+            }
+            else
+            {
+                FreeAbove++;
+            }
+        }
+    }
+}
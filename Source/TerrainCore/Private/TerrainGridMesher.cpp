@@ -0,0 +1,217 @@
+#include "TerrainGridMesher.h"
+#include "Async/ParallelFor.h"
+
+void FTerrainGridMesher::BuildShell(const FTerrainGridSettings& Settings, TArray<FVector>& OutVertices,
+    TArray<int32>& OutTriangles)
+{
+    const int32 ResX = FMath::Max(Settings.ResolutionX, 2);
+    const int32 ResY = FMath::Max(Settings.ResolutionY, 2);
+    
+    // Calculer le pas entre chaque point
+    const float HStep = Settings.Width / (ResX - 1);
+    const float VStep = Settings.Height / (ResY - 1);
+    
+    // Toutes les tailles sont connues à l'avance : chaque élément est écrit à un index calculé
+    const int32 VerticesPerFace = ResX * ResY;
+    const int32 IndicesPerRow = (ResX - 1) * 6;
+    const int32 IndicesPerFace = (ResY - 1) * IndicesPerRow;
+    const int32 SideIndicesX = (ResX - 1) * 6;
+    const int32 SideIndicesY = (ResY - 1) * 6;
+    
+    OutVertices.SetNumUninitialized(2 * VerticesPerFace);
+    OutTriangles.SetNumUninitialized(2 * IndicesPerFace + 2 * SideIndicesX + 2 * SideIndicesY);
+    
+    // 1-4. Faces avant et arrière : une ligne de la grille par tâche
+    ParallelFor(ResY, [&](int32 y)
+    {
+        for (int32 x = 0; x < ResX; ++x)
+        {
+            const int32 FrontIndex = y * ResX + x;
+            const int32 BackIndex = VerticesPerFace + FrontIndex;
+            
+            // Calculer la position de ce vertex
+            const float PosX = x * HStep;
+            const float PosZ = y * VStep;
+            
+            // Face avant (vue principale du terrain) et face arrière (derrière le terrain)
+            OutVertices[FrontIndex] = FVector(PosX, 0.0f, PosZ);
+            OutVertices[BackIndex] = FVector(PosX, Settings.Depth, PosZ);
+        }
+        
+        if (y == ResY - 1)
+        {
+            return;
+        }
+        
+        int32 FrontWrite = y * IndicesPerRow;
+        int32 BackWrite = IndicesPerFace + y * IndicesPerRow;
+        for (int32 x = 0; x < ResX - 1; ++x)
+        {
+            const int32 Current = y * ResX + x;
+            const int32 Next = Current + 1;
+            const int32 Bottom = Current + ResX;
+            const int32 BottomNext = Bottom + 1;
+            
+            // Face avant : premier triangle
+            OutTriangles[FrontWrite++] = Current;
+            OutTriangles[FrontWrite++] = Bottom;
+            OutTriangles[FrontWrite++] = Next;
+            
+            // Face avant : second triangle
+            OutTriangles[FrontWrite++] = Next;
+            OutTriangles[FrontWrite++] = Bottom;
+            OutTriangles[FrontWrite++] = BottomNext;
+            
+            // Face arrière : premier triangle (inversé)
+            OutTriangles[BackWrite++] = VerticesPerFace + Next;
+            OutTriangles[BackWrite++] = VerticesPerFace + Bottom;
+            OutTriangles[BackWrite++] = VerticesPerFace + Current;
+            
+            // Face arrière : second triangle (inversé)
+            OutTriangles[BackWrite++] = VerticesPerFace + BottomNext;
+            OutTriangles[BackWrite++] = VerticesPerFace + Bottom;
+            OutTriangles[BackWrite++] = VerticesPerFace + Next;
+        }
+    });
+    
+    // 5. Faces latérales (O(largeur + hauteur), laissées en série)
+    int32 Write = 2 * IndicesPerFace;
+    
+    // Face inférieure (bas)
+    for (int32 x = 0; x < ResX - 1; ++x)
+    {
+        int32 FrontLeft = x;
+        int32 FrontRight = x + 1;
+        int32 BackLeft = VerticesPerFace + x;
+        int32 BackRight = VerticesPerFace + x + 1;
+        
+        OutTriangles[Write++] = FrontLeft;
+        OutTriangles[Write++] = FrontRight;
+        OutTriangles[Write++] = BackLeft;
+        
+        OutTriangles[Write++] = BackLeft;
+        OutTriangles[Write++] = FrontRight;
+        OutTriangles[Write++] = BackRight;
+    }
+    
+    // Face supérieure (haut)
+    for (int32 x = 0; x < ResX - 1; ++x)
+    {
+        int32 FrontLeft = (ResY - 1) * ResX + x;
+        int32 FrontRight = FrontLeft + 1;
+        int32 BackLeft = VerticesPerFace + (ResY - 1) * ResX + x;
+        int32 BackRight = BackLeft + 1;
+        
+        OutTriangles[Write++] = FrontRight;
+        OutTriangles[Write++] = FrontLeft;
+        OutTriangles[Write++] = BackLeft;
+        
+        OutTriangles[Write++] = BackRight;
+        OutTriangles[Write++] = FrontRight;
+        OutTriangles[Write++] = BackLeft;
+    }
+    
+    // Face gauche
+    for (int32 y = 0; y < ResY - 1; ++y)
+    {
+        int32 FrontBottom = y * ResX;
+        int32 FrontTop = FrontBottom + ResX;
+        int32 BackBottom = VerticesPerFace + y * ResX;
+        int32 BackTop = BackBottom + ResX;
+        
+        OutTriangles[Write++] = FrontBottom;
+        OutTriangles[Write++] = BackBottom;
+        OutTriangles[Write++] = FrontTop;
+        
+        OutTriangles[Write++] = FrontTop;
+        OutTriangles[Write++] = BackBottom;
+        OutTriangles[Write++] = BackTop;
+    }
+    
+    // Face droite
+    for (int32 y = 0; y < ResY - 1; ++y)
+    {
+        int32 FrontBottom = y * ResX + (ResX - 1);
+        int32 FrontTop = FrontBottom + ResX;
+        int32 BackBottom = VerticesPerFace + y * ResX + (ResX - 1);
+        int32 BackTop = BackBottom + ResX;
+        
+        OutTriangles[Write++] = BackBottom;
+        OutTriangles[Write++] = FrontBottom;
+        OutTriangles[Write++] = FrontTop;
+        
+        OutTriangles[Write++] = BackTop;
+        OutTriangles[Write++] = BackBottom;
+        OutTriangles[Write++] = FrontTop;
+    }
+}
+
+void FTerrainGridMesher::BuildInternalLayers(const FTerrainGridSettings& Settings, int32 LayerCount, float LayerThickness,
+    TArray<FVector>& OutVertices, TArray<int32>& OutTriangles)
+{
+    OutVertices.Reset();
+    OutTriangles.Reset();
+    
+    if (LayerCount <= 0)
+    {
+        return;
+    }
+    
+    const int32 ResX = FMath::Max(Settings.ResolutionX, 2);
+    const int32 ResY = FMath::Max(Settings.ResolutionY, 2);
+    
+    // Calculer le pas entre chaque point comme dans la génération de terrain standard
+    const float HStep = Settings.Width / (ResX - 1);
+    const float VStep = Settings.Height / (ResY - 1);
+    
+    // Calculer l'épaisseur de chaque couche interne
+    const float TotalDepth = Settings.Depth - (2 * LayerThickness); // Soustraire l'épaisseur des parois avant/arrière
+    const float LayerDepth = TotalDepth / LayerCount;
+    
+    // Tailles connues à l'avance : chaque couche est une copie de la grille de la face avant
+    const int32 VerticesPerLayer = ResX * ResY;
+    const int32 IndicesPerRow = (ResX - 1) * 6;
+    const int32 IndicesPerLayer = (ResY - 1) * IndicesPerRow;
+    const int32 TotalRows = LayerCount * ResY;
+    
+    OutVertices.SetNumUninitialized(LayerCount * VerticesPerLayer);
+    OutTriangles.SetNumUninitialized(LayerCount * IndicesPerLayer);
+    
+    // Une ligne de la grille par tâche
+    ParallelFor(TotalRows, [&](int32 RowIndex)
+    {
+        const int32 LayerIndex = RowIndex / ResY;
+        const int32 y = RowIndex % ResY;
+        
+        // Position Y de cette couche interne à partir de la face avant
+        const float LayerPosition = LayerThickness + (LayerIndex * LayerDepth);
+        
+        for (int32 x = 0; x < ResX; ++x)
+        {
+            const int32 VertexIndex = LayerIndex * VerticesPerLayer + y * ResX + x;
+            
+            OutVertices[VertexIndex] = FVector(x * HStep, LayerPosition, y * VStep);
+        }
+        
+        // Créer les triangles de la bande qui part de cette ligne
+        if (y < ResY - 1)
+        {
+            int32 Write = LayerIndex * IndicesPerLayer + y * IndicesPerRow;
+            for (int32 x = 0; x < ResX - 1; ++x)
+            {
+                const int32 Current = LayerIndex * VerticesPerLayer + y * ResX + x;
+                const int32 Next = Current + 1;
+                const int32 Bottom = Current + ResX;
+                const int32 BottomNext = Bottom + 1;
+                
+                OutTriangles[Write++] = Current;
+                OutTriangles[Write++] = Next;
+                OutTriangles[Write++] = Bottom;
+                
+                OutTriangles[Write++] = Next;
+                OutTriangles[Write++] = BottomNext;
+                OutTriangles[Write++] = Bottom;
+            }
+        }
+    });
+}
@@ -0,0 +1,138 @@
+#include "TerrainMeshTopology.h"
+#include "Async/ParallelFor.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+void FTerrainMeshTopology::Build(const TArray<int32>& InTriangles, int32 NumVertices)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FTerrainMeshTopology::Build);
+    
+    Triangles = InTriangles;
+    
+    int32 NumTriangles = Triangles.Num() / 3;
+    AliveTriangles.Init(true, NumTriangles);
+    AliveTriangleCount = NumTriangles;
+    VertexCount = NumVertices;
+    
+    // Adjacence compacte (CSR) : compter, cumuler, puis remplir
+    VertexTriangleOffsets.Init(0, NumVertices + 1);
+    for (int32 Index : Triangles)
+    {
+        VertexTriangleOffsets[Index + 1]++;
+    }
+    
+    for (int32 i = 0; i < NumVertices; ++i)
+    {
+        VertexTriangleOffsets[i + 1] += VertexTriangleOffsets[i];
+    }
+    
+    TArray<int32> WriteCursor(VertexTriangleOffsets.GetData(), NumVertices);
+    VertexTriangles.SetNumUninitialized(Triangles.Num());
+    for (int32 i = 0; i < Triangles.Num(); ++i)
+    {
+        VertexTriangles[WriteCursor[Triangles[i]]++] = i / 3;
+    }
+}
+
+void FTerrainMeshTopology::Reset()
+{
+    Triangles.Empty();
+    AliveTriangles.Empty();
+    VertexTriangleOffsets.Empty();
+    VertexTriangles.Empty();
+    AliveTriangleCount = 0;
+    VertexCount = 0;
+}
+
+bool FTerrainMeshTopology::IsValidFor(int32 NumVertices, int32 NumIndices) const
+{
+    return VertexCount > 0 && VertexCount == NumVertices &&
+           AliveTriangleCount * 3 == NumIndices;
+}
+
+bool FTerrainMeshTopology::SyncAliveTriangles(const TArray<int32>& InTriangles, int32 NumVertices)
+{
+    if (VertexCount <= 0 || VertexCount != NumVertices || InTriangles.Num() % 3 != 0 || InTriangles.Num() > AliveTriangleCount * 3)
+    {
+        return false;
+    }
+    
+    // Parcours simultané : un triangle vivant qui ne correspond pas au prochain triangle reçu a été détruit
+    int32 Next = 0;
+    for (int32 TriIdx = 0; TriIdx < AliveTriangles.Num(); ++TriIdx)
+    {
+        if (!AliveTriangles[TriIdx])
+        {
+            continue;
+        }
+        
+        if (Next < InTriangles.Num() &&
+            Triangles[TriIdx * 3] == InTriangles[Next] &&
+            Triangles[TriIdx * 3 + 1] == InTriangles[Next + 1] &&
+            Triangles[TriIdx * 3 + 2] == InTriangles[Next + 2])
+        {
+            Next += 3;
+            continue;
+        }
+        
+        AliveTriangles[TriIdx] = false;
+        AliveTriangleCount--;
+    }
+    return Next == InTriangles.Num();
+}
+
+void FTerrainMeshTopology::GatherAliveTriangles(TArray<int32>& OutTriangles) const
+{
+    OutTriangles.Reset(AliveTriangleCount * 3);
+    for (TConstSetBitIterator<> It(AliveTriangles); It; ++It)
+    {
+        int32 TriIdx = It.GetIndex();
+        OutTriangles.Add(Triangles[TriIdx * 3]);
+        OutTriangles.Add(Triangles[TriIdx * 3 + 1]);
+        OutTriangles.Add(Triangles[TriIdx * 3 + 2]);
+    }
+}
+
+FVector FTerrainMeshTopology::ComputeVertexNormal(int32 VertexIndex, const TArray<FVector>& Vertices) const
+{
+    return ComputeVertexNormal(VertexIndex, Vertices, AliveTriangles);
+}
+
+FVector FTerrainMeshTopology::ComputeVertexNormal(int32 VertexIndex, const TArray<FVector>& Vertices, const TBitArray<>& Alive) const
+{
+    FVector Normal = FVector::ZeroVector;
+    
+    // Somme des normales des faces encore vivantes autour du vertex
+    for (int32 Adj = VertexTriangleOffsets[VertexIndex]; Adj < VertexTriangleOffsets[VertexIndex + 1]; ++Adj)
+    {
+        int32 TriIdx = VertexTriangles[Adj];
+        if (Alive[TriIdx])
+        {
+            const FVector& V0 = Vertices[Triangles[TriIdx * 3]];
+            const FVector& V1 = Vertices[Triangles[TriIdx * 3 + 1]];
+            const FVector& V2 = Vertices[Triangles[TriIdx * 3 + 2]];
+            Normal += FVector::CrossProduct(V1 - V0, V2 - V0).GetSafeNormal();
+        }
+    }
+    
+    return Normal.GetSafeNormal();
+}
+
+void FTerrainMeshTopology::ComputeVertexNormals(const TArray<FVector>& Vertices, TArray<FVector>& OutNormals, int32 FirstVertex, int32 NumVertices) const
+{
+    if (OutNormals.Num() < FirstVertex + NumVertices)
+    {
+        OutNormals.SetNumUninitialized(FirstVertex + NumVertices);
+    }
+    
+    // Chaque tâche n'écrit que la normale de son propre vertex
+    ParallelFor(NumVertices, [&](int32 i)
+    {
+        OutNormals[FirstVertex + i] = ComputeVertexNormal(FirstVertex + i, Vertices);
+    });
+}
+
+SIZE_T FTerrainMeshTopology::GetAllocatedSize() const
+{
+    return Triangles.GetAllocatedSize() + AliveTriangles.GetAllocatedSize() +
+           VertexTriangleOffsets.GetAllocatedSize() + VertexTriangles.GetAllocatedSize();
+}
@@ -0,0 +1,119 @@
+#include "TerrainVoxelMesher.h"
+
+// Coins d'une cellule (bit 0 : X, bit 1 : Y, bit 2 : Z) et ses 12 arêtes
+static const FIntVector CellCorners[8] =
+{
+    FIntVector(0, 0, 0), FIntVector(1, 0, 0), FIntVector(0, 1, 0), FIntVector(1, 1, 0),
+    FIntVector(0, 0, 1), FIntVector(1, 0, 1), FIntVector(0, 1, 1), FIntVector(1, 1, 1)
+};
+
+static const int32 CellEdges[12][2] =
+{
+    {0, 1}, {2, 3}, {4, 5}, {6, 7},
+    {0, 2}, {1, 3}, {4, 6}, {5, 7},
+    {0, 4}, {1, 5}, {2, 6}, {3, 7}
+};
+
+void FTerrainVoxelMesher::BuildChunkMesh(const TArray<int8>& PaddedSamples, int32 ChunkSize, const FVector& ChunkOrigin, float VoxelSize,
+                                         FTerrainVoxelChunkMesh& OutMesh)
+{
+    OutMesh.Vertices.Reset();
+    OutMesh.Normals.Reset();
+    OutMesh.Triangles.Reset();
+    
+    const int32 Pitch = ChunkSize + 2;
+    const int32 CellPitch = ChunkSize + 1;
+    check(PaddedSamples.Num() == Pitch * Pitch * Pitch);
+    
+    auto SampleAt = [&](const FIntVector& P) -> int32
+    {
+        return PaddedSamples[(P.Z * Pitch + P.Y) * Pitch + P.X];
+    };
+    
+    // Sommet de chaque cellule, créé à la première demande : les cellules de bordure sans quad n'en produisent pas
+    TArray<int32> CellVertices;
+    CellVertices.Init(INDEX_NONE, CellPitch * CellPitch * CellPitch);
+    
+    auto GetCellVertex = [&](const FIntVector& Cell) -> int32
+    {
+        int32& VertexIndex = CellVertices[(Cell.Z * CellPitch + Cell.Y) * CellPitch + Cell.X];
+        if (VertexIndex != INDEX_NONE)
+        {
+            return VertexIndex;
+        }
+        
+        int32 Corners[8];
+        for (int32 c = 0; c < 8; ++c)
+        {
+            Corners[c] = SampleAt(Cell + CellCorners[c]);
+        }
+        
+        // Moyenne des points de passage à zéro sur les arêtes de la cellule
+        FVector Sum = FVector::ZeroVector;
+        int32 Crossings = 0;
+        for (int32 e = 0; e < 12; ++e)
+        {
+            const int32 D0 = Corners[CellEdges[e][0]];
+            const int32 D1 = Corners[CellEdges[e][1]];
+            if ((D0 > 0) != (D1 > 0))
+            {
+                const float T = (float)D0 / (float)(D0 - D1);
+                Sum += FMath::Lerp(FVector(CellCorners[CellEdges[e][0]]), FVector(CellCorners[CellEdges[e][1]]), T);
+                ++Crossings;
+            }
+        }
+        const FVector InCell = Crossings > 0 ? Sum / Crossings : FVector(0.5);
+        
+        // La densité croît vers la matière : la normale sortante suit l'opposé du gradient
+        const FVector Gradient(
+            (Corners[1] - Corners[0]) + (Corners[3] - Corners[2]) + (Corners[5] - Corners[4]) + (Corners[7] - Corners[6]),
+            (Corners[2] - Corners[0]) + (Corners[3] - Corners[1]) + (Corners[6] - Corners[4]) + (Corners[7] - Corners[5]),
+            (Corners[4] - Corners[0]) + (Corners[5] - Corners[1]) + (Corners[6] - Corners[2]) + (Corners[7] - Corners[3]));
+        
+        // Index paddé 1 = premier échantillon du chunk
+        VertexIndex = OutMesh.Vertices.Add(ChunkOrigin + (FVector(Cell) + InCell - FVector(1.0)) * VoxelSize);
+        OutMesh.Normals.Add((-Gradient).GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector));
+        return VertexIndex;
+    };
+    
+    const FIntVector Axes[3] = { FIntVector(1, 0, 0), FIntVector(0, 1, 0), FIntVector(0, 0, 1) };
+    
+    for (int32 z = 1; z <= ChunkSize; ++z)
+    {
+        for (int32 y = 1; y <= ChunkSize; ++y)
+        {
+            for (int32 x = 1; x <= ChunkSize; ++x)
+            {
+                const FIntVector P(x, y, z);
+                const bool bSolid = SampleAt(P) > 0;
+                
+                for (int32 a = 0; a < 3; ++a)
+                {
+                    if ((SampleAt(P + Axes[a]) > 0) == bSolid)
+                    {
+                        continue;
+                    }
+                    
+                    // Les 4 cellules qui partagent l'arête, dans le plan des deux autres axes (ordre cyclique a, b, c)
+                    const FIntVector& B = Axes[(a + 1) % 3];
+                    const FIntVector& C = Axes[(a + 2) % 3];
+                    const int32 V0 = GetCellVertex(P - B - C);
+                    const int32 V1 = GetCellVertex(P - B);
+                    const int32 V2 = GetCellVertex(P);
+                    const int32 V3 = GetCellVertex(P - C);
+                    
+                    // (V1 - V0) x (V2 - V0) vaut -a dans cet ordre : on retourne le quad quand la matière est du côté de P,
+                    // pour que la face avant regarde toujours le vide
+                    if (bSolid)
+                    {
+                        OutMesh.Triangles.Append({ V0, V2, V1, V0, V3, V2 });
+                    }
+                    else
+                    {
+                        OutMesh.Triangles.Append({ V0, V1, V2, V0, V2, V3 });
+                    }
+                }
+            }
+        }
+    }
+}
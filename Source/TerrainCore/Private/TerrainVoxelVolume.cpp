@@ -0,0 +1,311 @@
+#include "TerrainVoxelVolume.h"
+#include "Async/ParallelFor.h"
+
+// Distance en voxels -> densité : 32 pas par voxel, saturée à environ 4 voxels de la surface
+static int8 QuantizeDistance(float DistanceInVoxels)
+{
+    return (int8)FMath::Clamp(FMath::RoundToInt(DistanceInVoxels * 32.0f), -127, 127);
+}
+
+static int32 FloorDiv(int32 Value, int32 Divisor)
+{
+    return Value >= 0 ? Value / Divisor : -((-Value + Divisor - 1) / Divisor);
+}
+
+void FTerrainVoxelVolume::Initialize(const FTerrainVoxelSettings& InSettings)
+{
+    Settings = InSettings;
+    Settings.VoxelSize = FMath::Max(Settings.VoxelSize, 1.0f);
+    Settings.ChunkSize = FMath::Max(Settings.ChunkSize, 2);
+    Settings.ChunkCount = Settings.ChunkCount.ComponentMax(FIntVector(1, 1, 1));
+    Chunks.Reset();
+}
+
+void FTerrainVoxelVolume::Fill(TFunctionRef<float(const FVector&)> SignedDistance)
+{
+    Chunks.Reset();
+    
+    const int32 N = Settings.ChunkSize;
+    const FIntVector Count = Settings.ChunkCount;
+    const int32 ChunkTotal = Count.X * Count.Y * Count.Z;
+    
+    // Un chunk par tâche ; le résultat n'est inséré dans la table qu'à la fin (TMap non thread-safe)
+    TArray<TArray<int8>> Filled;
+    TArray<uint8> States;
+    Filled.SetNum(ChunkTotal);
+    States.SetNumZeroed(ChunkTotal);
+    
+    ParallelFor(ChunkTotal, [&](int32 ChunkIndex)
+    {
+        const FIntVector ChunkCoord(ChunkIndex % Count.X, (ChunkIndex / Count.X) % Count.Y, ChunkIndex / (Count.X * Count.Y));
+        TArray<int8>& Samples = Filled[ChunkIndex];
+        Samples.SetNumUninitialized(N * N * N);
+        
+        bool bAllSolid = true;
+        bool bAllEmpty = true;
+        for (int32 z = 0; z < N; ++z)
+        {
+            for (int32 y = 0; y < N; ++y)
+            {
+                for (int32 x = 0; x < N; ++x)
+                {
+                    const FVector Position = FVector(ChunkCoord * N + FIntVector(x, y, z)) * Settings.VoxelSize;
+                    const int8 Value = QuantizeDistance(SignedDistance(Position) / Settings.VoxelSize);
+                    Samples[(z * N + y) * N + x] = Value;
+                    bAllSolid &= Value == SolidValue;
+                    bAllEmpty &= Value == EmptyValue;
+                }
+            }
+        }
+        
+        // 0 : dense, 1 : uniformément plein, 2 : vide
+        States[ChunkIndex] = bAllSolid ? 1 : (bAllEmpty ? 2 : 0);
+    });
+    
+    for (int32 ChunkIndex = 0; ChunkIndex < ChunkTotal; ++ChunkIndex)
+    {
+        if (States[ChunkIndex] == 2)
+        {
+            continue;
+        }
+        
+        const FIntVector ChunkCoord(ChunkIndex % Count.X, (ChunkIndex / Count.X) % Count.Y, ChunkIndex / (Count.X * Count.Y));
+        FChunk& Chunk = Chunks.Add(ChunkCoord);
+        if (States[ChunkIndex] == 0)
+        {
+            Chunk.Samples = MoveTemp(Filled[ChunkIndex]);
+        }
+    }
+}
+
+bool FTerrainVoxelVolume::IsValidChunk(const FIntVector& ChunkCoord) const
+{
+    return ChunkCoord.X >= 0 && ChunkCoord.Y >= 0 && ChunkCoord.Z >= 0 &&
+           ChunkCoord.X < Settings.ChunkCount.X && ChunkCoord.Y < Settings.ChunkCount.Y && ChunkCoord.Z < Settings.ChunkCount.Z;
+}
+
+FIntVector FTerrainVoxelVolume::GetChunkForSample(const FIntVector& Sample) const
+{
+    return FIntVector(FloorDiv(Sample.X, Settings.ChunkSize), FloorDiv(Sample.Y, Settings.ChunkSize), FloorDiv(Sample.Z, Settings.ChunkSize));
+}
+
+int32 FTerrainVoxelVolume::GetIndexInChunk(const FIntVector& Sample, const FIntVector& ChunkCoord) const
+{
+    const int32 N = Settings.ChunkSize;
+    const FIntVector Local = Sample - ChunkCoord * N;
+    return (Local.Z * N + Local.Y) * N + Local.X;
+}
+
+int8 FTerrainVoxelVolume::GetSample(const FIntVector& Sample) const
+{
+    const FIntVector ChunkCoord = GetChunkForSample(Sample);
+    const FChunk* Chunk = IsValidChunk(ChunkCoord) ? Chunks.Find(ChunkCoord) : nullptr;
+    if (!Chunk)
+    {
+        return EmptyValue;
+    }
+    return Chunk->Samples.Num() > 0 ? Chunk->Samples[GetIndexInChunk(Sample, ChunkCoord)] : SolidValue;
+}
+
+bool FTerrainVoxelVolume::IsPointSolid(const FVector& LocalPoint) const
+{
+    const FVector Scaled = LocalPoint / Settings.VoxelSize;
+    return GetSample(FIntVector(FMath::RoundToInt(Scaled.X), FMath::RoundToInt(Scaled.Y), FMath::RoundToInt(Scaled.Z))) > 0;
+}
+
+TArray<int8>* FTerrainVoxelVolume::GetMutableSamples(const FIntVector& ChunkCoord)
+{
+    FChunk* Chunk = Chunks.Find(ChunkCoord);
+    if (!Chunk)
+    {
+        return nullptr;
+    }
+    
+    if (Chunk->Samples.Num() == 0)
+    {
+        const int32 N = Settings.ChunkSize;
+        Chunk->Samples.Init(SolidValue, N * N * N);
+    }
+    return &Chunk->Samples;
+}
+
+bool FTerrainVoxelVolume::CarveSphere(const FVector& Center, float Radius, TArray<FIntVector>& OutTouchedChunks)
+{
+    const float VoxelSize = Settings.VoxelSize;
+    const FIntVector SampleCount = Settings.GetSampleCount();
+    const int32 N = Settings.ChunkSize;
+    
+    // Échantillons dont la densité peut changer : la sphère plus la bande de saturation
+    const float Reach = Radius + 4.0f * VoxelSize;
+    const FIntVector Min(
+        FMath::Max(FMath::FloorToInt((Center.X - Reach) / VoxelSize), 0),
+        FMath::Max(FMath::FloorToInt((Center.Y - Reach) / VoxelSize), 0),
+        FMath::Max(FMath::FloorToInt((Center.Z - Reach) / VoxelSize), 0));
+    const FIntVector Max(
+        FMath::Min(FMath::CeilToInt((Center.X + Reach) / VoxelSize), SampleCount.X - 1),
+        FMath::Min(FMath::CeilToInt((Center.Y + Reach) / VoxelSize), SampleCount.Y - 1),
+        FMath::Min(FMath::CeilToInt((Center.Z + Reach) / VoxelSize), SampleCount.Z - 1));
+    
+    if (Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z)
+    {
+        return false;
+    }
+    
+    // Seuls les chunks recouverts par la boîte sont parcourus : le coût ne dépend pas de la taille du volume
+    FIntVector ChangedMin(MAX_int32, MAX_int32, MAX_int32);
+    FIntVector ChangedMax(MIN_int32, MIN_int32, MIN_int32);
+    const FIntVector MinChunk = GetChunkForSample(Min);
+    const FIntVector MaxChunk = GetChunkForSample(Max);
+    
+    for (int32 cz = MinChunk.Z; cz <= MaxChunk.Z; ++cz)
+    {
+        for (int32 cy = MinChunk.Y; cy <= MaxChunk.Y; ++cy)
+        {
+            for (int32 cx = MinChunk.X; cx <= MaxChunk.X; ++cx)
+            {
+                const FIntVector ChunkCoord(cx, cy, cz);
+                TArray<int8>* Samples = GetMutableSamples(ChunkCoord);
+                if (!Samples)
+                {
+                    continue;
+                }
+                
+                const FIntVector ChunkMin = (ChunkCoord * N).ComponentMax(Min);
+                const FIntVector ChunkMax = (ChunkCoord * N + FIntVector(N - 1, N - 1, N - 1)).ComponentMin(Max);
+                for (int32 z = ChunkMin.Z; z <= ChunkMax.Z; ++z)
+                {
+                    for (int32 y = ChunkMin.Y; y <= ChunkMax.Y; ++y)
+                    {
+                        for (int32 x = ChunkMin.X; x <= ChunkMax.X; ++x)
+                        {
+                            // Soustraction de volumes : la densité garde le minimum avec l'extérieur de la sphère
+                            const FIntVector Sample(x, y, z);
+                            const float Distance = (FVector(Sample) * VoxelSize - Center).Size() - Radius;
+                            const int8 SphereValue = QuantizeDistance(Distance / VoxelSize);
+                            
+                            int8& Value = (*Samples)[GetIndexInChunk(Sample, ChunkCoord)];
+                            if (SphereValue < Value)
+                            {
+                                Value = SphereValue;
+                                ChangedMin = ChangedMin.ComponentMin(Sample);
+                                ChangedMax = ChangedMax.ComponentMax(Sample);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    if (ChangedMin.X > ChangedMax.X)
+    {
+        return false;
+    }
+    
+    // Un chunk lit les échantillons [Chunk * N - 1, (Chunk + 1) * N] : ses voisins inférieurs voient aussi la modification
+    const FIntVector TouchedMin(FloorDiv(ChangedMin.X - 1, N), FloorDiv(ChangedMin.Y - 1, N), FloorDiv(ChangedMin.Z - 1, N));
+    const FIntVector TouchedMax(FloorDiv(ChangedMax.X + 1, N), FloorDiv(ChangedMax.Y + 1, N), FloorDiv(ChangedMax.Z + 1, N));
+    for (int32 cz = TouchedMin.Z; cz <= TouchedMax.Z; ++cz)
+    {
+        for (int32 cy = TouchedMin.Y; cy <= TouchedMax.Y; ++cy)
+        {
+            for (int32 cx = TouchedMin.X; cx <= TouchedMax.X; ++cx)
+            {
+                if (IsValidChunk(FIntVector(cx, cy, cz)))
+                {
+                    OutTouchedChunks.AddUnique(FIntVector(cx, cy, cz));
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void FTerrainVoxelVolume::CopyPaddedChunk(const FIntVector& ChunkCoord, TArray<int8>& OutSamples) const
+{
+    const int32 N = Settings.ChunkSize;
+    const int32 Pitch = N + 2;
+    const FIntVector Base = ChunkCoord * N - FIntVector(1, 1, 1);
+    OutSamples.SetNumUninitialized(Pitch * Pitch * Pitch);
+    
+    // Intérieur du chunk recopié ligne par ligne ; seule la bordure passe par GetSample()
+    const FChunk* Chunk = Chunks.Find(ChunkCoord);
+    for (int32 z = 0; z < Pitch; ++z)
+    {
+        for (int32 y = 0; y < Pitch; ++y)
+        {
+            int8* Row = &OutSamples[(z * Pitch + y) * Pitch];
+            const bool bInteriorRow = z >= 1 && z <= N && y >= 1 && y <= N;
+            if (bInteriorRow && Chunk)
+            {
+                Row[0] = GetSample(Base + FIntVector(0, y, z));
+                if (Chunk->Samples.Num() > 0)
+                {
+                    FMemory::Memcpy(Row + 1, &Chunk->Samples[((z - 1) * N + (y - 1)) * N], N);
+                }
+                else
+                {
+                    FMemory::Memset(Row + 1, (uint8)SolidValue, N);
+                }
+                Row[N + 1] = GetSample(Base + FIntVector(N + 1, y, z));
+                continue;
+            }
+            
+            for (int32 x = 0; x < Pitch; ++x)
+            {
+                Row[x] = GetSample(Base + FIntVector(x, y, z));
+            }
+        }
+    }
+}
+
+bool FTerrainVoxelVolume::MayContainSurface(const FIntVector& ChunkCoord) const
+{
+    // Un chunk dense contient probablement la surface ; sinon tout dépend des voisins dont il lit la bordure
+    auto GetState = [this](const FIntVector& Coord) -> int32
+    {
+        const FChunk* Chunk = IsValidChunk(Coord) ? Chunks.Find(Coord) : nullptr;
+        return !Chunk ? 2 : (Chunk->Samples.Num() > 0 ? 0 : 1);
+    };
+    
+    const int32 State = GetState(ChunkCoord);
+    if (State == 0)
+    {
+        return true;
+    }
+    
+    for (int32 dz = -1; dz <= 1; ++dz)
+    {
+        for (int32 dy = -1; dy <= 1; ++dy)
+        {
+            for (int32 dx = -1; dx <= 1; ++dx)
+            {
+                if (GetState(ChunkCoord + FIntVector(dx, dy, dz)) != State)
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+int32 FTerrainVoxelVolume::GetDenseChunkCount() const
+{
+    int32 Count = 0;
+    for (const TPair<FIntVector, FChunk>& Pair : Chunks)
+    {
+        Count += Pair.Value.Samples.Num() > 0 ? 1 : 0;
+    }
+    return Count;
+}
+
+SIZE_T FTerrainVoxelVolume::GetAllocatedSize() const
+{
+    SIZE_T Size = Chunks.GetAllocatedSize();
+    for (const TPair<FIntVector, FChunk>& Pair : Chunks)
+    {
+        Size += Pair.Value.Samples.GetAllocatedSize();
+    }
+    return Size;
+}
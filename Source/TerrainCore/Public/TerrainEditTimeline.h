@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TerrainGrid.h"
+
+// Chronologie des creusements d'une grille, pour reconstruire un état passé en temps borné
+// Des points de contrôle (masque complet encodé en plages) sont pris toutes les CheckpointInterval modifications :
+// une reconstruction décode le point de contrôle le plus proche puis rejoue au plus CheckpointInterval creusements.
+// Au-delà du budget mémoire, les plus anciens points de contrôle et leurs modifications sont oubliés.
+struct TERRAINCORE_API FTerrainEditTimeline
+{
+    void SetLimits(int32 InCheckpointInterval, int64 InMaxBytes);
+    
+    void Reset();
+    bool IsEmpty() const { return Checkpoints.Num() == 0; }
+    
+    // Point de contrôle de l'état courant de la grille (les modifications suivantes sont rejouées à partir de lui)
+    // Une grille de paramètres différents remet la chronologie à zéro.
+    void AddCheckpoint(double Time, const FTerrainGrid& Grid);
+    
+    // Enregistre un creusement rectangulaire ; GridAfter contient déjà ce creusement
+    void RecordEdit(double Time, const FVector2D& Position, const FVector2D& Size, const FTerrainGrid& GridAfter);
+    
+    int32 GetEditCount() const { return Edits.Num(); }
+    
+    // Instant du plus ancien état reconstructible
+    double GetStartTime() const;
+    
+    // Grille telle qu'elle était à l'instant Time (creusements enregistrés jusqu'à Time inclus)
+    bool ReconstructAt(double Time, FTerrainGrid& OutGrid) const;
+    
+    // Grille avant les Count derniers creusements
+    bool ReconstructBeforeLastEdits(int32 Count, FTerrainGrid& OutGrid) const;
+    
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    struct FEdit
+    {
+        double Time = 0.0;
+        FVector2D Position = FVector2D::ZeroVector;
+        FVector2D Size = FVector2D::ZeroVector;
+    };
+    
+    struct FCheckpoint
+    {
+        double Time = 0.0;
+        
+        // Le masque contient les creusements [0, EditIndex[ de Edits
+        int32 EditIndex = 0;
+        TArray<uint8> Runs;
+    };
+    
+    // État après les EditCount premiers creusements enregistrés
+    bool ReconstructEditCount(int32 EditCount, FTerrainGrid& OutGrid) const;
+    
+    void EnforceBudget();
+    
+    FTerrainGridSettings Settings;
+    TArray<FEdit> Edits;
+    TArray<FCheckpoint> Checkpoints;
+    
+    int32 CheckpointInterval = 16;
+    int64 MaxBytes = 256 * 1024;
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Paramètres de la grille du terrain, dans son repère local :
+// X en largeur, Z en hauteur, le terrain étant extrudé selon Y sur toute sa profondeur
+struct TERRAINCORE_API FTerrainGridSettings
+{
+    // Nombre de vertices de la grille par ligne et par colonne (au moins 2)
+    int32 ResolutionX = 2;
+    int32 ResolutionY = 2;
+    
+    float Width = 2000.0f;
+    float Height = 2000.0f;
+    float Depth = 1000.0f;
+    
+    // Découpage en sections (une seule section si désactivé)
+    bool bUseSections = true;
+    float SectionSizeX = 500.0f;
+    float SectionSizeY = 500.0f;
+    
+    bool operator==(const FTerrainGridSettings& Other) const
+    {
+        return ResolutionX == Other.ResolutionX && ResolutionY == Other.ResolutionY &&
+               Width == Other.Width && Height == Other.Height && Depth == Other.Depth &&
+               bUseSections == Other.bUseSections && SectionSizeX == Other.SectionSizeX && SectionSizeY == Other.SectionSizeY;
+    }
+    
+    bool operator!=(const FTerrainGridSettings& Other) const
+    {
+        return !(*this == Other);
+    }
+};
+
+// Résultat d'une requête sur la grille, en coordonnées locales
+struct FTerrainGridHit
+{
+    // Fraction du segment [0, 1] au point d'impact
+    float Time = 1.0f;
+    
+    FVector Location = FVector::ZeroVector;
+    FVector Normal = FVector::ZeroVector;
+    
+    // Cellule touchée
+    FIntPoint Cell = FIntPoint(INDEX_NONE, INDEX_NONE);
+};
+
+// Grille d'occupation du terrain destructible : masque 2D (X/Z) des vertices détruits, sections et requêtes
+// Une cellule est pleine tant que ses quatre coins sont intacts. Aucune dépendance UObject :
+// la grille est utilisable et testable sans monde, et lisible hors du game thread tant qu'elle n'est pas modifiée.
+struct TERRAINCORE_API FTerrainGrid
+{
+    // Change les paramètres ; le masque n'est vidé que si la résolution change
+    void SetSettings(const FTerrainGridSettings& InSettings);
+    const FTerrainGridSettings& GetSettings() const { return Settings; }
+    
+    // Remet tous les vertices intacts
+    void Reset();
+    
+    // Pas entre deux vertices de la grille (X en largeur, Y en hauteur)
+    FVector2D GetStep() const;
+    
+    int32 GetCellCountX() const { return Settings.ResolutionX - 1; }
+    int32 GetCellCountY() const { return Settings.ResolutionY - 1; }
+    
+    bool IsVertexCarved(int32 X, int32 Y) const;
+    bool IsCellSolid(int32 X, int32 Y) const;
+    
+    // Masque brut, indexé par Y * ResolutionX + X
+    const TBitArray<>& GetCarvedMask() const { return Carved; }
+    
+    // Détruit les vertices du rectangle [Position, Position + Size] ; OutNewlyCarved reçoit les index de grille
+    // nouvellement détruits. OutMinSection/OutMaxSection couvrent les sections dont des cellules ont pu changer.
+    // Retourne false si le rectangle ne recouvre aucun vertex.
+    bool CarveRect(const FVector2D& Position, const FVector2D& Size, TArray<int32>* OutNewlyCarved,
+        FIntPoint& OutMinSection, FIntPoint& OutMaxSection);
+    
+    // Détruit tous les vertices marqués dans un masque de même taille (union), mêmes sorties que CarveRect()
+    // Retourne false si aucun vertex n'a changé.
+    bool CarveMask(const TBitArray<>& Mask, TArray<int32>* OutNewlyCarved, FIntPoint& OutMinSection, FIntPoint& OutMaxSection);
+    
+    // Masque encodé en plages alternées intact/détruit (longueurs en varints, la première plage est intacte)
+    // Quelques octets par cratère au lieu d'un bit par vertex : la taille suit la forme des dégâts, pas la résolution
+    void EncodeCarvedRuns(TArray<uint8>& OutRuns) const;
+    
+    // Remplace le masque par des plages encodées ; false si elles ne couvrent pas exactement la grille
+    bool DecodeCarvedRuns(const TArray<uint8>& Runs);
+    
+    // Correspondance entre cellules et sections
+    FIntPoint GetSectionCount() const;
+    FIntPoint GetSectionForCell(int32 X, int32 Y) const;
+    
+    // Plage de cellules [Min, Max[ appartenant à une section
+    void GetSectionCellRange(const FIntPoint& SectionCoord, FIntPoint& OutMin, FIntPoint& OutMax) const;
+    
+    // Boîte d'une cellule sur toute la profondeur
+    FBox GetCellBox(int32 X, int32 Y) const;
+    
+    // Requêtes en coordonnées locales
+    bool IsPointInside(const FVector& LocalPoint) const;
+    
+    // Premier impact d'un segment, par parcours DDA des cellules traversées
+    bool Raycast(const FVector& LocalStart, const FVector& LocalEnd, FTerrainGridHit& OutHit) const;
+    
+    // Part du segment [0, 1] passée dans des cellules pleines, en ignorant le début du segment (t < MinTime)
+    // Sert aux tests de visibilité atténués : 0 si la ligne est dégagée, 1 si elle est entièrement dans le terrain
+    float GetSolidFraction(const FVector& LocalStart, const FVector& LocalEnd, float MinTime = 0.0f) const;
+    
+    // Une sphère recouvre-t-elle une cellule pleine ? (point et cellule les plus proches du centre)
+    bool OverlapSphere(const FVector& Center, float Radius, FVector* OutClosestPoint = nullptr, FIntPoint* OutCell = nullptr) const;
+    
+    // Premier contact d'une sphère balayée le long d'un segment
+    bool SweepSphere(const FVector& LocalStart, const FVector& LocalEnd, float Radius, FTerrainGridHit& OutHit) const;
+    
+    // Cellules pleines dont le dessus est dégagé sur au moins Clearance
+    void GetStandableSurfaceCells(float Clearance, TArray<FIntPoint>& OutCells) const;
+    
+    SIZE_T GetAllocatedSize() const { return Carved.GetAllocatedSize(); }
+
+private:
+    FTerrainGridSettings Settings;
+    TBitArray<> Carved;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TerrainGrid.h"
+
+// Construction des meshes pleine résolution de la grille (positions et indices), sans couleurs ni normales
+// Disposition des vertices : chaque face ou couche est une copie complète de la grille, indexée Y * ResolutionX + X
+// Aucun UV ni tangente stockés : ils sont déduits de la position locale (X / Width, Z / Height) à l'envoi au rendu
+struct TERRAINCORE_API FTerrainGridMesher
+{
+    // Faces avant (Y = 0) et arrière (Y = Depth) puis les quatre côtés : 2 copies de la grille
+    static void BuildShell(const FTerrainGridSettings& Settings, TArray<FVector>& OutVertices,
+        TArray<int32>& OutTriangles);
+
+    // Couches internes parallèles aux faces, réparties entre les parois avant et arrière d'épaisseur LayerThickness
+    static void BuildInternalLayers(const FTerrainGridSettings& Settings, int32 LayerCount, float LayerThickness,
+        TArray<FVector>& OutVertices, TArray<int32>& OutTriangles);
+};
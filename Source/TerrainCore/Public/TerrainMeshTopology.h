@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Adjacence vertex -> triangles conservée à côté du mesh pour les mises à jour incrémentales
+// Les indices de triangles restent stables : un triangle détruit est seulement marqué mort
+struct TERRAINCORE_API FTerrainMeshTopology
+{
+    // Tous les triangles connus lors de la construction (3 indices par triangle)
+    TArray<int32> Triangles;
+    
+    // Triangles encore présents dans le mesh
+    TBitArray<> AliveTriangles;
+    
+    // Adjacence compacte : triangles du vertex i dans VertexTriangles[Offsets[i], Offsets[i + 1][
+    TArray<int32> VertexTriangleOffsets;
+    TArray<int32> VertexTriangles;
+    
+    int32 AliveTriangleCount = 0;
+    int32 VertexCount = 0;
+    
+    void Build(const TArray<int32>& InTriangles, int32 NumVertices);
+    void Reset();
+    
+    // L'adjacence correspond-elle à un mesh de NumVertices vertices et NumIndices indices ?
+    bool IsValidFor(int32 NumVertices, int32 NumIndices) const;
+    
+    // Aligne l'adjacence sur un tampon d'indices issu du même mesh (triangles vivants dans le même ordre, certains
+    // en moins) : les triangles absents sont marqués morts. False si le tampon ne dérive pas de ce mesh (à reconstruire).
+    bool SyncAliveTriangles(const TArray<int32>& InTriangles, int32 NumVertices);
+    
+    // Recopie les triangles vivants dans un tampon d'indices
+    void GatherAliveTriangles(TArray<int32>& OutTriangles) const;
+    
+    // Normale d'un vertex à partir de ses seules faces vivantes
+    FVector ComputeVertexNormal(int32 VertexIndex, const TArray<FVector>& Vertices) const;
+    
+    // Même calcul avec un autre ensemble de triangles vivants (état passé du mesh, par exemple)
+    FVector ComputeVertexNormal(int32 VertexIndex, const TArray<FVector>& Vertices, const TBitArray<>& Alive) const;
+    
+    // Normales d'une plage de vertices, calculées en parallèle par gather sur l'adjacence
+    void ComputeVertexNormals(const TArray<FVector>& Vertices, TArray<FVector>& OutNormals, int32 FirstVertex, int32 NumVertices) const;
+    
+    SIZE_T GetAllocatedSize() const;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Mesh d'un chunk voxel (repère local du volume)
+struct FTerrainVoxelChunkMesh
+{
+    TArray<FVector> Vertices;
+    TArray<FVector> Normals;
+    TArray<int32> Triangles;
+    
+    bool IsEmpty() const { return Triangles.Num() == 0; }
+};
+
+// Extraction de surface par "surface nets" : un sommet par cellule traversée, un quad par arête qui change de signe.
+// Sans état et sans dépendance UObject : appelé sur des threads de travail avec une copie des échantillons du chunk.
+struct TERRAINCORE_API FTerrainVoxelMesher
+{
+    // PaddedSamples : (ChunkSize + 2)^3 échantillons issus de FTerrainVoxelVolume::CopyPaddedChunk
+    // ChunkOrigin : position locale du premier échantillon du chunk (ChunkCoord * ChunkSize * VoxelSize)
+    // Seules les arêtes partant des échantillons du chunk produisent des quads : deux chunks voisins ne se recouvrent pas,
+    // et leurs sommets de bordure coïncident puisqu'ils sont calculés à partir des mêmes échantillons.
+    static void BuildChunkMesh(const TArray<int8>& PaddedSamples, int32 ChunkSize, const FVector& ChunkOrigin, float VoxelSize,
+                               FTerrainVoxelChunkMesh& OutMesh);
+};
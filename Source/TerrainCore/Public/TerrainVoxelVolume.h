@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Paramètres d'un volume voxel, dans son repère local (origine au coin inférieur, Z vers le haut)
+struct FTerrainVoxelSettings
+{
+    // Distance entre deux échantillons
+    float VoxelSize = 50.0f;
+    
+    // Échantillons par arête de chunk
+    int32 ChunkSize = 16;
+    
+    // Étendue du volume, en chunks
+    FIntVector ChunkCount = FIntVector(8, 8, 4);
+    
+    FIntVector GetSampleCount() const { return ChunkCount * ChunkSize; }
+    
+    bool operator==(const FTerrainVoxelSettings& Other) const
+    {
+        return VoxelSize == Other.VoxelSize && ChunkSize == Other.ChunkSize && ChunkCount == Other.ChunkCount;
+    }
+};
+
+// Volume de terrain en voxels : densité signée quantifiée sur 8 bits (positive dans la matière, surface à 0)
+// Stockage creux par chunk : un chunk absent est vide, un chunk uniforme (entièrement plein) n'a pas de tableau ;
+// seuls les chunks traversés par la surface stockent leurs ChunkSize^3 échantillons.
+// Aucune dépendance UObject ; lisible depuis plusieurs threads tant qu'aucun creusement n'est en cours.
+struct TERRAINCORE_API FTerrainVoxelVolume
+{
+    // Valeurs saturées : au-delà de quelques voxels de la surface, la densité ne change plus
+    static constexpr int8 EmptyValue = -127;
+    static constexpr int8 SolidValue = 127;
+    
+    // Vide le volume et change ses dimensions
+    void Initialize(const FTerrainVoxelSettings& InSettings);
+    const FTerrainVoxelSettings& GetSettings() const { return Settings; }
+    
+    // Remplit le volume à partir d'une distance signée à la surface (positive dans la matière, unités locales)
+    // Les chunks sont évalués en parallèle : SignedDistance doit pouvoir être appelée depuis plusieurs threads.
+    void Fill(TFunctionRef<float(const FVector&)> SignedDistance);
+    
+    // Densité d'un échantillon (vide hors du volume)
+    int8 GetSample(const FIntVector& Sample) const;
+    
+    // Le point local est-il dans la matière ? (échantillon le plus proche)
+    bool IsPointSolid(const FVector& LocalPoint) const;
+    
+    // Soustrait une sphère (coordonnées locales). OutTouchedChunks reçoit les chunks dont le mesh change,
+    // y compris les voisins dont la bordure lit un échantillon modifié. Retourne false si rien n'a changé.
+    bool CarveSphere(const FVector& Center, float Radius, TArray<FIntVector>& OutTouchedChunks);
+    
+    // Échantillons [Chunk * ChunkSize - 1, (Chunk + 1) * ChunkSize + 1[ sur chaque axe, soit (ChunkSize + 2)^3,
+    // indexés (Z * Pitch + Y) * Pitch + X : tout ce que le mesher lit pour ce chunk, copié pour un thread de travail
+    void CopyPaddedChunk(const FIntVector& ChunkCoord, TArray<int8>& OutSamples) const;
+    
+    // Le chunk peut-il contenir une surface ? (faux si lui et ses voisins sont uniformes et de même état)
+    bool MayContainSurface(const FIntVector& ChunkCoord) const;
+    
+    bool IsValidChunk(const FIntVector& ChunkCoord) const;
+    int32 GetDenseChunkCount() const;
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    struct FChunk
+    {
+        // Vide si le chunk est uniformément plein
+        TArray<int8> Samples;
+    };
+    
+    // Chunk contenant un échantillon, et index de l'échantillon dans ce chunk
+    FIntVector GetChunkForSample(const FIntVector& Sample) const;
+    int32 GetIndexInChunk(const FIntVector& Sample, const FIntVector& ChunkCoord) const;
+    
+    // Convertit un chunk uniforme en tableau modifiable ; nullptr pour un chunk vide (rien à creuser)
+    TArray<int8>* GetMutableSamples(const FIntVector& ChunkCoord);
+    
+    FTerrainVoxelSettings Settings;
+    TMap<FIntVector, FChunk> Chunks;
+};
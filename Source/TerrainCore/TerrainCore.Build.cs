@@ -0,0 +1,14 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+using UnrealBuildTool;
+
+public class TerrainCore : ModuleRules
+{
+	public TerrainCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Cœur géométrique du terrain destructible : C++ pur, sans UObject, monde ni rendu
+		PublicDependencyModuleNames.AddRange(new string[] { "Core" });
+	}
+}
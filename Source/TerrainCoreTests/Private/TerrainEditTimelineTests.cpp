@@ -0,0 +1,79 @@
+#include "TerrainEditTimeline.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainEditTimelineTest, "Worms3d.TerrainCore.EditTimeline",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainEditTimelineTest::RunTest(const FString& Parameters)
+{
+    FTerrainGridSettings Settings;
+    Settings.ResolutionX = 11;
+    Settings.ResolutionY = 11;
+    Settings.Width = 1000.0f;
+    Settings.Height = 1000.0f;
+    
+    FTerrainGrid Grid;
+    Grid.SetSettings(Settings);
+    
+    // Point de contrôle toutes les 4 modifications : départ, puis après les creusements 4 et 8
+    FTerrainEditTimeline Timeline;
+    Timeline.SetLimits(4, 1024 * 1024);
+    Timeline.AddCheckpoint(0.0, Grid);
+    
+    // États de référence après chaque creusement (colonne X = i, de plus en plus haute)
+    TArray<TArray<uint8>> States;
+    Grid.EncodeCarvedRuns(States.AddDefaulted_GetRef());
+    
+    FIntPoint MinSection, MaxSection;
+    for (int32 i = 0; i < 10; ++i)
+    {
+        const FVector2D Position(i * 100.0f - 10.0f, -10.0f);
+        const FVector2D Size(20.0f, 60.0f + i * 100.0f);
+        Grid.CarveRect(Position, Size, nullptr, MinSection, MaxSection);
+        Timeline.RecordEdit(i + 1.0, Position, Size, Grid);
+        Grid.EncodeCarvedRuns(States.AddDefaulted_GetRef());
+    }
+    TestEqual(TEXT("Every edit recorded"), Timeline.GetEditCount(), 10);
+    
+    FTerrainGrid Reconstructed;
+    TArray<uint8> Runs;
+    for (int32 EditCount = 0; EditCount <= 10; ++EditCount)
+    {
+        TestTrue(FString::Printf(TEXT("Reconstruct after %d edits"), EditCount), Timeline.ReconstructAt(EditCount, Reconstructed));
+        Reconstructed.EncodeCarvedRuns(Runs);
+        TestTrue(FString::Printf(TEXT("State after %d edits"), EditCount), Runs == States[EditCount]);
+    }
+    
+    // Instant entre deux creusements : le plus récent des deux n'est pas encore appliqué
+    TestTrue(TEXT("Reconstruct between two edits"), Timeline.ReconstructAt(6.5, Reconstructed));
+    Reconstructed.EncodeCarvedRuns(Runs);
+    TestTrue(TEXT("State between two edits"), Runs == States[6]);
+    
+    TestTrue(TEXT("Reconstruct before the last 3 edits"), Timeline.ReconstructBeforeLastEdits(3, Reconstructed));
+    Reconstructed.EncodeCarvedRuns(Runs);
+    TestTrue(TEXT("State before the last 3 edits"), Runs == States[7]);
+    
+    TestFalse(TEXT("No state before the first checkpoint"), Timeline.ReconstructAt(-1.0, Reconstructed));
+    
+    // Budget nul : seul le dernier point de contrôle (après le creusement 8) est gardé
+    Timeline.SetLimits(4, 0);
+    TestEqual(TEXT("Start time after trimming"), Timeline.GetStartTime(), 8.0, 1.e-9);
+    TestEqual(TEXT("Edits after the kept checkpoint"), Timeline.GetEditCount(), 2);
+    TestFalse(TEXT("Forgotten states are not reconstructed"), Timeline.ReconstructAt(5.0, Reconstructed));
+    TestTrue(TEXT("Recent states are still reconstructed"), Timeline.ReconstructAt(9.0, Reconstructed));
+    Reconstructed.EncodeCarvedRuns(Runs);
+    TestTrue(TEXT("State after 9 edits"), Runs == States[9]);
+    
+    // Une grille de paramètres différents remet la chronologie à zéro
+    Settings.ResolutionX = 21;
+    FTerrainGrid Other;
+    Other.SetSettings(Settings);
+    Timeline.AddCheckpoint(20.0, Other);
+    TestEqual(TEXT("New settings restart the timeline"), Timeline.GetEditCount(), 0);
+    TestEqual(TEXT("New start time"), Timeline.GetStartTime(), 20.0, 1.e-9);
+    return true;
+}
+
+#endif
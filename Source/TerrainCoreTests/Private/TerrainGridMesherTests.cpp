@@ -0,0 +1,141 @@
+#include "TerrainGridMesher.h"
+#include "TerrainMeshTopology.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Grille de 4 x 3 vertices au pas de 100, profondeur 100
+static FTerrainGridSettings MakeMesherTestSettings()
+{
+    FTerrainGridSettings Settings;
+    Settings.ResolutionX = 4;
+    Settings.ResolutionY = 3;
+    Settings.Width = 300.0f;
+    Settings.Height = 200.0f;
+    Settings.Depth = 100.0f;
+    return Settings;
+}
+
+static bool AreIndicesValid(const TArray<int32>& Triangles, int32 NumVertices)
+{
+    for (int32 Index : Triangles)
+    {
+        if (Index < 0 || Index >= NumVertices)
+        {
+            return false;
+        }
+    }
+    return Triangles.Num() % 3 == 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainGridMesherShellTest, "Worms3d.TerrainCore.GridMesher.Shell",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainGridMesherShellTest::RunTest(const FString& Parameters)
+{
+    TArray<FVector> Vertices;
+    TArray<int32> Triangles;
+    FTerrainGridMesher::BuildShell(MakeMesherTestSettings(), Vertices, Triangles);
+    
+    // Deux copies de la grille ; 2 x 6 quads par face, 3 quads dessus et dessous, 2 quads par côté
+    TestEqual(TEXT("Shell vertex count"), Vertices.Num(), 2 * 12);
+    TestEqual(TEXT("Shell index count"), Triangles.Num(), 2 * 36 + 2 * 18 + 2 * 12);
+    TestTrue(TEXT("Shell indices are in range"), AreIndicesValid(Triangles, Vertices.Num()));
+    
+    TestEqual(TEXT("Front vertex (2, 1)"), Vertices[1 * 4 + 2], FVector(200.0f, 0.0f, 100.0f), 1.e-3f);
+    TestEqual(TEXT("Back vertex (2, 1)"), Vertices[12 + 1 * 4 + 2], FVector(200.0f, 100.0f, 100.0f), 1.e-3f);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainGridMesherInternalLayersTest, "Worms3d.TerrainCore.GridMesher.InternalLayers",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainGridMesherInternalLayersTest::RunTest(const FString& Parameters)
+{
+    TArray<FVector> Vertices;
+    TArray<int32> Triangles;
+    FTerrainGridMesher::BuildInternalLayers(MakeMesherTestSettings(), 3, 10.0f, Vertices, Triangles);
+    
+    TestEqual(TEXT("Layer vertex count"), Vertices.Num(), 3 * 12);
+    TestEqual(TEXT("Layer index count"), Triangles.Num(), 3 * 36);
+    TestTrue(TEXT("Layer indices are in range"), AreIndicesValid(Triangles, Vertices.Num()));
+    
+    // Couches réparties entre les parois de 10 : 10, 10 + 80 / 3, 10 + 160 / 3
+    TestEqual(TEXT("First layer depth"), Vertices[0].Y, 10.0, 1.e-3);
+    TestEqual(TEXT("Second layer depth"), Vertices[12].Y, 10.0 + 80.0 / 3.0, 1.e-3);
+    TestEqual(TEXT("Third layer depth"), Vertices[24].Y, 10.0 + 160.0 / 3.0, 1.e-3);
+    
+    FTerrainGridMesher::BuildInternalLayers(MakeMesherTestSettings(), 0, 10.0f, Vertices, Triangles);
+    TestTrue(TEXT("No layer, no geometry"), Vertices.Num() == 0 && Triangles.Num() == 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainMeshTopologyTest, "Worms3d.TerrainCore.MeshTopology",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainMeshTopologyTest::RunTest(const FString& Parameters)
+{
+    TArray<FVector> Vertices;
+    TArray<int32> Triangles;
+    FTerrainGridMesher::BuildShell(MakeMesherTestSettings(), Vertices, Triangles);
+    
+    FTerrainMeshTopology Topology;
+    Topology.Build(Triangles, Vertices.Num());
+    TestEqual(TEXT("Every triangle alive"), Topology.AliveTriangleCount, Triangles.Num() / 3);
+    TestTrue(TEXT("Valid for the source mesh"), Topology.IsValidFor(Vertices.Num(), Triangles.Num()));
+    TestFalse(TEXT("Not valid for another vertex count"), Topology.IsValidFor(Vertices.Num() - 1, Triangles.Num()));
+    
+    // Adjacence : chaque entrée d'un vertex désigne un triangle qui le contient
+    bool bAdjacencyValid = Topology.VertexTriangleOffsets.Num() == Vertices.Num() + 1 &&
+                           Topology.VertexTriangleOffsets.Last() == Triangles.Num();
+    for (int32 VertexIndex = 0; bAdjacencyValid && VertexIndex < Vertices.Num(); ++VertexIndex)
+    {
+        for (int32 Adj = Topology.VertexTriangleOffsets[VertexIndex]; Adj < Topology.VertexTriangleOffsets[VertexIndex + 1]; ++Adj)
+        {
+            const int32 TriIdx = Topology.VertexTriangles[Adj];
+            bAdjacencyValid &= Triangles[TriIdx * 3] == VertexIndex || Triangles[TriIdx * 3 + 1] == VertexIndex || Triangles[TriIdx * 3 + 2] == VertexIndex;
+        }
+    }
+    TestTrue(TEXT("Adjacency lists the triangles of each vertex"), bAdjacencyValid);
+    
+    // Vertex (1, 1) : intérieur des faces avant et arrière, normales opposées selon la profondeur
+    TArray<FVector> Normals;
+    Topology.ComputeVertexNormals(Vertices, Normals, 0, Vertices.Num());
+    TestEqual(TEXT("One normal per vertex"), Normals.Num(), Vertices.Num());
+    TestEqual(TEXT("Front normal along the depth"), FMath::Abs(Normals[5].Y), 1.0, 1.e-4);
+    TestEqual(TEXT("Back normal opposite to the front"), Normals[12 + 5], -Normals[5], 1.e-4f);
+    
+    bool bAllNormalized = true;
+    for (const FVector& Normal : Normals)
+    {
+        bAllNormalized &= Normal.IsNormalized();
+    }
+    TestTrue(TEXT("Every shell vertex has a unit normal"), bAllNormalized);
+    
+    // Triangle détruit : retiré des indices rassemblés, sans changer les indices des autres
+    Topology.AliveTriangles[0] = false;
+    Topology.AliveTriangleCount--;
+    
+    TArray<int32> Alive;
+    Topology.GatherAliveTriangles(Alive);
+    TestTrue(TEXT("Dead triangle removed"), Alive == TArray<int32>(Triangles.GetData() + 3, Triangles.Num() - 3));
+    TestTrue(TEXT("Valid for the trimmed mesh"), Topology.IsValidFor(Vertices.Num(), Alive.Num()));
+    TestTrue(TEXT("Normal from the remaining faces"), Topology.ComputeVertexNormal(Triangles[0], Vertices).IsNormalized());
+    
+    // Autre ensemble de faces vivantes (état passé) : tous les triangles, comme avant la destruction
+    const TBitArray<> AllAlive(true, Triangles.Num() / 3);
+    TestEqual(TEXT("Normal from an explicit alive set"), Topology.ComputeVertexNormal(Triangles[0], Vertices, AllAlive), Normals[Triangles[0]], 1.e-4f);
+    
+    // Tampon reçu avec un triangle de plus en moins : l'adjacence suit, un tampon étranger est refusé
+    TArray<int32> Received(Alive.GetData() + 3, Alive.Num() - 3);
+    TestTrue(TEXT("Sync with a trimmed buffer"), Topology.SyncAliveTriangles(Received, Vertices.Num()));
+    TestFalse(TEXT("Synced triangle is dead"), (bool)Topology.AliveTriangles[1]);
+    TestTrue(TEXT("Valid after sync"), Topology.IsValidFor(Vertices.Num(), Received.Num()));
+    TestFalse(TEXT("Sync refuses a buffer with revived triangles"), Topology.SyncAliveTriangles(Triangles, Vertices.Num()));
+    
+    Topology.Reset();
+    TestFalse(TEXT("Reset topology matches nothing"), Topology.IsValidFor(Vertices.Num(), Triangles.Num()));
+    return true;
+}
+
+#endif
@@ -0,0 +1,245 @@
+#include "TerrainGrid.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Grille de test : 11 x 11 vertices sur 1000 x 1000 (pas de 100), 2 x 2 sections de 500
+static FTerrainGrid MakeTestGrid()
+{
+    FTerrainGridSettings Settings;
+    Settings.ResolutionX = 11;
+    Settings.ResolutionY = 11;
+    Settings.Width = 1000.0f;
+    Settings.Height = 1000.0f;
+    Settings.Depth = 500.0f;
+    Settings.SectionSizeX = 500.0f;
+    Settings.SectionSizeY = 500.0f;
+    
+    FTerrainGrid Grid;
+    Grid.SetSettings(Settings);
+    return Grid;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainGridCarveRectTest, "Worms3d.TerrainCore.Grid.CarveRect",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainGridCarveRectTest::RunTest(const FString& Parameters)
+{
+    FTerrainGrid Grid = MakeTestGrid();
+    
+    // Vertices 3 et 4 sur chaque axe (300 et 400 dans [250, 450])
+    TArray<int32> NewlyCarved;
+    FIntPoint MinSection, MaxSection;
+    TestTrue(TEXT("Rectangle inside the grid"), Grid.CarveRect(FVector2D(250.0f, 250.0f), FVector2D(200.0f, 200.0f), &NewlyCarved, MinSection, MaxSection));
+    
+    NewlyCarved.Sort();
+    TestTrue(TEXT("Newly carved vertices"), NewlyCarved == TArray<int32>({ 3 * 11 + 3, 3 * 11 + 4, 4 * 11 + 3, 4 * 11 + 4 }));
+    TestTrue(TEXT("Vertex (3, 3) carved"), Grid.IsVertexCarved(3, 3));
+    TestFalse(TEXT("Vertex (5, 5) intact"), Grid.IsVertexCarved(5, 5));
+    
+    // Toute cellule dont un coin est détruit n'est plus pleine
+    TestFalse(TEXT("Cell (2, 2) touches a carved corner"), Grid.IsCellSolid(2, 2));
+    TestFalse(TEXT("Cell (4, 4) touches a carved corner"), Grid.IsCellSolid(4, 4));
+    TestTrue(TEXT("Cell (5, 5) is still solid"), Grid.IsCellSolid(5, 5));
+    TestFalse(TEXT("Cells outside the grid are never solid"), Grid.IsCellSolid(10, 0));
+    
+    // Sections des cellules voisines comprises (cellule (1, 1) à (5, 5))
+    TestTrue(TEXT("Min section"), MinSection == FIntPoint(0, 0));
+    TestTrue(TEXT("Max section"), MaxSection == FIntPoint(1, 1));
+    
+    // Le même rectangle ne détruit plus rien
+    NewlyCarved.Reset();
+    Grid.CarveRect(FVector2D(250.0f, 250.0f), FVector2D(200.0f, 200.0f), &NewlyCarved, MinSection, MaxSection);
+    TestEqual(TEXT("Carving twice adds nothing"), NewlyCarved.Num(), 0);
+    
+    TestFalse(TEXT("Rectangle outside the grid"), Grid.CarveRect(FVector2D(2000.0f, 2000.0f), FVector2D(100.0f, 100.0f), nullptr, MinSection, MaxSection));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainGridCarveMaskTest, "Worms3d.TerrainCore.Grid.CarveMask",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainGridCarveMaskTest::RunTest(const FString& Parameters)
+{
+    FIntPoint MinSection, MaxSection;
+    
+    FTerrainGrid Grid = MakeTestGrid();
+    Grid.CarveRect(FVector2D(-10.0f, -10.0f), FVector2D(120.0f, 120.0f), nullptr, MinSection, MaxSection);
+    
+    // Masque recouvrant en partie les dégâts existants : seuls les vertices intacts sont nouveaux
+    FTerrainGrid MaskGrid = MakeTestGrid();
+    MaskGrid.CarveRect(FVector2D(90.0f, -10.0f), FVector2D(120.0f, 20.0f), nullptr, MinSection, MaxSection);
+    
+    TArray<int32> NewlyCarved;
+    TestTrue(TEXT("Mask carves new vertices"), Grid.CarveMask(MaskGrid.GetCarvedMask(), &NewlyCarved, MinSection, MaxSection));
+    TestTrue(TEXT("Only vertex (2, 0) is new"), NewlyCarved == TArray<int32>({ 2 }));
+    TestTrue(TEXT("Union keeps the previous damage"), Grid.IsVertexCarved(0, 1) && Grid.IsVertexCarved(1, 1) && Grid.IsVertexCarved(2, 0));
+    TestTrue(TEXT("Min section"), MinSection == FIntPoint(0, 0));
+    TestTrue(TEXT("Max section"), MaxSection == FIntPoint(0, 0));
+    
+    TestFalse(TEXT("Same mask again changes nothing"), Grid.CarveMask(MaskGrid.GetCarvedMask(), nullptr, MinSection, MaxSection));
+    
+    TBitArray<> WrongSize;
+    WrongSize.Init(true, 4);
+    TestFalse(TEXT("Mask of another size is rejected"), Grid.CarveMask(WrongSize, nullptr, MinSection, MaxSection));
+    TestFalse(TEXT("Rejected mask is not applied"), Grid.IsVertexCarved(5, 5));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainGridCarvedRunsTest, "Worms3d.TerrainCore.Grid.CarvedRuns",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainGridCarvedRunsTest::RunTest(const FString& Parameters)
+{
+    FTerrainGrid Grid = MakeTestGrid();
+    
+    // Grille intacte : une seule plage de 121 vertices, un octet
+    TArray<uint8> Runs;
+    Grid.EncodeCarvedRuns(Runs);
+    TestTrue(TEXT("Intact grid encodes as one run"), Runs == TArray<uint8>({ 121 }));
+    
+    FIntPoint MinSection, MaxSection;
+    Grid.CarveRect(FVector2D(250.0f, 250.0f), FVector2D(200.0f, 200.0f), nullptr, MinSection, MaxSection);
+    Grid.CarveRect(FVector2D(850.0f, -10.0f), FVector2D(200.0f, 1100.0f), nullptr, MinSection, MaxSection);
+    Grid.EncodeCarvedRuns(Runs);
+    
+    FTerrainGrid Decoded = MakeTestGrid();
+    TestTrue(TEXT("Runs decode"), Decoded.DecodeCarvedRuns(Runs));
+    TestTrue(TEXT("Round-trip restores the mask"), Decoded.GetCarvedMask() == Grid.GetCarvedMask());
+    
+    // Plages qui ne couvrent pas exactement la grille : refusées, masque inchangé
+    TArray<uint8> Truncated = Runs;
+    Truncated.Pop();
+    TestFalse(TEXT("Truncated runs are rejected"), Decoded.DecodeCarvedRuns(Truncated));
+    TestTrue(TEXT("Rejected runs leave the mask unchanged"), Decoded.GetCarvedMask() == Grid.GetCarvedMask());
+    
+    TArray<uint8> TooLong = Runs;
+    TooLong.Add(1);
+    TestFalse(TEXT("Runs past the grid are rejected"), Decoded.DecodeCarvedRuns(TooLong));
+    
+    // Plage de plus de 127 vertices : varint sur deux octets
+    FTerrainGridSettings LargeSettings = Grid.GetSettings();
+    LargeSettings.ResolutionX = 21;
+    LargeSettings.ResolutionY = 21;
+    FTerrainGrid Large;
+    Large.SetSettings(LargeSettings);
+    Large.EncodeCarvedRuns(Runs);
+    TestTrue(TEXT("441 intact vertices encode on two bytes"), Runs == TArray<uint8>({ (uint8)((441 & 0x7F) | 0x80), (uint8)(441 >> 7) }));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainGridSectionsTest, "Worms3d.TerrainCore.Grid.Sections",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainGridSectionsTest::RunTest(const FString& Parameters)
+{
+    FTerrainGrid Grid = MakeTestGrid();
+    
+    TestTrue(TEXT("Section count"), Grid.GetSectionCount() == FIntPoint(2, 2));
+    TestTrue(TEXT("Cell (4, 4) in the first section"), Grid.GetSectionForCell(4, 4) == FIntPoint(0, 0));
+    TestTrue(TEXT("Cell (5, 4) in the next section along X"), Grid.GetSectionForCell(5, 4) == FIntPoint(1, 0));
+    
+    FIntPoint Min, Max;
+    Grid.GetSectionCellRange(FIntPoint(1, 0), Min, Max);
+    TestTrue(TEXT("Section (1, 0) starts at cell (5, 0)"), Min == FIntPoint(5, 0));
+    TestTrue(TEXT("Section (1, 0) ends at cell (10, 5)"), Max == FIntPoint(10, 5));
+    
+    // Sans sections, toute la grille est la section (0, 0)
+    FTerrainGridSettings Settings = Grid.GetSettings();
+    Settings.bUseSections = false;
+    Grid.SetSettings(Settings);
+    TestTrue(TEXT("Single section"), Grid.GetSectionCount() == FIntPoint(1, 1));
+    Grid.GetSectionCellRange(FIntPoint(0, 0), Min, Max);
+    TestTrue(TEXT("Single section covers every cell"), Min == FIntPoint(0, 0) && Max == FIntPoint(10, 10));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainGridRaycastTest, "Worms3d.TerrainCore.Grid.Raycast",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainGridRaycastTest::RunTest(const FString& Parameters)
+{
+    FTerrainGrid Grid = MakeTestGrid();
+    FTerrainGridHit Hit;
+    
+    // Tir horizontal depuis la gauche : impact sur la face X = 0
+    TestTrue(TEXT("Horizontal ray hits"), Grid.Raycast(FVector(-100.0f, 250.0f, 550.0f), FVector(1100.0f, 250.0f, 550.0f), Hit));
+    TestEqual(TEXT("Horizontal hit time"), Hit.Time, 100.0f / 1200.0f, 1.e-4f);
+    TestEqual(TEXT("Horizontal hit normal"), Hit.Normal, FVector(-1.0f, 0.0f, 0.0f), 1.e-4f);
+    TestTrue(TEXT("Horizontal hit cell"), Hit.Cell == FIntPoint(0, 5));
+    
+    // Tir vertical : le dessus du terrain, puis le fond d'un puits creusé sous la trajectoire
+    const FVector Start(550.0f, 250.0f, 1500.0f);
+    const FVector End(550.0f, 250.0f, -500.0f);
+    TestTrue(TEXT("Vertical ray hits the top"), Grid.Raycast(Start, End, Hit));
+    TestEqual(TEXT("Top hit height"), Hit.Location.Z, 1000.0, 1.e-2);
+    TestEqual(TEXT("Top hit normal"), Hit.Normal, FVector(0.0f, 0.0f, 1.0f), 1.e-4f);
+    
+    FIntPoint MinSection, MaxSection;
+    Grid.CarveRect(FVector2D(450.0f, 550.0f), FVector2D(200.0f, 500.0f), nullptr, MinSection, MaxSection);
+    TestTrue(TEXT("Vertical ray hits the pit floor"), Grid.Raycast(Start, End, Hit));
+    TestEqual(TEXT("Pit floor height"), Hit.Location.Z, 500.0, 1.e-2);
+    TestEqual(TEXT("Pit floor time"), Hit.Time, 0.5f, 1.e-4f);
+    TestTrue(TEXT("Pit floor cell"), Hit.Cell == FIntPoint(5, 4));
+    
+    TestFalse(TEXT("Ray behind the terrain depth misses"), Grid.Raycast(FVector(-100.0f, 2000.0f, 550.0f), FVector(1100.0f, 2000.0f, 550.0f), Hit));
+    TestFalse(TEXT("Ray above the terrain misses"), Grid.Raycast(FVector(-100.0f, 250.0f, 1500.0f), FVector(1100.0f, 250.0f, 1500.0f), Hit));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainGridSweepSphereTest, "Worms3d.TerrainCore.Grid.SweepSphere",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainGridSweepSphereTest::RunTest(const FString& Parameters)
+{
+    FTerrainGrid Grid = MakeTestGrid();
+    FTerrainGridHit Hit;
+    
+    // Sphère de rayon 50 qui descend : contact quand son centre est à 1050
+    TestTrue(TEXT("Falling sphere hits"), Grid.SweepSphere(FVector(550.0f, 250.0f, 1500.0f), FVector(550.0f, 250.0f, -500.0f), 50.0f, Hit));
+    TestEqual(TEXT("Contact time"), Hit.Time, 450.0f / 2000.0f, 1.e-3f);
+    TestEqual(TEXT("Contact point"), Hit.Location, FVector(550.0f, 250.0f, 1000.0f), 1.0f);
+    TestEqual(TEXT("Contact normal"), Hit.Normal, FVector(0.0f, 0.0f, 1.0f), 1.e-2f);
+    
+    TestFalse(TEXT("Sphere passing above misses"), Grid.SweepSphere(FVector(-200.0f, 250.0f, 1100.0f), FVector(1200.0f, 250.0f, 1100.0f), 50.0f, Hit));
+    
+    // Rayon nul : même résultat qu'un Raycast
+    TestTrue(TEXT("Zero radius falls back to a raycast"), Grid.SweepSphere(FVector(550.0f, 250.0f, 1500.0f), FVector(550.0f, 250.0f, -500.0f), 0.0f, Hit));
+    TestEqual(TEXT("Zero radius contact height"), Hit.Location.Z, 1000.0, 1.e-2);
+    
+    FVector Closest;
+    FIntPoint Cell;
+    TestTrue(TEXT("Overlapping sphere"), Grid.OverlapSphere(FVector(550.0f, 250.0f, 1040.0f), 50.0f, &Closest, &Cell));
+    TestTrue(TEXT("Overlap cell"), Cell == FIntPoint(5, 9));
+    TestFalse(TEXT("Sphere clear of the terrain"), Grid.OverlapSphere(FVector(550.0f, 250.0f, 1060.0f), 50.0f));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainGridSolidFractionTest, "Worms3d.TerrainCore.Grid.SolidFraction",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainGridSolidFractionTest::RunTest(const FString& Parameters)
+{
+    FTerrainGrid Grid = MakeTestGrid();
+    
+    // Segment de 2000 dont 1000 dans le terrain
+    const FVector Start(-500.0f, 250.0f, 550.0f);
+    const FVector End(1500.0f, 250.0f, 550.0f);
+    TestEqual(TEXT("Half of the segment in the terrain"), Grid.GetSolidFraction(Start, End), 0.5f, 1.e-3f);
+    TestEqual(TEXT("Start of the segment ignored"), Grid.GetSolidFraction(Start, End, 0.5f), 0.25f, 1.e-3f);
+    TestEqual(TEXT("Clear line above the terrain"), Grid.GetSolidFraction(FVector(-500.0f, 250.0f, 1500.0f), FVector(1500.0f, 250.0f, 1500.0f)), 0.0f, 1.e-6f);
+    
+    // Un tunnel de 200 sur le trajet retire 10 % du segment
+    FIntPoint MinSection, MaxSection;
+    Grid.CarveRect(FVector2D(350.0f, 450.0f), FVector2D(100.0f, 200.0f), nullptr, MinSection, MaxSection);
+    TestEqual(TEXT("Tunnel removes its cells"), Grid.GetSolidFraction(Start, End), 0.4f, 1.e-3f);
+    
+    TArray<FIntPoint> Standable;
+    Grid.GetStandableSurfaceCells(100.0f, Standable);
+    TestTrue(TEXT("Top row is standable"), Standable.Contains(FIntPoint(0, 9)));
+    TestTrue(TEXT("Tunnel floor is standable"), Standable.Contains(FIntPoint(3, 3)));
+    TestFalse(TEXT("Buried cells are not standable"), Standable.Contains(FIntPoint(0, 5)));
+    return true;
+}
+
+#endif
@@ -0,0 +1,119 @@
+#include "TerrainVoxelVolume.h"
+#include "TerrainVoxelMesher.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Volume de 4 x 4 x 6 chunks de 8 échantillons au pas de 10, sol plat à Z = 155 (entre les échantillons 15 et 16)
+static void MakeTestVolume(FTerrainVoxelVolume& Volume)
+{
+    FTerrainVoxelSettings Settings;
+    Settings.VoxelSize = 10.0f;
+    Settings.ChunkSize = 8;
+    Settings.ChunkCount = FIntVector(4, 4, 6);
+    
+    Volume.Initialize(Settings);
+    Volume.Fill([](const FVector& Position) { return 155.0f - (float)Position.Z; });
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainVoxelVolumeTest, "Worms3d.TerrainCore.Voxel.Volume",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainVoxelVolumeTest::RunTest(const FString& Parameters)
+{
+    FTerrainVoxelVolume Volume;
+    MakeTestVolume(Volume);
+    
+    // Saturation à 4 voxels : couche Z = 0 uniformément pleine, couches 1 et 2 denses, au-dessus vide
+    TestEqual(TEXT("Only the chunks near the surface are dense"), Volume.GetDenseChunkCount(), 2 * 16);
+    TestTrue(TEXT("Point below the ground is solid"), Volume.IsPointSolid(FVector(100.0f, 100.0f, 50.0f)));
+    TestFalse(TEXT("Point above the ground is empty"), Volume.IsPointSolid(FVector(100.0f, 100.0f, 250.0f)));
+    TestEqual(TEXT("Sample outside the volume is empty"), (int32)Volume.GetSample(FIntVector(-1, 0, 0)), (int32)FTerrainVoxelVolume::EmptyValue);
+    
+    TestTrue(TEXT("Solid chunk under the surface layer"), Volume.MayContainSurface(FIntVector(1, 1, 0)));
+    TestTrue(TEXT("Dense chunk"), Volume.MayContainSurface(FIntVector(1, 1, 1)));
+    TestFalse(TEXT("Empty chunk surrounded by empty chunks"), Volume.MayContainSurface(FIntVector(1, 1, 4)));
+    
+    // Copie paddée : l'échantillon paddé (1, 1, 1) est le premier du chunk
+    TArray<int8> Padded;
+    Volume.CopyPaddedChunk(FIntVector(1, 1, 1), Padded);
+    TestEqual(TEXT("Padded chunk size"), Padded.Num(), 10 * 10 * 10);
+    TestEqual(TEXT("First sample of the chunk"), (int32)Padded[(1 * 10 + 1) * 10 + 1], (int32)Volume.GetSample(FIntVector(8, 8, 8)));
+    TestEqual(TEXT("Border sample from the next chunk"), (int32)Padded[(9 * 10 + 9) * 10 + 9], (int32)Volume.GetSample(FIntVector(16, 16, 16)));
+    
+    // Cratère dans la partie uniformément pleine : le chunk devient dense, ses voisins de bordure sont signalés
+    TArray<FIntVector> TouchedChunks;
+    TestTrue(TEXT("Crater carves the volume"), Volume.CarveSphere(FVector(160.0f, 160.0f, 40.0f), 30.0f, TouchedChunks));
+    TestFalse(TEXT("Crater center is empty"), Volume.IsPointSolid(FVector(160.0f, 160.0f, 40.0f)));
+    TestTrue(TEXT("Ground away from the crater is intact"), Volume.IsPointSolid(FVector(20.0f, 20.0f, 40.0f)));
+    TestTrue(TEXT("Crater chunk reported"), TouchedChunks.Contains(FIntVector(2, 2, 0)));
+    TestTrue(TEXT("Lower neighbour reading the crater border reported"), TouchedChunks.Contains(FIntVector(1, 1, 0)));
+    TestFalse(TEXT("Far chunk not reported"), TouchedChunks.Contains(FIntVector(0, 0, 0)));
+    TestTrue(TEXT("Crater chunk is now dense"), Volume.GetDenseChunkCount() > 2 * 16);
+    
+    TouchedChunks.Reset();
+    TestFalse(TEXT("Same crater again changes nothing"), Volume.CarveSphere(FVector(160.0f, 160.0f, 40.0f), 30.0f, TouchedChunks));
+    TestFalse(TEXT("Crater outside the volume changes nothing"), Volume.CarveSphere(FVector(-1000.0f, 0.0f, 0.0f), 30.0f, TouchedChunks));
+    TestEqual(TEXT("No chunk reported without change"), TouchedChunks.Num(), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerrainVoxelMesherTest, "Worms3d.TerrainCore.Voxel.Mesher",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTerrainVoxelMesherTest::RunTest(const FString& Parameters)
+{
+    FTerrainVoxelVolume Volume;
+    MakeTestVolume(Volume);
+    const FTerrainVoxelSettings& Settings = Volume.GetSettings();
+    
+    auto BuildChunk = [&Volume, &Settings](const FIntVector& ChunkCoord, FTerrainVoxelChunkMesh& OutMesh)
+    {
+        TArray<int8> Padded;
+        Volume.CopyPaddedChunk(ChunkCoord, Padded);
+        FTerrainVoxelMesher::BuildChunkMesh(Padded, Settings.ChunkSize, FVector(ChunkCoord * Settings.ChunkSize) * Settings.VoxelSize,
+            Settings.VoxelSize, OutMesh);
+    };
+    
+    // Le sol traverse le chunk (1, 1, 1) : un quad par colonne d'échantillons
+    FTerrainVoxelChunkMesh Mesh;
+    BuildChunk(FIntVector(1, 1, 1), Mesh);
+    TestEqual(TEXT("One quad per sample column"), Mesh.Triangles.Num(), 8 * 8 * 6);
+    TestEqual(TEXT("One normal per vertex"), Mesh.Normals.Num(), Mesh.Vertices.Num());
+    
+    bool bIndicesValid = true;
+    for (int32 Index : Mesh.Triangles)
+    {
+        bIndicesValid &= Mesh.Vertices.IsValidIndex(Index);
+    }
+    TestTrue(TEXT("Indices are in range"), bIndicesValid);
+    
+    bool bOnSurface = true;
+    bool bFacingUp = true;
+    for (int32 i = 0; i < Mesh.Vertices.Num(); ++i)
+    {
+        bOnSurface &= FMath::IsNearlyEqual(Mesh.Vertices[i].Z, 155.0, 1.e-3);
+        bFacingUp &= Mesh.Normals[i].Z > 0.99;
+    }
+    TestTrue(TEXT("Vertices lie on the ground plane"), bOnSurface);
+    TestTrue(TEXT("Normals point out of the ground"), bFacingUp);
+    
+    // Face avant vers le vide : la normale géométrique du premier triangle monte
+    if (Mesh.Triangles.Num() >= 3)
+    {
+        const FVector& V0 = Mesh.Vertices[Mesh.Triangles[0]];
+        const FVector& V1 = Mesh.Vertices[Mesh.Triangles[1]];
+        const FVector& V2 = Mesh.Vertices[Mesh.Triangles[2]];
+        TestTrue(TEXT("Triangles wind consistently with the normals"), FVector::DotProduct(FVector::CrossProduct(V1 - V0, V2 - V0), FVector::UpVector) > 0.0);
+    }
+    
+    // L'arête qui traverse la frontière appartient au chunk du dessous : pas de double surface au-dessus
+    BuildChunk(FIntVector(1, 1, 2), Mesh);
+    TestTrue(TEXT("Chunk above the surface edge is empty"), Mesh.IsEmpty());
+    
+    BuildChunk(FIntVector(1, 1, 4), Mesh);
+    TestTrue(TEXT("Empty chunk builds no mesh"), Mesh.IsEmpty());
+    return true;
+}
+
+#endif
@@ -0,0 +1,14 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+using UnrealBuildTool;
+
+public class TerrainCoreTests : ModuleRules
+{
+	public TerrainCoreTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Tests d'automatisation de TerrainCore : aucune dépendance au moteur, au monde ni aux UObject
+		PrivateDependencyModuleNames.AddRange(new string[] { "Core", "TerrainCore" });
+	}
+}
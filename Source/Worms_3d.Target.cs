@@ -10,6 +10,6 @@ public class Worms_3dTarget : TargetRules
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 
-		ExtraModuleNames.AddRange( new string[] { "Worms_3d" } );
+		ExtraModuleNames.AddRange( new string[] { "Worms_3d", "TerrainCore" } );
 	}
 }
@@ -4,6 +4,8 @@
 #include "Kismet/GameplayStatics.h"
 #include "AWormCharacter.h"
 #include "Net/UnrealNetwork.h"
+#include "DestructibleTerrainSubsystem.h"
+#include "VoxelTerrain.h"
 
 AWormProjectile::AWormProjectile()
 {
@@ -54,6 +56,8 @@ AWormProjectile::AWormProjectile()
     // Configurer l'explosion
     ExplosionRadius = 200.0f;
     ExplosionDamage = 25.0f;
+    OcclusionStopDepth = 60.0f;
+    MinOccludedDamageFactor = 0.0f;
     DetonationDelay = 3.0f;
     
     // Définir la durée de vie automatique
@@ -290,47 +294,76 @@ void AWormProjectile::Explode()
             OverlappingActors
         );
         
-        // Appliquer les dégâts aux personnages touchés
+        TArray<AWormCharacter*> Worms;
+        TArray<FVector> WormLocations;
         for (AActor* Actor : OverlappingActors)
         {
-            AWormCharacter* WormChar = Cast<AWormCharacter>(Actor);
-            if (WormChar)
+            if (AWormCharacter* WormChar = Cast<AWormCharacter>(Actor))
             {
-                // Calculer la direction de l'impact
-                FVector ImpactDirection = WormChar->GetActorLocation() - ExplosionLocation;
-                float Distance = ImpactDirection.Size();
-                
-                // Calculer les dégâts basés sur la distance
-                float DamageToApply = ExplosionDamage * (1.0f - FMath::Min(Distance / ExplosionRadius, 1.0f));
-                
-                // Appliquer les dégâts
-                WormChar->ApplyDamageToWorm(DamageToApply, ImpactDirection);
+                Worms.Add(WormChar);
+                WormLocations.Add(WormChar->GetActorLocation());
             }
         }
         
-        // Détruire le terrain dans la zone d'explosion
-        TArray<AActor*> TerrainActors;
-        UGameplayStatics::GetAllActorsOfClass(GetWorld(), ADestructibleTerrain::StaticClass(), TerrainActors);
+        // Terrain entre l'explosion et chaque ver, en une requête sur les grilles (avant que le cratère ne soit creusé)
+        // Le terrain au point d'impact est ignoré : le projectile explose au contact de la surface
+        TArray<float> OccludedDepths;
+        UDestructibleTerrainSubsystem* TerrainSubsystem = GetWorld()->GetSubsystem<UDestructibleTerrainSubsystem>();
+        if (TerrainSubsystem && OcclusionStopDepth > 0.0f)
+        {
+            const float ImpactClearance = CollisionComp->GetScaledSphereRadius() * 4.0f;
+            TerrainSubsystem->GetTerrainOcclusion(ExplosionLocation, WormLocations, ImpactClearance, OccludedDepths);
+        }
         
-        for (AActor* Actor : TerrainActors)
+        // Appliquer les dégâts aux personnages touchés
+        for (int32 i = 0; i < Worms.Num(); ++i)
         {
-            ADestructibleTerrain* Terrain = Cast<ADestructibleTerrain>(Actor);
-            if (Terrain)
+            // Calculer la direction de l'impact
+            FVector ImpactDirection = WormLocations[i] - ExplosionLocation;
+            float Distance = ImpactDirection.Size();
+            
+            // Calculer les dégâts basés sur la distance, atténués par le terrain traversé (l'impulsion en découle)
+            float DamageToApply = ExplosionDamage * (1.0f - FMath::Min(Distance / ExplosionRadius, 1.0f));
+            if (OccludedDepths.IsValidIndex(i))
             {
-                // Transformation pour convertir les coordonnées mondiales en coordonnées locales
-                FVector LocalExplosion = Terrain->GetActorTransform().InverseTransformPosition(ExplosionLocation);
-                
-                // Utiliser les coordonnées appropriées pour le terrain 2D
-                float SafeX = FMath::Clamp(LocalExplosion.X, ExplosionRadius, Terrain->TerrainWidth - ExplosionRadius);
-                float SafeZ = FMath::Clamp(LocalExplosion.Z, ExplosionRadius, Terrain->TerrainHeight - ExplosionRadius);
-                
-                // Créer la zone de destruction centrée sur l'explosion
-                FVector2D Position2D(SafeX - ExplosionRadius, SafeZ - ExplosionRadius);
-                FVector2D Size2D(ExplosionRadius * 2.0f, ExplosionRadius * 2.0f);
-                
-                // Demander la destruction du terrain
-                Terrain->RequestDestroyTerrainAt(Position2D, Size2D);
+                DamageToApply *= FMath::Max(1.0f - OccludedDepths[i] / OcclusionStopDepth, MinOccludedDamageFactor);
             }
+            
+            // Appliquer les dégâts
+            Worms[i]->ApplyDamageToWorm(DamageToApply, ImpactDirection);
+        }
+        
+        // Détruire le terrain dans la zone d'explosion : seuls les terrains recouverts par le souffle sont touchés
+        TArray<ADestructibleTerrain*> TerrainActors;
+        if (TerrainSubsystem)
+        {
+            TerrainSubsystem->FindTerrainsInSphere(ExplosionLocation, ExplosionRadius, TerrainActors);
+        }
+        
+        for (ADestructibleTerrain* Terrain : TerrainActors)
+        {
+            // Transformation pour convertir les coordonnées mondiales en coordonnées locales
+            FVector LocalExplosion = Terrain->GetActorTransform().InverseTransformPosition(ExplosionLocation);
+            
+            // Zone de destruction centrée sur l'explosion, sans la ramener dans les bornes :
+            // un souffle à cheval sur deux terrains voisins entame chacun d'eux du bon côté
+            FVector2D Position2D(LocalExplosion.X - ExplosionRadius, LocalExplosion.Z - ExplosionRadius);
+            FVector2D Size2D(ExplosionRadius * 2.0f, ExplosionRadius * 2.0f);
+            
+            // Demander la destruction du terrain
+            Terrain->RequestDestroyTerrainAt(Position2D, Size2D);
+        }
+        
+        // Terrains voxel : cratère sphérique, seuls les chunks touchés sont remaillés
+        TArray<AVoxelTerrain*> VoxelTerrains;
+        if (TerrainSubsystem)
+        {
+            TerrainSubsystem->FindVoxelTerrainsInSphere(ExplosionLocation, ExplosionRadius, VoxelTerrains);
+        }
+        
+        for (AVoxelTerrain* VoxelTerrain : VoxelTerrains)
+        {
+            VoxelTerrain->CarveCrater(ExplosionLocation, ExplosionRadius);
         }
         
         // Effets multicast d'explosion
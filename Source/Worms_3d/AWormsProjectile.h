@@ -43,6 +43,14 @@ protected:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile")
     float ExplosionDamage;
     
+    // Épaisseur de terrain qui arrête complètement le souffle (dégâts et impulsion) ; 0 = aucune atténuation
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile", meta = (ClampMin = "0.0"))
+    float OcclusionStopDepth;
+    
+    // Part minimale des dégâts conservée derrière le terrain
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float MinOccludedDamageFactor;
+    
     // Délai avant explosion auto
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile")
     float DetonationDelay;
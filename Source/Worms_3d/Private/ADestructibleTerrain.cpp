@@ -1,12 +1,28 @@
 #include "ADestructibleTerrain.h"
+#include "TerrainGridMesher.h"
 #include "MaterialDomain.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 #include "Kismet/GameplayStatics.h"
+#include "TerrainLODSubsystem.h"
+#include "DestructibleTerrainSubsystem.h"
+#include "TerrainNavGeometryComponent.h"
+#include "TerrainMinimapComponent.h"
+#include "TerrainSurfacePropsComponent.h"
+#include "TerrainStats.h"
+#include "TerrainSnapshot.h"
+#include "NavigationSystem.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "GameFramework/GameStateBase.h"
+#include "DrawDebugHelpers.h"
 
 ADestructibleTerrain::ADestructibleTerrain()
 {
-    PrimaryActorTick.bCanEverTick = true; // Modifié à true pour supporter le LOD
+    // Aucun tick : le LOD est piloté par UTerrainLODSubsystem quand un point de vue se déplace
+    PrimaryActorTick.bCanEverTick = false;
     
     // Création du mesh procédural
     TerrainMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("TerrainMesh"));
@@ -25,6 +41,27 @@ ADestructibleTerrain::ADestructibleTerrain()
     TerrainMesh->SetCollisionProfileName(TEXT("BlockAll"));
     TerrainMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
     
+    // Le mesh procédural n'alimente plus la navmesh : chaque reconstruction salirait tout le terrain
+    TerrainMesh->SetCanEverAffectNavigation(false);
+    
+    // Géométrie de navigation, invalidée section par section
+    NavGeometry = CreateDefaultSubobject<UTerrainNavGeometryComponent>(TEXT("NavGeometry"));
+    NavGeometry->SetupAttachment(TerrainMesh);
+    
+    // Minimap CPU, mise à jour sur le seul rectangle touché par chaque modification
+    Minimap = CreateDefaultSubobject<UTerrainMinimapComponent>(TEXT("Minimap"));
+    
+    // Props de surface : un HISM par type, instances indexées par section
+    SurfaceProps = CreateDefaultSubobject<UTerrainSurfacePropsComponent>(TEXT("SurfaceProps"));
+    SurfaceProps->SetupAttachment(TerrainMesh);
+    
+    // Mesh de LOD local : une section de rendu par section de terrain, sans collision
+    TerrainLODMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("TerrainLODMesh"));
+    TerrainLODMesh->SetupAttachment(TerrainMesh);
+    TerrainLODMesh->SetIsReplicated(false);
+    TerrainLODMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    TerrainLODMesh->bUseComplexAsSimpleCollision = false;
+    
     // Valeurs par défaut
     TerrainWidth = 2000.0f;
     TerrainHeight = 2000.0f;
@@ -33,6 +70,7 @@ ADestructibleTerrain::ADestructibleTerrain()
     VerticalResolution = 15; // 15 subdivisions en hauteur
     bIsInitialized = false;
     bModificationsApplied = false;
+    bCollisionActive = true;
     
     // Augmenter la fréquence de mise à jour réseau
     NetUpdateFrequency = 10.0f;
@@ -61,9 +99,26 @@ ADestructibleTerrain::ADestructibleTerrain()
     // Initialisation du système de LOD
     bUseLOD = true;
     LODDistanceThreshold = 3000.0f;
-    LODHorizontalResolution = 8;
-    LODVerticalResolution = 8;
-    bIsUsingLOD = false;
+    LODLevelCount = 3;
+    LODHysteresis = 0.1f;
+    LODSkirtDepth = 25.0f;
+    
+    // Navigation de surface (dimensions d'un ver)
+    NavAgentHeight = 200.0f;
+    NavDirtySectionsPerFrame = 4;
+    NavMaxJumpDistance = 300.0f;
+    NavMaxJumpHeight = 150.0f;
+    
+    // Journal des modifications répliqué : repli des plus anciennes au-delà de 64
+    MaxLoggedModifications = 64;
+    ModificationTailLength = 16;
+    
+    // Chronologie pour les ralentis : un point de contrôle toutes les 16 modifications, 256 Kio au plus
+    TimelineCheckpointInterval = 16;
+    TimelineMemoryBudgetKB = 256;
+    
+    // Collision complexe par défaut (les primitives simples sont optionnelles)
+    CollisionMode = ETerrainCollisionMode::ComplexMesh;
 }
 
 void ADestructibleTerrain::BeginPlay()
@@ -73,38 +128,59 @@ void ADestructibleTerrain::BeginPlay()
     // Configurer les matériaux
     SetupMaterials();
     
+    Timeline.SetLimits(TimelineCheckpointInterval, (int64)TimelineMemoryBudgetKB * 1024);
+    
+    // Rendre le terrain trouvable par les requêtes spatiales (explosions, etc.)
+    if (UDestructibleTerrainSubsystem* TerrainSubsystem = GetWorld()->GetSubsystem<UDestructibleTerrainSubsystem>())
+    {
+        TerrainSubsystem->RegisterTerrain(this);
+    }
+    
+    // Le LOD n'a de sens que là où le terrain est affiché
+    if (GetNetMode() != NM_DedicatedServer)
+    {
+        if (UTerrainLODSubsystem* LODSubsystem = GetWorld()->GetSubsystem<UTerrainLODSubsystem>())
+        {
+            LODSubsystem->RegisterTerrain(this);
+        }
+    }
+    
     // Générer le terrain initial après un court délai
     if (HasAuthority())
     {
         // Retarder légèrement la génération du terrain pour s'assurer que tous les systèmes sont prêts
         FTimerHandle TimerHandle;
+        // Lambda liée à l'acteur : un terrain détruit avant l'échéance (benchmark, chunk déchargé) n'est pas touché
         GetWorld()->GetTimerManager().SetTimer(
             TimerHandle, 
-            [this]() { 
+            FTimerDelegate::CreateWeakLambda(this, [this]() { 
                 if (!bIsInitialized) {
                     UE_LOG(LogTemp, Warning, TEXT("Initializing terrain in BeginPlay with delayed timer"));
                     InitializeTerrain(TerrainWidth, TerrainHeight, TerrainDepth);
                 }
-            }, 
+            }), 
             0.5f, 
             false
         );
     }
 }
 
-void ADestructibleTerrain::Tick(float DeltaTime)
+void ADestructibleTerrain::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    Super::Tick(DeltaTime);
-    
-    // Mettre à jour le système de LOD (à intervalle réduit pour optimiser)
-    static float LODUpdateTimer = 0.0f;
-    LODUpdateTimer += DeltaTime;
-    
-    if (LODUpdateTimer >= 1.0f) // Vérifier une fois par seconde
+    if (UWorld* World = GetWorld())
     {
-        UpdateLOD();
-        LODUpdateTimer = 0.0f;
+        if (UTerrainLODSubsystem* LODSubsystem = World->GetSubsystem<UTerrainLODSubsystem>())
+        {
+            LODSubsystem->UnregisterTerrain(this);
+        }
+        
+        if (UDestructibleTerrainSubsystem* TerrainSubsystem = World->GetSubsystem<UDestructibleTerrainSubsystem>())
+        {
+            TerrainSubsystem->UnregisterTerrain(this);
+        }
     }
+    
+    Super::EndPlay(EndPlayReason);
 }
 
 void ADestructibleTerrain::OnConstruction(const FTransform& Transform)
@@ -127,6 +203,9 @@ void ADestructibleTerrain::PostInitializeComponents()
     {
         TerrainMesh->SetMaterial(0, TerrainMaterial);
     }
+    
+    // Grille aux dimensions par défaut : les requêtes restent valides avant l'initialisation
+    Grid.SetSettings(MakeGridSettings());
 }
 
 void ADestructibleTerrain::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -135,12 +214,17 @@ void ADestructibleTerrain::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
     
     // Répliquer les propriétés importantes
     DOREPLIFETIME(ADestructibleTerrain, TerrainModifications);
+    DOREPLIFETIME(ADestructibleTerrain, ReplicatedCoverage);
     DOREPLIFETIME(ADestructibleTerrain, TerrainWidth);
     DOREPLIFETIME(ADestructibleTerrain, TerrainHeight);
     DOREPLIFETIME(ADestructibleTerrain, TerrainDepth);
     DOREPLIFETIME(ADestructibleTerrain, bIsInitialized);
+    DOREPLIFETIME(ADestructibleTerrain, TerrainGeneration);
     DOREPLIFETIME(ADestructibleTerrain, bModificationsApplied);
-    DOREPLIFETIME(ADestructibleTerrain, MeshData);
+    DOREPLIFETIME(ADestructibleTerrain, bCollisionActive);
+    DOREPLIFETIME(ADestructibleTerrain, CollisionMode);
+    DOREPLIFETIME(ADestructibleTerrain, bGenerateInternalStructure);
+    DOREPLIFETIME_CONDITION(ADestructibleTerrain, JoinSnapshot, COND_InitialOnly);
 }
 
 void ADestructibleTerrain::InitializeTerrain(float Width, float Height, float Depth)
@@ -160,19 +244,228 @@ void ADestructibleTerrain::InitializeTerrain(float Width, float Height, float De
     // Marquer comme initialisé
     bIsInitialized = true;
     
+    // Les bornes dépendent des dimensions qui viennent d'être fixées
+    UpdateTerrainRegistration();
+    
     // Initialiser les sections si activées
     if (bUseTerrainSections)
     {
         InitializeSections();
     }
     
-    // Générer le terrain
+    // Générer le terrain ; les clients connectés le régénèrent de leur côté
+    TerrainGeneration++;
     GenerateTerrain();
     
+    // Rejouer les modifications restaurées avant l'initialisation (chunk rechargé)
+    if (TerrainModifications.Num() > 0 || bCoveragePending)
+    {
+        ApplyTerrainModifications();
+    }
+    
+    // Les clients qui rejoindront la partie reconstruiront le terrain à partir de cet instantané
+    RefreshJoinSnapshot();
+    
     // Informer tous les clients
     Multicast_NotifyInitialized(Width, Height, Depth);
 }
 
+void ADestructibleTerrain::RestoreModifications(const TArray<FTerrainModification>& Modifications)
+{
+    if (!HasAuthority())
+    {
+        return;
+    }
+    
+    LLM_SCOPE_BYTAG(Terrain_Modifications);
+    
+    TerrainModifications = Modifications;
+    AppliedModifications.Reset();
+    
+    if (bIsInitialized)
+    {
+        ApplyTerrainModifications();
+    }
+}
+
+bool ADestructibleTerrain::SaveSnapshot(TArray<uint8>& OutBytes) const
+{
+    FTerrainSnapshot Snapshot;
+    Snapshot.GridSettings = MakeGridSettings();
+    Snapshot.Modifications = TerrainModifications;
+    Snapshot.CoverageRuns = CompactedCoverage.Runs;
+    Snapshot.FoldedCount = CompactedCoverage.FoldedCount;
+    return Snapshot.Save(OutBytes);
+}
+
+bool ADestructibleTerrain::LoadSnapshot(const TArray<uint8>& Bytes)
+{
+    if (!HasAuthority())
+    {
+        return false;
+    }
+    
+    FTerrainSnapshot Snapshot;
+    if (!Snapshot.Load(Bytes))
+    {
+        return false;
+    }
+    
+    ApplySnapshot(Snapshot);
+    
+    // Avant l'initialisation, les modifications seront rejouées par InitializeTerrain()
+    if (bIsInitialized)
+    {
+        InitializeTerrain(TerrainWidth, TerrainHeight, TerrainDepth);
+    }
+    return true;
+}
+
+void ADestructibleTerrain::ApplySnapshot(const FTerrainSnapshot& Snapshot)
+{
+    const FTerrainGridSettings& Settings = Snapshot.GridSettings;
+    TerrainWidth = Settings.Width;
+    TerrainHeight = Settings.Height;
+    TerrainDepth = Settings.Depth;
+    HorizontalResolution = Settings.ResolutionX;
+    VerticalResolution = Settings.ResolutionY;
+    bUseTerrainSections = Settings.bUseSections;
+    SectionSizeX = Settings.SectionSizeX;
+    SectionSizeY = Settings.SectionSizeY;
+    
+    LLM_SCOPE_BYTAG(Terrain_Modifications);
+    TerrainModifications = Snapshot.Modifications;
+    AppliedModifications.Reset();
+    
+    CompactedCoverage.Runs = Snapshot.CoverageRuns;
+    CompactedCoverage.FoldedCount = Snapshot.FoldedCount;
+    DecodeCoverage(CompactedCoverage);
+    bCoveragePending = CompactedCoverage.FoldedCount > 0;
+    
+    // Couverture restaurée sur le serveur (chunk rechargé) : les clients connectés la reçoivent aussi
+    if (HasAuthority())
+    {
+        TArray<uint8> CoverageBytes;
+        WriteCoverageBytes(CompactedCoverage, CoverageBytes);
+        if (!ReplicatedCoverage.SetBytes(CoverageBytes))
+        {
+            UE_LOG(LogTemp, Error, TEXT("%s: restored coverage too large to replicate (%d bytes, max %d)"),
+                *GetName(), CoverageBytes.Num(), FTerrainReplicatedBytes::MaxBytes);
+            ReplicatedCoverage.Reset();
+        }
+    }
+}
+
+void ADestructibleTerrain::RefreshJoinSnapshot()
+{
+    LLM_SCOPE_BYTAG(Terrain_Modifications);
+    
+    TArray<uint8> Bytes;
+    if (!SaveSnapshot(Bytes))
+    {
+        JoinSnapshot.Reset();
+        return;
+    }
+    
+    // Trop gros pour un paquet : les clients qui rejoignent reconstruisent le terrain à partir du journal répliqué
+    if (!JoinSnapshot.SetBytes(Bytes))
+    {
+        UE_LOG(LogTemp, Error, TEXT("%s: join snapshot too large to replicate (%d bytes, max %d), late joiners rebuild from the modification log"),
+            *GetName(), Bytes.Num(), FTerrainReplicatedBytes::MaxBytes);
+        JoinSnapshot.Reset();
+    }
+}
+
+void ADestructibleTerrain::OnRep_JoinSnapshot()
+{
+    // Terrain pas encore initialisé sur le serveur : il sera construit par OnRep_TerrainGeneration
+    if (HasAuthority() || JoinSnapshot.Items.Num() == 0)
+    {
+        return;
+    }
+    
+    const double StartTime = FPlatformTime::Seconds();
+    
+    TArray<uint8> Bytes;
+    FTerrainSnapshot Snapshot;
+    if (!JoinSnapshot.GetBytes(Bytes) || !Snapshot.Load(Bytes))
+    {
+        UE_LOG(LogTemp, Error, TEXT("%s: invalid join snapshot (%d chunks, %d bytes)"), *GetName(), JoinSnapshot.Items.Num(), Bytes.Num());
+        return;
+    }
+    
+    // Reconstruction locale : génération de la grille puis rejeu de toutes les modifications en un seul lot
+    ApplySnapshot(Snapshot);
+    GenerateTerrain();
+    ApplyTerrainModifications();
+    
+    UE_LOG(LogTemp, Log, TEXT("%s: rebuilt from a %d-byte snapshot (%d modifications) in %.2f ms"),
+        *GetName(), Bytes.Num(), Snapshot.Modifications.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    
+    // Envoyé une seule fois : inutile de le garder en mémoire
+    JoinSnapshot.Items.Empty();
+}
+
+void ADestructibleTerrain::OnRep_TerrainGeneration()
+{
+    // Terrain déjà construit pour cette génération (instantané ou journal reçus dans le même paquet),
+    // ou instantané initial pas encore traité : OnRep_JoinSnapshot s'en charge
+    if (HasAuthority() || !bIsInitialized || JoinSnapshot.Items.Num() > 0 ||
+        (MeshData.bIsValid && BuiltTerrainGeneration == TerrainGeneration))
+    {
+        return;
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("%s: terrain regenerated by the server, rebuilding from %d replicated modifications"),
+        *GetName(), TerrainModifications.Num());
+    SyncGridSettings();
+    GenerateTerrain();
+    AppliedModifications.Reset();
+    ApplyTerrainModifications();
+}
+
+void ADestructibleTerrain::SetTerrainCollisionActive(bool bActive)
+{
+    if (!HasAuthority() || bCollisionActive == bActive)
+    {
+        return;
+    }
+    
+    bCollisionActive = bActive;
+    OnRep_CollisionActive();
+}
+
+void ADestructibleTerrain::OnRep_CollisionActive()
+{
+    if (TerrainMesh)
+    {
+        TerrainMesh->SetCollisionEnabled(bCollisionActive ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+    }
+}
+
+void ADestructibleTerrain::OnRep_CollisionMode()
+{
+    // Passage en collision simple décidé par le serveur (pression mémoire) : la collision locale est reconstruite
+    if (MeshData.bIsValid)
+    {
+        CreateMeshFromData(MeshData);
+    }
+}
+
+void ADestructibleTerrain::OnRep_GenerateInternalStructure()
+{
+    // Couches internes retirées par le serveur (pression mémoire) : même régénération que lui, sans couches
+    // Sans mesh, l'instantané initial ou la reconstruction depuis le journal utilisera déjà la valeur reçue
+    if (!MeshData.bIsValid)
+    {
+        return;
+    }
+    
+    GenerateTerrain();
+    AppliedModifications.Reset();
+    ApplyTerrainModifications();
+}
+
 void ADestructibleTerrain::SetupMaterials()
 {
     // Vérifier si nous avons déjà des matériaux assignés
@@ -213,7 +506,8 @@ void ADestructibleTerrain::UpdateMaterialParameters()
 {
     if (TerrainMaterialInstance)
     {
-        // Passer les dimensions du terrain au matériau
+        // Passer les dimensions du terrain au matériau : le mesh ne porte pas d'UV,
+        // le matériau les calcule à partir de la position locale (X / TerrainWidth, Z / TerrainHeight)
         TerrainMaterialInstance->SetScalarParameterValue(TEXT("TerrainWidth"), TerrainWidth);
         TerrainMaterialInstance->SetScalarParameterValue(TEXT("TerrainHeight"), TerrainHeight);
         TerrainMaterialInstance->SetScalarParameterValue(TEXT("TerrainDepth"), TerrainDepth);
@@ -282,8 +576,9 @@ void ADestructibleTerrain::Multicast_NotifyInitialized_Implementation(float Widt
     TerrainWidth = Width;
     TerrainHeight = Height;
     TerrainDepth = Depth;
+    SyncGridSettings();
     
-    // Sur les clients, on ne génère pas le terrain ici, car les données viendront via la réplication de MeshData
+    // Sur les clients, on ne génère pas le terrain ici : OnRep_TerrainGeneration le fera avec le journal répliqué
     
     // Mais on peut préparer le matériau
     if (TerrainMaterial && TerrainMesh)
@@ -293,405 +588,192 @@ void ADestructibleTerrain::Multicast_NotifyInitialized_Implementation(float Widt
     
     // Marquer comme initialisé
     bIsInitialized = true;
+    
+    UpdateTerrainRegistration();
+}
+
+FBox ADestructibleTerrain::GetTerrainWorldBounds() const
+{
+    // Le terrain occupe [0, Width] x [0, Depth] x [0, Height] dans son repère local
+    FBox LocalBounds(FVector::ZeroVector, FVector(TerrainWidth, TerrainDepth, TerrainHeight));
+    return LocalBounds.TransformBy(GetActorTransform());
+}
+
+void ADestructibleTerrain::UpdateTerrainRegistration()
+{
+    UWorld* World = GetWorld();
+    if (!World || !HasActorBegunPlay())
+    {
+        return;
+    }
+    
+    if (UDestructibleTerrainSubsystem* TerrainSubsystem = World->GetSubsystem<UDestructibleTerrainSubsystem>())
+    {
+        TerrainSubsystem->RegisterTerrain(this);
+    }
 }
 
 void ADestructibleTerrain::GenerateInternalStructure()
 {
+    LLM_SCOPE_BYTAG(Terrain_Internal);
+    
+    // Vider les tableaux existants (même si la structure est désactivée, pour ne rien ajouter de périmé)
+    InternalVertices.Reset();
+    InternalTriangles.Reset();
+    InternalNormals.Reset();
+    InternalVertexColors.Reset();
+    
     if (!bGenerateInternalStructure || InternalLayerCount <= 0)
     {
         return;
     }
 
-    // Vider les tableaux existants
-    InternalVertices.Empty();
-    InternalTriangles.Empty();
-    InternalUVs.Empty();
-    InternalNormals.Empty();
-    InternalVertexColors.Empty();
+    // Positions et triangles des couches (TerrainCore), une copie de la grille par couche
+    FTerrainGridMesher::BuildInternalLayers(MakeGridSettings(), InternalLayerCount, InternalLayerThickness,
+        InternalVertices, InternalTriangles);
 
-    // Calculer le pas entre chaque point comme dans la génération de terrain standard
-    float HStep = TerrainWidth / (HorizontalResolution - 1);
-    float VStep = TerrainHeight / (VerticalResolution - 1);
+    const int32 VerticesPerLayer = HorizontalResolution * VerticalResolution;
+    const int32 TotalRows = InternalLayerCount * VerticalResolution;
+    InternalVertexColors.SetNumUninitialized(InternalVertices.Num());
 
-    // Calculer l'épaisseur de chaque couche interne
-    float TotalDepth = TerrainDepth - (2 * InternalLayerThickness); // Soustraire l'épaisseur des parois avant/arrière
-    float LayerDepth = TotalDepth / InternalLayerCount;
+    // Graine tirée une seule fois : chaque ligne a son propre flux aléatoire, sans état partagé entre threads
+    const int32 ColorSeed = FMath::Rand();
 
-    // Nous allons créer des couches internes parallèles à la face avant/arrière
-    for (int32 layerIndex = 0; layerIndex < InternalLayerCount; ++layerIndex)
+    // Couleurs des couches internes, une ligne par tâche
+    ParallelFor(TotalRows, [&](int32 RowIndex)
     {
-        // Position Y de cette couche interne à partir de la face avant
-        float LayerPosition = InternalLayerThickness + (layerIndex * LayerDepth);
-        
-        // Index de départ pour les vertices de cette couche
-        int32 LayerVertexStartIndex = InternalVertices.Num();
-        
-        // Générer un plan interne similaire à la face avant/arrière
-        for (int32 y = 0; y < VerticalResolution; ++y)
+        const int32 layerIndex = RowIndex / VerticalResolution;
+        const int32 y = RowIndex % VerticalResolution;
+
+        // Sélectionner la couleur de cette couche interne
+        FLinearColor BaseColor;
+        if (InternalLayerColors.IsValidIndex(layerIndex))
         {
-            for (int32 x = 0; x < HorizontalResolution; ++x)
-            {
-                // Calculer la position de ce vertex
-                float PosX = x * HStep;
-                float PosZ = y * VStep;
-                
-                // Ajouter le vertex avec une composante Y correspondant à la profondeur de la couche
-                InternalVertices.Add(FVector(PosX, LayerPosition, PosZ));
-                
-                // Ajouter les UV correspondants (normalisés de 0 à 1)
-                InternalUVs.Add(FVector2D(
-                    static_cast<float>(x) / (HorizontalResolution - 1), 
-                    static_cast<float>(y) / (VerticalResolution - 1)
-                ));
-                
-                // Sélectionner la couleur de cette couche interne
-                FLinearColor LayerColor;
-                if (InternalLayerColors.IsValidIndex(layerIndex))
-                {
-                    LayerColor = InternalLayerColors[layerIndex];
-                }
-                else if (InternalLayerColors.Num() > 0)
-                {
-                    // Fallback à la première couleur si l'index n'est pas valide
-                    LayerColor = InternalLayerColors[0];
-                }
-                else
-                {
-                    // Fallback à une couleur marron si aucune couleur n'est définie
-                    LayerColor = FLinearColor(0.5f, 0.25f, 0.0f, 1.0f);
-                }
-                
-                // Ajouter une variation aléatoire subtile à la couleur
-                float ColorVariation = FMath::RandRange(-0.1f, 0.1f);
-                LayerColor.R = FMath::Clamp(LayerColor.R + ColorVariation, 0.0f, 1.0f);
-                LayerColor.G = FMath::Clamp(LayerColor.G + ColorVariation, 0.0f, 1.0f);
-                LayerColor.B = FMath::Clamp(LayerColor.B + ColorVariation, 0.0f, 1.0f);
-                
-                // Convertir en FColor
-                InternalVertexColors.Add(LayerColor.ToFColor(true));
-            }
+            BaseColor = InternalLayerColors[layerIndex];
         }
-        
-        // Créer les triangles pour cette couche interne
-        for (int32 y = 0; y < VerticalResolution - 1; ++y)
+        else if (InternalLayerColors.Num() > 0)
         {
-            for (int32 x = 0; x < HorizontalResolution - 1; ++x)
-            {
-                int32 Current = LayerVertexStartIndex + y * HorizontalResolution + x;
-                int32 Next = Current + 1;
-                int32 Bottom = Current + HorizontalResolution;
-                int32 BottomNext = Bottom + 1;
-                
-                // Premier triangle (avec orientation correcte)
-                InternalTriangles.Add(Current);
-                InternalTriangles.Add(Next);
-                InternalTriangles.Add(Bottom);
-                
-                // Second triangle (avec orientation correcte)
-                InternalTriangles.Add(Next);
-                InternalTriangles.Add(BottomNext);
-                InternalTriangles.Add(Bottom);
-            }
+            // Fallback à la première couleur si l'index n'est pas valide
+            BaseColor = InternalLayerColors[0];
         }
-    }
-    
-    // Initialiser les normales pour toutes les couches
-    InternalNormals.Init(FVector::ZeroVector, InternalVertices.Num());
-    
-    // Calculer les normales pour chaque triangle et les ajouter aux normales des vertices
-    for (int32 i = 0; i < InternalTriangles.Num(); i += 3)
-    {
-        // Obtenir les indices des vertices du triangle
-        int32 Index0 = InternalTriangles[i];
-        int32 Index1 = InternalTriangles[i + 1];
-        int32 Index2 = InternalTriangles[i + 2];
-        
-        // Calculer les vecteurs des côtés du triangle
-        FVector Side1 = InternalVertices[Index1] - InternalVertices[Index0];
-        FVector Side2 = InternalVertices[Index2] - InternalVertices[Index0];
-        
-        // Calculer la normale du triangle (produit vectoriel)
-        FVector Normal = FVector::CrossProduct(Side1, Side2).GetSafeNormal();
-        
-        // Ajouter la normale à chaque vertex du triangle
-        InternalNormals[Index0] += Normal;
-        InternalNormals[Index1] += Normal;
-        InternalNormals[Index2] += Normal;
-    }
-    
-    // Normaliser toutes les normales
-    for (int32 i = 0; i < InternalNormals.Num(); i++)
-    {
-        InternalNormals[i] = InternalNormals[i].GetSafeNormal();
-    }
-    
+        else
+        {
+            // Fallback à une couleur marron si aucune couleur n'est définie
+            BaseColor = FLinearColor(0.5f, 0.25f, 0.0f, 1.0f);
+        }
+
+        FRandomStream RowStream(ColorSeed + RowIndex);
+
+        for (int32 x = 0; x < HorizontalResolution; ++x)
+        {
+            const int32 VertexIndex = layerIndex * VerticesPerLayer + y * HorizontalResolution + x;
+
+            // Ajouter une variation aléatoire subtile à la couleur
+            FLinearColor LayerColor = BaseColor;
+            const float ColorVariation = RowStream.FRandRange(-0.1f, 0.1f);
+            LayerColor.R = FMath::Clamp(LayerColor.R + ColorVariation, 0.0f, 1.0f);
+            LayerColor.G = FMath::Clamp(LayerColor.G + ColorVariation, 0.0f, 1.0f);
+            LayerColor.B = FMath::Clamp(LayerColor.B + ColorVariation, 0.0f, 1.0f);
+
+            // Convertir en FColor
+            InternalVertexColors[VertexIndex] = LayerColor.ToFColor(true);
+        }
+    });
+
+    // Normales par accumulation en lecture (gather) : chaque vertex ne lit que ses propres triangles
+    FTerrainMeshTopology InternalTopology;
+    InternalTopology.Build(InternalTriangles, InternalVertices.Num());
+    InternalNormals.SetNumUninitialized(InternalVertices.Num());
+    InternalTopology.ComputeVertexNormals(InternalVertices, InternalNormals, 0, InternalVertices.Num());
+
     UE_LOG(LogTemp, Log, TEXT("Generated internal structure with %d vertices and %d triangles"), 
         InternalVertices.Num(), InternalTriangles.Num() / 3);
 }
 
 void ADestructibleTerrain::GenerateTerrain()
 {
-    // Vider les tableaux
-    MeshData.Vertices.Empty();
-    MeshData.Triangles.Empty();
-    MeshData.UVs.Empty();
-    MeshData.Normals.Empty();
-    MeshData.VertexColors.Empty();
-    
-    // Initialiser les tangentes une seule fois
-    if (Tangents.Num() == 0)
-    {
-        InitializeTangents();
-    }
+    SCOPE_CYCLE_COUNTER(STAT_TerrainGenerate);
+    TRACE_CPUPROFILER_EVENT_SCOPE(ADestructibleTerrain::GenerateTerrain);
+    LLM_SCOPE_BYTAG(Terrain_MeshData);
     
     // Vérifier que les résolutions sont valides
     HorizontalResolution = FMath::Max(HorizontalResolution, 2);
     VerticalResolution = FMath::Max(VerticalResolution, 2);
     
-    // Calculer le pas entre chaque point
-    float HStep = TerrainWidth / (HorizontalResolution - 1);
-    float VStep = TerrainHeight / (VerticalResolution - 1);
-    
-    // 1. Génération de la face avant (vue principale du terrain)
-    for (int32 y = 0; y < VerticalResolution; ++y)
-    {
-        for (int32 x = 0; x < HorizontalResolution; ++x)
-        {
-            // Calculer la position de ce vertex
-            float PosX = x * HStep;
-            float PosZ = y * VStep;
-            
-            // Ajouter le vertex
-            MeshData.Vertices.Add(FVector(PosX, 0.0f, PosZ));
-            
-            // Ajouter les UV correspondants (normalisés de 0 à 1)
-            MeshData.UVs.Add(FVector2D(
-                static_cast<float>(x) / (HorizontalResolution - 1), 
-                static_cast<float>(y) / (VerticalResolution - 1)
-            ));
-            
-            // Couleur verte pour le terrain
-            MeshData.VertexColors.Add(FColor(75, 150, 75, 255));
-        }
-    }
+    // Repartir d'un masque de destruction vierge pour la nouvelle grille
+    ResetCarvedVertices();
     
-    // 2. Génération de la face arrière (derrière le terrain)
-    for (int32 y = 0; y < VerticalResolution; ++y)
-    {
-        for (int32 x = 0; x < HorizontalResolution; ++x)
-        {
-            // Calculer la position de ce vertex
-            float PosX = x * HStep;
-            float PosZ = y * VStep;
-            
-            // Ajouter le vertex
-            MeshData.Vertices.Add(FVector(PosX, TerrainDepth, PosZ));
-            
-            // Ajouter les UV correspondants (normalisés de 0 à 1)
-            MeshData.UVs.Add(FVector2D(
-                static_cast<float>(x) / (HorizontalResolution - 1), 
-                static_cast<float>(y) / (VerticalResolution - 1)
-            ));
-            
-            // Couleur verte pour le terrain
-            MeshData.VertexColors.Add(FColor(75, 150, 75, 255));
-        }
-    }
+    // 1-5. Faces avant, arrière et latérales (géométrie construite par TerrainCore)
+    FTerrainGridMesher::BuildShell(Grid.GetSettings(), MeshData.Vertices, MeshData.Triangles);
     
-    // 3. Création des triangles pour la face avant
-    int32 VerticesPerFace = HorizontalResolution * VerticalResolution;
-    for (int32 y = 0; y < VerticalResolution - 1; ++y)
-    {
-        for (int32 x = 0; x < HorizontalResolution - 1; ++x)
-        {
-            int32 Current = y * HorizontalResolution + x;
-            int32 Next = Current + 1;
-            int32 Bottom = Current + HorizontalResolution;
-            int32 BottomNext = Bottom + 1;
-            
-            // Premier triangle
-            MeshData.Triangles.Add(Current);
-            MeshData.Triangles.Add(Bottom);
-            MeshData.Triangles.Add(Next);
-            
-            // Second triangle
-            MeshData.Triangles.Add(Next);
-            MeshData.Triangles.Add(Bottom);
-            MeshData.Triangles.Add(BottomNext);
-        }
-    }
+    // Couleur verte pour le terrain
+    MeshData.VertexColors.Init(FColor(75, 150, 75, 255), MeshData.Vertices.Num());
     
-    // 4. Création des triangles pour la face arrière (inversés)
-    for (int32 y = 0; y < VerticalResolution - 1; ++y)
-    {
-        for (int32 x = 0; x < HorizontalResolution - 1; ++x)
-        {
-            int32 Current = VerticesPerFace + y * HorizontalResolution + x;
-            int32 Next = Current + 1;
-            int32 Bottom = Current + HorizontalResolution;
-            int32 BottomNext = Bottom + 1;
-            
-            // Premier triangle (inversé)
-            MeshData.Triangles.Add(Next);
-            MeshData.Triangles.Add(Bottom);
-            MeshData.Triangles.Add(Current);
-            
-            // Second triangle (inversé)
-            MeshData.Triangles.Add(BottomNext);
-            MeshData.Triangles.Add(Bottom);
-            MeshData.Triangles.Add(Next);
-        }
-    }
+    const int32 OuterVertexCount = MeshData.Vertices.Num();
     
-    // 5. Ajouter les triangles pour les faces latérales
-    // Face inférieure (bas)
-    for (int32 x = 0; x < HorizontalResolution - 1; ++x)
+    // 6. Générer la structure interne si activée (ses normales sont calculées par GenerateInternalStructure)
+    if (bGenerateInternalStructure)
     {
-        int32 FrontLeft = x;
-        int32 FrontRight = x + 1;
-        int32 BackLeft = VerticesPerFace + x;
-        int32 BackRight = VerticesPerFace + x + 1;
+        GenerateInternalStructure();
         
-        MeshData.Triangles.Add(FrontLeft);
-        MeshData.Triangles.Add(FrontRight);
-        MeshData.Triangles.Add(BackLeft);
+        // Ajouter la structure interne aux données du mesh principal
         
-        MeshData.Triangles.Add(BackLeft);
-        MeshData.Triangles.Add(FrontRight);
-        MeshData.Triangles.Add(BackRight);
-    }
-    
-    // Face supérieure (haut)
-    for (int32 x = 0; x < HorizontalResolution - 1; ++x)
-    {
-        int32 FrontLeft = (VerticalResolution - 1) * HorizontalResolution + x;
-        int32 FrontRight = FrontLeft + 1;
-        int32 BackLeft = VerticesPerFace + (VerticalResolution - 1) * HorizontalResolution + x;
-        int32 BackRight = BackLeft + 1;
+        // Sauvegarder les indices de départ pour les références
+        int32 VertexStartIndex = MeshData.Vertices.Num();
+        int32 IndexStart = MeshData.Triangles.Num();
+        
+        // Ajouter les vertices internes
+        MeshData.Vertices.Append(InternalVertices);
+        MeshData.VertexColors.Append(InternalVertexColors);
         
-        MeshData.Triangles.Add(FrontRight);
-        MeshData.Triangles.Add(FrontLeft);
-        MeshData.Triangles.Add(BackLeft);
+        // Ajouter les triangles internes (en ajustant les indices)
+        MeshData.Triangles.SetNumUninitialized(IndexStart + InternalTriangles.Num());
+        ParallelFor(InternalTriangles.Num(), [&](int32 i)
+        {
+            MeshData.Triangles[IndexStart + i] = InternalTriangles[i] + VertexStartIndex;
+        });
         
-        MeshData.Triangles.Add(BackRight);
-        MeshData.Triangles.Add(FrontRight);
-        MeshData.Triangles.Add(BackLeft);
+        // Log pour débogage
+        UE_LOG(LogTemp, Log, TEXT("Added internal structure: total mesh now has %d vertices and %d triangles"), 
+            MeshData.Vertices.Num(), MeshData.Triangles.Num() / 3);
     }
     
-    // Face gauche
-    for (int32 y = 0; y < VerticalResolution - 1; ++y)
+    // Construire l'adjacence vertex -> triangles utilisée par les mises à jour incrémentales
     {
-        int32 FrontBottom = y * HorizontalResolution;
-        int32 FrontTop = FrontBottom + HorizontalResolution;
-        int32 BackBottom = VerticesPerFace + y * HorizontalResolution;
-        int32 BackTop = BackBottom + HorizontalResolution;
-        
-        MeshData.Triangles.Add(FrontBottom);
-        MeshData.Triangles.Add(BackBottom);
-        MeshData.Triangles.Add(FrontTop);
-        
-        MeshData.Triangles.Add(FrontTop);
-        MeshData.Triangles.Add(BackBottom);
-        MeshData.Triangles.Add(BackTop);
+        LLM_SCOPE_BYTAG(Terrain_Topology);
+        Topology.Build(MeshData.Triangles, MeshData.Vertices.Num());
     }
     
-    // Face droite
-    for (int32 y = 0; y < VerticalResolution - 1; ++y)
+    // Normales des faces extérieures par gather sur l'adjacence (aucune écriture concurrente)
     {
-        int32 FrontBottom = y * HorizontalResolution + (HorizontalResolution - 1);
-        int32 FrontTop = FrontBottom + HorizontalResolution;
-        int32 BackBottom = VerticesPerFace + y * HorizontalResolution + (HorizontalResolution - 1);
-        int32 BackTop = BackBottom + HorizontalResolution;
+        SCOPE_CYCLE_COUNTER(STAT_TerrainComputeNormals);
+        MeshData.Normals.SetNumUninitialized(MeshData.Vertices.Num());
+        Topology.ComputeVertexNormals(MeshData.Vertices, MeshData.Normals, 0, OuterVertexCount);
         
-        MeshData.Triangles.Add(BackBottom);
-        MeshData.Triangles.Add(FrontBottom);
-        MeshData.Triangles.Add(FrontTop);
-        
-        MeshData.Triangles.Add(BackTop);
-        MeshData.Triangles.Add(BackBottom);
-        MeshData.Triangles.Add(FrontTop);
+        // Les normales internes sont déjà calculées
+        if (bGenerateInternalStructure && InternalNormals.Num() == MeshData.Vertices.Num() - OuterVertexCount)
+        {
+            FMemory::Memcpy(&MeshData.Normals[OuterVertexCount], InternalNormals.GetData(), InternalNormals.Num() * sizeof(FVector));
+        }
     }
     
-    // Initialiser les normales
-    MeshData.Normals.Init(FVector::ZeroVector, MeshData.Vertices.Num());
-    
-    // Calculer les normales pour chaque triangle et les ajouter aux normales des vertices
-    for (int32 i = 0; i < MeshData.Triangles.Num(); i += 3)
-    {
-        // Obtenir les indices des vertices du triangle
-        int32 Index0 = MeshData.Triangles[i];
-        int32 Index1 = MeshData.Triangles[i + 1];
-        int32 Index2 = MeshData.Triangles[i + 2];
-        
-        // Calculer les vecteurs des côtés du triangle
-        FVector Side1 = MeshData.Vertices[Index1] - MeshData.Vertices[Index0];
-        FVector Side2 = MeshData.Vertices[Index2] - MeshData.Vertices[Index0];
-        
-        // Calculer la normale du triangle (produit vectoriel)
-        FVector Normal = FVector::CrossProduct(Side1, Side2).GetSafeNormal();
-        
-        // Ajouter la normale à chaque vertex du triangle
-        MeshData.Normals[Index0] += Normal;
-        MeshData.Normals[Index1] += Normal;
-        MeshData.Normals[Index2] += Normal;
-    }
-    
-    // Normaliser toutes les normales
-    for (int32 i = 0; i < MeshData.Normals.Num(); i++)
-    {
-        MeshData.Normals[i] = MeshData.Normals[i].GetSafeNormal();
-    }
-    
-    // Élargir le tableau des tangentes si nécessaire
-    if (Tangents.Num() < MeshData.Vertices.Num())
-    {
-        int32 OldSize = Tangents.Num();
-        Tangents.AddDefaulted(MeshData.Vertices.Num() - OldSize);
-        
-        for (int32 i = OldSize; i < Tangents.Num(); ++i)
-        {
-            Tangents[i] = FProcMeshTangent(1.0f, 0.0f, 0.0f);
-        }
-    }
+    // Marquer les données comme valides
+    MeshData.bIsValid = true;
     
-    // 6. Générer la structure interne si activée
-    if (bGenerateInternalStructure)
+    // Sous pression mémoire, les tampons internes recopiés dans MeshData sont libérés aussitôt
+    if (MemoryPressure >= ETerrainMemoryPressure::TrimBuffers)
     {
-        GenerateInternalStructure();
-        
-        // Ajouter la structure interne aux données du mesh principal
-        
-        // Sauvegarder les indices de départ pour les références
-        int32 VertexStartIndex = MeshData.Vertices.Num();
-        
-        // Ajouter les vertices internes
-        MeshData.Vertices.Append(InternalVertices);
-        MeshData.UVs.Append(InternalUVs);
-        MeshData.VertexColors.Append(InternalVertexColors);
-        MeshData.Normals.Append(InternalNormals);
-        
-        // Ajouter les triangles internes (en ajustant les indices)
-        for (int32 i = 0; i < InternalTriangles.Num(); ++i)
-        {
-            MeshData.Triangles.Add(InternalTriangles[i] + VertexStartIndex);
-        }
-        
-        // Log pour débogage
-        UE_LOG(LogTemp, Log, TEXT("Added internal structure: total mesh now has %d vertices and %d triangles"), 
-            MeshData.Vertices.Num(), MeshData.Triangles.Num() / 3);
+        TrimMemory();
     }
     
-    // Marquer les données comme valides
-    MeshData.bIsValid = true;
-    
     // Créer le mesh à partir des données
     CreateMeshFromData(MeshData);
     
-    // Si nous sommes sur le serveur, répliquer ces données vers tous les clients
-    if (HasAuthority())
-    {
-        Multicast_UpdateTerrainMesh(MeshData);
-    }
+    // Nouvelle grille : la navmesh du terrain est reconstruite en entier (une seule fois, à la génération)
+    RebuildNavGeometry();
+    
+    // Les clients construisent le même terrain de leur côté (OnRep_TerrainGeneration, instantané ou journal répliqués)
+    BuiltTerrainGeneration = TerrainGeneration;
     
     // Log pour débogage
     UE_LOG(LogTemp, Log, TEXT("%s: Terrain généré avec %d vertices et %d triangles"), 
@@ -700,20 +782,11 @@ void ADestructibleTerrain::GenerateTerrain()
         MeshData.Triangles.Num() / 3);
 }
 
-void ADestructibleTerrain::InitializeTangents()
-{
-    // Initialiser les tangentes (une seule fois)
-    Tangents.Empty();
-    
-    // Nous utilisons une tangente par défaut
-    for (int32 i = 0; i < 8; i++)  // 8 vertices pour notre cube
-    {
-        Tangents.Add(FProcMeshTangent(1.0f, 0.0f, 0.0f));
-    }
-}
-
 void ADestructibleTerrain::CreateMeshFromData(const FTerrainMeshData& InMeshData)
 {
+    SCOPE_CYCLE_COUNTER(STAT_TerrainCreateMesh);
+    TRACE_CPUPROFILER_EVENT_SCOPE(ADestructibleTerrain::CreateMeshFromData);
+    
     if (!InMeshData.bIsValid)
     {
         UE_LOG(LogTemp, Error, TEXT("CreateMeshFromData called with invalid mesh data"));
@@ -723,38 +796,67 @@ void ADestructibleTerrain::CreateMeshFromData(const FTerrainMeshData& InMeshData
     // Convertir les couleurs
     TArray<FLinearColor> LinearColors = ConvertColorsToLinear(InMeshData.VertexColors);
     
-    // S'assurer que toutes les propriétés sont correctement définies
-    TArray<FVector> EmptyVertices;
-    TArray<int32> EmptyTriangles;
+    // En mode primitives simples, les triangles de rendu ne sont jamais cuits pour la collision
+    const bool bUseComplexCollision = (CollisionMode == ETerrainCollisionMode::ComplexMesh);
+    TerrainMesh->bUseComplexAsSimpleCollision = bUseComplexCollision;
     
-    // Créer la section de mesh
-    // IMPORTANT: Nous utilisons ClearMeshSection pour éviter tout problème
-    TerrainMesh->ClearMeshSection(0);
+    // Chaque changement de section ou de boîtes relance la cuisson du corps : en mode primitives simples, la cuisson
+    // est asynchrone et une nouvelle cuisson abandonne celle encore en attente (une seule par modification)
+    TerrainMesh->bUseAsyncCooking = !bUseComplexCollision;
     
     // Vérification supplémentaire pour éviter des crashs
     if (InMeshData.Vertices.Num() > 0 && InMeshData.Triangles.Num() > 0 && 
         InMeshData.Normals.Num() == InMeshData.Vertices.Num() && 
-        InMeshData.UVs.Num() == InMeshData.Vertices.Num() &&
         LinearColors.Num() == InMeshData.Vertices.Num())
     {
-        // Créer la section avec les données fournies
-        TerrainMesh->CreateMeshSection_LinearColor(
-            0, 
-            InMeshData.Vertices, 
-            InMeshData.Triangles, 
-            InMeshData.Normals, 
-            InMeshData.UVs, 
-            LinearColors, 
-            Tangents, 
-            true  // Génère une collision
-        );
+        // Les boîtes convexes doivent être en place avant que la section ne relance la cuisson
+        if (!bUseComplexCollision)
+        {
+            SCOPE_CYCLE_COUNTER(STAT_TerrainCollisionCooking);
+            LLM_SCOPE_BYTAG(Terrain_Collision);
+            UpdateSimpleCollision();
+        }
+        
+        // Créer la section avec les données fournies (copie de rendu, et cuisson de la collision complexe)
+        LLM_SCOPE_BYTAG(Terrain_Render);
+        TArray<FVector2D> UVs;
+        TArray<FProcMeshTangent> Tangents;
+        BuildRenderAttributes(InMeshData.Vertices, UVs, Tangents);
+        
+        // Section existante aux mêmes indices (normales, couleurs ou positions seules) : mise à jour des vertices,
+        // sans recréer la section ni relancer la cuisson
+        const FProcMeshSection* Section = TerrainMesh->GetProcMeshSection(0);
+        const bool bSameLayout = Section && Section->bEnableCollision == bUseComplexCollision &&
+            Section->ProcVertexBuffer.Num() == InMeshData.Vertices.Num() &&
+            Section->ProcIndexBuffer.Num() == InMeshData.Triangles.Num() &&
+            FMemory::Memcmp(Section->ProcIndexBuffer.GetData(), InMeshData.Triangles.GetData(), InMeshData.Triangles.Num() * sizeof(int32)) == 0;
+        
+        if (bSameLayout)
+        {
+            TerrainMesh->UpdateMeshSection_LinearColor(0, InMeshData.Vertices, InMeshData.Normals, UVs, LinearColors, Tangents);
+        }
+        else
+        {
+            CONDITIONAL_SCOPE_CYCLE_COUNTER(STAT_TerrainCollisionCooking, bUseComplexCollision);
+            TerrainMesh->CreateMeshSection_LinearColor(
+                0, 
+                InMeshData.Vertices, 
+                InMeshData.Triangles, 
+                InMeshData.Normals, 
+                UVs,  // Déduits de la position : ni stockés ni répliqués
+                LinearColors, 
+                Tangents, 
+                bUseComplexCollision  // Génère une collision complexe si demandé
+            );
+        }
         
-        // Activer les collisions
-        TerrainMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+        // Activer les collisions (sauf pour un chunk mis en veille)
+        TerrainMesh->SetCollisionEnabled(bCollisionActive ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
     }
     else
     {
         UE_LOG(LogTemp, Error, TEXT("Invalid mesh data dimensions"));
+        TerrainMesh->ClearMeshSection(0);
         return;
     }
     
@@ -780,6 +882,23 @@ void ADestructibleTerrain::CreateMeshFromData(const FTerrainMeshData& InMeshData
     
     // Forcer une mise à jour du rendu
     TerrainMesh->MarkRenderStateDirty();
+    
+    // Un état passé est affiché à la place du mesh courant jusqu'à ResumeLiveTerrain()
+    if (bTimelineRewound)
+    {
+        TerrainMesh->SetMeshSectionVisible(0, false);
+    }
+    // Le rendu passe par les sections de LOD : masquer la section complète et rafraîchir les sections modifiées
+    else if (IsLODActive())
+    {
+        UpdateLOD();
+    }
+    
+    // Le mesh a changé de taille : vérifier le budget mémoire de l'ensemble des terrains
+    if (UDestructibleTerrainSubsystem* TerrainSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UDestructibleTerrainSubsystem>() : nullptr)
+    {
+        TerrainSubsystem->EnforceMemoryBudget();
+    }
 }
 
 TArray<FLinearColor> ADestructibleTerrain::ConvertColorsToLinear(const TArray<FColor>& Colors)
@@ -795,33 +914,20 @@ TArray<FLinearColor> ADestructibleTerrain::ConvertColorsToLinear(const TArray<FC
     return LinearColors;
 }
 
-void ADestructibleTerrain::Multicast_UpdateTerrainMesh_Implementation(const FTerrainMeshData& InMeshData)
-{
-    // Ne pas exécuter sur le serveur, il a déjà fait cette opération
-    if (HasAuthority())
-    {
-        return;
-    }
-    
-    UE_LOG(LogTemp, Log, TEXT("Client received terrain mesh update with %d vertices and %d triangles"), 
-        InMeshData.Vertices.Num(), InMeshData.Triangles.Num() / 3);
-    
-    // Mettre à jour les données locales
-    this->MeshData = InMeshData;
-    
-    // Créer le mesh à partir des données
-    CreateMeshFromData(InMeshData);
-}
-
-void ADestructibleTerrain::OnRep_MeshData()
+void ADestructibleTerrain::BuildRenderAttributes(const TArray<FVector>& Vertices, TArray<FVector2D>& OutUVs, TArray<FProcMeshTangent>& OutTangents) const
 {
-    UE_LOG(LogTemp, Log, TEXT("OnRep_MeshData called on client"));
+    // Coordonnées normalisées de la grille : le même point de texture sur les faces avant et arrière
+    const double InvWidth = TerrainWidth > 0.0f ? 1.0 / TerrainWidth : 0.0;
+    const double InvHeight = TerrainHeight > 0.0f ? 1.0 / TerrainHeight : 0.0;
     
-    // Lorsque MeshData est répliqué, recréer le mesh
-    if (MeshData.bIsValid)
+    OutUVs.SetNumUninitialized(Vertices.Num());
+    for (int32 i = 0; i < Vertices.Num(); ++i)
     {
-        CreateMeshFromData(MeshData);
+        OutUVs[i] = FVector2D(Vertices[i].X * InvWidth, Vertices[i].Z * InvHeight);
     }
+    
+    // U suit la largeur du terrain : tangente constante
+    OutTangents.Init(FProcMeshTangent(1.0f, 0.0f, 0.0f), Vertices.Num());
 }
 
 void ADestructibleTerrain::RequestDestroyTerrainAt(FVector2D Position, FVector2D Size)
@@ -853,7 +959,10 @@ void ADestructibleTerrain::Server_DestroyTerrainAt_Implementation(FVector2D Posi
     FTerrainModification NewMod(Position, Size);
     
     // Ajouter à la liste globale des modifications
-    TerrainModifications.Add(NewMod);
+    {
+        LLM_SCOPE_BYTAG(Terrain_Modifications);
+        TerrainModifications.Add(NewMod);
+    }
     
     // Afficher le nombre total de modifications
     UE_LOG(LogTemp, Warning, TEXT("Total modifications: %d"), TerrainModifications.Num());
@@ -979,7 +1088,25 @@ bool ADestructibleTerrain::IsVertexInSection(const FVector& Vertex, const FIntPo
 void ADestructibleTerrain::OnRep_TerrainModifications()
 {
     // Appelé sur les clients quand TerrainModifications est répliqué
+    // Sans mesh, rien à creuser : le terrain sera reconstruit par l'instantané initial ou le mesh du serveur
+    if (!MeshData.bIsValid)
+    {
+        // Instantané refusé par le serveur (trop gros) : reconstruction à partir des dimensions et du journal répliqués
+        if (!HasAuthority() && bIsInitialized && JoinSnapshot.Items.Num() == 0)
+        {
+            UE_LOG(LogTemp, Log, TEXT("%s: no join snapshot, rebuilding from %d replicated modifications"), *GetName(), TerrainModifications.Num());
+            GenerateTerrain();
+            ApplyTerrainModifications();
+        }
+        return;
+    }
     ApplyTerrainModifications();
+    
+    // Les modifications repliées par le serveur ont quitté le journal : inutile de les garder
+    AppliedModifications.RemoveAll([this](const FTerrainModification& Mod)
+    {
+        return !TerrainModifications.Contains(Mod);
+    });
 }
 
 bool ADestructibleTerrain::IsVertexInModification(const FVector& Vertex, const FTerrainModification& Modification)
@@ -1011,11 +1138,21 @@ bool ADestructibleTerrain::IsVertexInModification(const FVector& Vertex, const F
 void ADestructibleTerrain::ApplyTerrainModifications()
 {
     // Si aucune modification, ne rien faire
-    if (TerrainModifications.Num() == 0)
+    if (TerrainModifications.Num() == 0 && !bCoveragePending)
     {
         return;
     }
     
+    // Les nouvelles modifications s'appliquent au terrain courant
+    if (bTimelineRewound)
+    {
+        ResumeLiveTerrain();
+    }
+    
+    SCOPE_CYCLE_COUNTER(STAT_TerrainApplyModifications);
+    TRACE_CPUPROFILER_EVENT_SCOPE(ADestructibleTerrain::ApplyTerrainModifications);
+    LLM_SCOPE_BYTAG(Terrain_MeshData);
+    
     UE_LOG(LogTemp, Warning, TEXT("Applying %d terrain modifications"), TerrainModifications.Num());
     
     // On ne traite que les modifications non appliquées
@@ -1028,220 +1165,1779 @@ void ADestructibleTerrain::ApplyTerrainModifications()
         }
     }
     
-    if (NewModifications.Num() == 0)
+    if (NewModifications.Num() == 0 && !bCoveragePending)
     {
         return; // Toutes les modifications ont déjà été appliquées
     }
     
-    // Nous allons travailler avec des copies des données existantes
-    TArray<FVector> NewVertices = MeshData.Vertices;
-    TArray<int32> NewTriangles; // Sera rempli avec les triangles conservés et modifiés
-    TArray<FVector2D> NewUVs = MeshData.UVs;
-    TArray<FColor> NewVertexColors = MeshData.VertexColors;
+    // L'adjacence doit correspondre au mesh courant : reconstruite si sa disposition a changé
+    if (!Topology.IsValidFor(MeshData.Vertices.Num(), MeshData.Triangles.Num()))
+    {
+        LLM_SCOPE_BYTAG(Terrain_Topology);
+        Topology.Build(MeshData.Triangles, MeshData.Vertices.Num());
+    }
+    
+    // 1. Mettre à jour le masque et collecter les vertices de la grille nouvellement détruits
+    // Le creusement est chronométré par modification pour les événements du canal Insights "Terrain"
+    TArray<int32> NewlyCarved;
+    TArray<uint64> CarveStartCycles;
+    TArray<uint64> CarveCycles;
+    TArray<int32> CarvedCounts;
+    CarveStartCycles.Reserve(NewModifications.Num());
+    CarveCycles.Reserve(NewModifications.Num());
+    CarvedCounts.Reserve(NewModifications.Num());
     
-    // Liste des triangles à conserver (non affectés par les modifications)
-    TArray<bool> TriangleToKeep;
-    TriangleToKeep.Init(true, MeshData.Triangles.Num() / 3);
+    const double EditTime = GetTimelineTime();
     
-// 1. Première passe: identifier les triangles touchés par les modifications
-    for (int32 TriIdx = 0; TriIdx < MeshData.Triangles.Num() / 3; TriIdx++)
+    // Modifications repliées d'abord : leur masque est reporté en un seul passage
+    if (bCoveragePending)
     {
-        int32 Index1 = MeshData.Triangles[TriIdx * 3];
-        int32 Index2 = MeshData.Triangles[TriIdx * 3 + 1];
-        int32 Index3 = MeshData.Triangles[TriIdx * 3 + 2];
+        SyncGridSettings();
         
-        // Vérifier si le triangle est affecté par l'une des nouvelles modifications
-        for (const FTerrainModification& Mod : NewModifications)
+        // Un client connecté a déjà creusé ces cellules : sa chronologie reste valable telle quelle.
+        // Sinon la grille saute à l'état replié, que la chronologie reprend comme point de contrôle.
+        FIntPoint MinSection, MaxSection;
+        if (Grid.CarveMask(CoverageGrid.GetCarvedMask(), &NewlyCarved, MinSection, MaxSection))
         {
-            if (IsVertexInModification(MeshData.Vertices[Index1], Mod) ||
-                IsVertexInModification(MeshData.Vertices[Index2], Mod) ||
-                IsVertexInModification(MeshData.Vertices[Index3], Mod))
+            MarkCarvedSectionsDirty(MinSection, MaxSection);
+            if (!Timeline.IsEmpty())
             {
-                TriangleToKeep[TriIdx] = false;
-                break;
+                LLM_SCOPE_BYTAG(Terrain_Modifications);
+                Timeline.AddCheckpoint(EditTime, Grid);
             }
         }
+        bCoveragePending = false;
     }
     
-    // 2. Construire le nouveau tableau de triangles en ne gardant que ceux qui ne sont pas touchés
-    for (int32 TriIdx = 0; TriIdx < MeshData.Triangles.Num() / 3; TriIdx++)
+    // Point de départ de la chronologie : la grille avant ce lot (après une régénération ou une arrivée en cours de partie)
+    if (Timeline.IsEmpty())
+    {
+        LLM_SCOPE_BYTAG(Terrain_Modifications);
+        SyncGridSettings();
+        Timeline.AddCheckpoint(EditTime, Grid);
+    }
+    
+    for (const FTerrainModification& Mod : NewModifications)
     {
-        if (TriangleToKeep[TriIdx])
+        const uint64 StartCycle = FPlatformTime::Cycles64();
+        const int32 CarvedBefore = NewlyCarved.Num();
+        CarveVertices(Mod, &NewlyCarved);
         {
-            // Ajouter les indices du triangle
-            NewTriangles.Add(MeshData.Triangles[TriIdx * 3]);
-            NewTriangles.Add(MeshData.Triangles[TriIdx * 3 + 1]);
-            NewTriangles.Add(MeshData.Triangles[TriIdx * 3 + 2]);
+            LLM_SCOPE_BYTAG(Terrain_Modifications);
+            Timeline.RecordEdit(EditTime, Mod.Position, Mod.Size, Grid);
         }
+        CarveStartCycles.Add(StartCycle);
+        CarveCycles.Add(FPlatformTime::Cycles64() - StartCycle);
+        CarvedCounts.Add(NewlyCarved.Num() - CarvedBefore);
     }
+    const uint64 RebuildStartCycle = FPlatformTime::Cycles64();
     
-    // 3. Mettre à jour les données de mesh
-    MeshData.Triangles = NewTriangles;
+    // 2-5. Retirer les triangles détruits et recalculer les normales touchées
+    RemoveCarvedGeometry(NewlyCarved, NewModifications);
     
-    // 4. Recalculer les normales
-    MeshData.Normals.Init(FVector::ZeroVector, NewVertices.Num());
+    // 6. Appliquer les données au mesh
+    CreateMeshFromData(MeshData);
     
-    for (int32 i = 0; i < NewTriangles.Num(); i += 3)
+    // Un événement par modification : son creusement plus sa part de la reconstruction commune du mesh
+    INC_DWORD_STAT_BY(STAT_TerrainModificationsApplied, NewModifications.Num());
+    if (UE_TRACE_CHANNELEXPR_IS_ENABLED(TerrainChannel) && NewModifications.Num() > 0)
     {
-        // Obtenir les indices des vertices du triangle
-        int32 Index0 = NewTriangles[i];
-        int32 Index1 = NewTriangles[i + 1];
-        int32 Index2 = NewTriangles[i + 2];
-        
-        // Vérifier si les indices sont valides
-        if (NewVertices.IsValidIndex(Index0) && NewVertices.IsValidIndex(Index1) && NewVertices.IsValidIndex(Index2))
+        const uint64 SharedCycles = (FPlatformTime::Cycles64() - RebuildStartCycle) / NewModifications.Num();
+        for (int32 i = 0; i < NewModifications.Num(); ++i)
+        {
+            TraceTerrainModification(*this, NewModifications[i], CarveStartCycles[i], CarveCycles[i] + SharedCycles, CarvedCounts[i]);
+        }
+    }
+    
+    // 7. Ajouter les nouvelles modifications à la liste des modifications appliquées
+    {
+        LLM_SCOPE_BYTAG(Terrain_Modifications);
+        AppliedModifications.Append(NewModifications);
+    }
+    
+    // Marquer que les modifications ont été appliquées
+    bModificationsApplied = true;
+    
+    // Sur le serveur, seuls le journal, la couverture et l'instantané sont répliqués : les clients rejouent les modifications
+    if (HasAuthority())
+    {
+        CompactModificationLog();
+        RefreshJoinSnapshot();
+    }
+}
+
+void ADestructibleTerrain::RemoveCarvedGeometry(const TArray<int32>& NewlyCarved, const TArray<FTerrainModification>& FallbackModifications)
+{
+    // 2. Retrouver les vertices du mesh correspondants : chaque face/couche est une copie de la grille
+    TArray<int32> AffectedVertices;
+    int32 VerticesPerFace = HorizontalResolution * VerticalResolution;
+    if (VerticesPerFace > 0 && MeshData.Vertices.Num() % VerticesPerFace == 0)
+    {
+        int32 LayerCount = MeshData.Vertices.Num() / VerticesPerFace;
+        AffectedVertices.Reserve(NewlyCarved.Num() * LayerCount);
+        for (int32 Layer = 0; Layer < LayerCount; ++Layer)
+        {
+            for (int32 GridIndex : NewlyCarved)
+            {
+                AffectedVertices.Add(Layer * VerticesPerFace + GridIndex);
+            }
+        }
+    }
+    else
+    {
+        // Mesh dont la disposition ne suit pas la grille : test de position sur chaque vertex
+        UE_LOG(LogTemp, Warning, TEXT("Mesh layout does not match the terrain grid, testing every vertex"));
+        for (int32 VertexIndex = 0; VertexIndex < MeshData.Vertices.Num(); ++VertexIndex)
+        {
+            for (const FTerrainModification& Mod : FallbackModifications)
+            {
+                if (IsVertexInModification(MeshData.Vertices[VertexIndex], Mod))
+                {
+                    AffectedVertices.Add(VertexIndex);
+                    break;
+                }
+            }
+        }
+    }
+    
+    // 3. Retirer les triangles encore vivants qui référencent un vertex détruit
+    TArray<int32> TouchedVertices;
+    TBitArray<> IsTouched(false, MeshData.Vertices.Num());
+    int32 RemovedTriangles = 0;
+    
+    for (int32 VertexIndex : AffectedVertices)
+    {
+        for (int32 Adj = Topology.VertexTriangleOffsets[VertexIndex]; Adj < Topology.VertexTriangleOffsets[VertexIndex + 1]; ++Adj)
         {
-            // Calculer les vecteurs des côtés du triangle
-            FVector Side1 = NewVertices[Index1] - NewVertices[Index0];
-            FVector Side2 = NewVertices[Index2] - NewVertices[Index0];
+            int32 TriIdx = Topology.VertexTriangles[Adj];
+            if (!Topology.AliveTriangles[TriIdx])
+            {
+                continue;
+            }
             
-            // Calculer la normale du triangle (produit vectoriel)
-            FVector Normal = FVector::CrossProduct(Side1, Side2).GetSafeNormal();
+            Topology.AliveTriangles[TriIdx] = false;
+            Topology.AliveTriangleCount--;
+            RemovedTriangles++;
             
-            // Ajouter la normale à chaque vertex du triangle
-            MeshData.Normals[Index0] += Normal;
-            MeshData.Normals[Index1] += Normal;
-            MeshData.Normals[Index2] += Normal;
+            // Seuls les vertices des triangles retirés voient leur normale changer
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                int32 CornerVertex = Topology.Triangles[TriIdx * 3 + Corner];
+                if (!IsTouched[CornerVertex])
+                {
+                    IsTouched[CornerVertex] = true;
+                    TouchedVertices.Add(CornerVertex);
+                }
+            }
         }
     }
     
-    // Normaliser toutes les normales
-    for (int32 i = 0; i < MeshData.Normals.Num(); i++)
+    // 4. Reconstruire le tampon d'indices à partir des triangles encore vivants
+    if (RemovedTriangles > 0)
+    {
+        Topology.GatherAliveTriangles(MeshData.Triangles);
+    }
+    
+    // 5. Recalculer les normales des seuls vertices touchés
     {
-        if (!MeshData.Normals[i].IsZero())
+        SCOPE_CYCLE_COUNTER(STAT_TerrainComputeNormals);
+        
+        if (MeshData.Normals.Num() != MeshData.Vertices.Num())
         {
-            MeshData.Normals[i] = MeshData.Normals[i].GetSafeNormal();
+            MeshData.Normals.Init(FVector(0.0f, -1.0f, 0.0f), MeshData.Vertices.Num());
         }
-        else
+        
+        for (int32 VertexIndex : TouchedVertices)
         {
+            FVector Normal = Topology.ComputeVertexNormal(VertexIndex, MeshData.Vertices);
+            
             // Par défaut, on met une normale vers l'extérieur
-            MeshData.Normals[i] = FVector(0.0f, -1.0f, 0.0f);
+            MeshData.Normals[VertexIndex] = Normal.IsZero() ? FVector(0.0f, -1.0f, 0.0f) : Normal;
         }
     }
     
-    // 5. Appliquer les données au mesh
-    CreateMeshFromData(MeshData);
+    UE_LOG(LogTemp, Log, TEXT("Removed %d triangles, recomputed %d normals"), RemovedTriangles, TouchedVertices.Num());
+}
+
+void ADestructibleTerrain::CompactModificationLog()
+{
+    if (!HasAuthority() || TerrainModifications.Num() <= FMath::Max(MaxLoggedModifications, 1))
+    {
+        return;
+    }
     
-    // 6. Ajouter les nouvelles modifications à la liste des modifications appliquées
-    for (const FTerrainModification& Mod : NewModifications)
+    LLM_SCOPE_BYTAG(Terrain_Modifications);
+    
+    const int32 TailLength = FMath::Clamp(ModificationTailLength, 0, MaxLoggedModifications - 1);
+    const int32 FoldCount = TerrainModifications.Num() - TailLength;
+    
+    // Le masque replié ne contient que les anciennes modifications : la queue reste rejouable telle quelle
+    const FTerrainGridSettings Settings = MakeGridSettings();
+    if (CompactedCoverage.FoldedCount == 0 || CoverageGrid.GetSettings() != Settings)
     {
-        AppliedModifications.Add(Mod);
+        CoverageGrid.SetSettings(Settings);
     }
     
-    // Marquer que les modifications ont été appliquées
-    bModificationsApplied = true;
+    FIntPoint MinSection, MaxSection;
+    for (int32 i = 0; i < FoldCount; ++i)
+    {
+        CoverageGrid.CarveRect(TerrainModifications[i].Position, TerrainModifications[i].Size, nullptr, MinSection, MaxSection);
+    }
     
-    // Si nous sommes sur le serveur, répliquer ces données vers tous les clients
-    if (HasAuthority())
+    // Couverture trop grosse pour être répliquée : le journal n'est pas replié, les modifications restent rejouables
+    // (le masque déjà creusé ne contient que des modifications du journal, les creuser à nouveau ne change rien)
+    FTerrainCompactedCoverage Folded;
+    CoverageGrid.EncodeCarvedRuns(Folded.Runs);
+    Folded.FoldedCount = CompactedCoverage.FoldedCount + FoldCount;
+    
+    TArray<uint8> CoverageBytes;
+    WriteCoverageBytes(Folded, CoverageBytes);
+    if (!ReplicatedCoverage.SetBytes(CoverageBytes))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: coverage too large to replicate (%d bytes, max %d), keeping %d modifications in the log"),
+            *GetName(), CoverageBytes.Num(), FTerrainReplicatedBytes::MaxBytes, TerrainModifications.Num());
+        return;
+    }
+    CompactedCoverage = MoveTemp(Folded);
+    
+    TerrainModifications.RemoveAt(0, FoldCount);
+    
+    // Côté serveur, toutes les modifications restantes sont appliquées
+    AppliedModifications = TerrainModifications;
+    for (TPair<FIntPoint, FTerrainModificationArray>& Pair : SectionModifications)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Replicating updated mesh to clients"));
-        Multicast_UpdateTerrainMesh(MeshData);
+        Pair.Value.Modifications.RemoveAll([this](const FTerrainModification& Mod)
+        {
+            return !TerrainModifications.Contains(Mod);
+        });
     }
+    
+    UE_LOG(LogTemp, Log, TEXT("%s: folded %d modifications into a %d-byte coverage (%d folded in total, %d kept)"),
+        *GetName(), FoldCount, CompactedCoverage.Runs.Num(), CompactedCoverage.FoldedCount, TerrainModifications.Num());
 }
 
-void ADestructibleTerrain::Multicast_ForceVisualUpdate_Implementation()
+bool ADestructibleTerrain::DecodeCoverage(const FTerrainCompactedCoverage& Coverage)
 {
-    UE_LOG(LogTemp, Log, TEXT("ForceVisualUpdate called on %s"), HasAuthority() ? TEXT("server") : TEXT("client"));
-    
-    if (MeshData.bIsValid)
+    CoverageGrid.SetSettings(MakeGridSettings());
+    if (Coverage.FoldedCount == 0)
     {
-        // Recréer le mesh à partir des données actuelles
-        CreateMeshFromData(MeshData);
+        CoverageGrid.Reset();
+        return true;
     }
-    else if (bIsInitialized)
+    
+    if (!CoverageGrid.DecodeCarvedRuns(Coverage.Runs))
     {
-        // Si les données ne sont pas valides mais que le terrain est initialisé, régénérer
-        GenerateTerrain();
+        UE_LOG(LogTemp, Warning, TEXT("%s: compacted coverage does not match the %dx%d grid"),
+            *GetName(), HorizontalResolution, VerticalResolution);
+        CoverageGrid.Reset();
+        return false;
     }
+    return true;
 }
 
-void ADestructibleTerrain::UpdateLOD()
+void ADestructibleTerrain::WriteCoverageBytes(const FTerrainCompactedCoverage& Coverage, TArray<uint8>& OutBytes)
+{
+    OutBytes.Reset();
+    FMemoryWriter Writer(OutBytes);
+    FTerrainCompactedCoverage Copy = Coverage;
+    Writer << Copy.FoldedCount;
+    Writer << Copy.Runs;
+}
+
+void ADestructibleTerrain::OnRep_CompactedCoverage()
 {
-    if (!bUseLOD || !bIsInitialized)
+    TArray<uint8> Bytes;
+    if (!ReplicatedCoverage.GetBytes(Bytes))
     {
+        UE_LOG(LogTemp, Warning, TEXT("%s: incomplete compacted coverage (%d chunks)"), *GetName(), ReplicatedCoverage.Items.Num());
         return;
     }
     
-    // Calculer la distance au joueur le plus proche
-    float DistanceToPlayer = GetDistanceToNearestPlayer();
+    FTerrainCompactedCoverage Coverage;
+    if (Bytes.Num() > 0)
+    {
+        FMemoryReader Reader(Bytes);
+        Reader << Coverage.FoldedCount;
+        Reader << Coverage.Runs;
+        if (Reader.IsError())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("%s: invalid compacted coverage (%d bytes)"), *GetName(), Bytes.Num());
+            return;
+        }
+    }
+    CompactedCoverage = MoveTemp(Coverage);
     
-    // Déterminer si nous devons utiliser le niveau de détail bas
-    bool bShouldUseLOD = (DistanceToPlayer > LODDistanceThreshold);
+    if (!DecodeCoverage(CompactedCoverage))
+    {
+        return;
+    }
     
-    // Si l'état du LOD a changé, mettre à jour le mesh
-    if (bShouldUseLOD != bIsUsingLOD)
+    // Un client connecté a déjà creusé ces modifications : le report du masque ne change alors rien
+    bCoveragePending = CompactedCoverage.FoldedCount > 0;
+    if (MeshData.bIsValid)
     {
-        UE_LOG(LogTemp, Verbose, TEXT("LOD state changed: distance = %.1f, using LOD = %s"), 
-            DistanceToPlayer, bShouldUseLOD ? TEXT("true") : TEXT("false"));
-        
-        // Basculer la résolution
-        SwitchResolution(bShouldUseLOD);
-        
-        // Mémoriser le nouvel état
-        bIsUsingLOD = bShouldUseLOD;
+        ApplyTerrainModifications();
+    }
+}
+
+double ADestructibleTerrain::GetTimelineTime() const
+{
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return 0.0;
     }
+    
+    const AGameStateBase* GameState = World->GetGameState();
+    return GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
 }
 
-float ADestructibleTerrain::GetDistanceToNearestPlayer()
+bool ADestructibleTerrain::RewindTerrainTo(float ServerTime)
 {
-    // Obtenir tous les joueurs
-    TArray<AActor*> PlayerPawns;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), APawn::StaticClass(), PlayerPawns);
+    // Un serveur en réseau fait autorité sur la géométrie de tous les joueurs
+    if (GetNetMode() == NM_DedicatedServer || GetNetMode() == NM_ListenServer || !MeshData.bIsValid)
+    {
+        return false;
+    }
     
-    if (PlayerPawns.Num() == 0)
+    FTerrainGrid PastGrid;
+    if (!Timeline.ReconstructAt(ServerTime, PastGrid))
     {
-        return TNumericLimits<float>::Max(); // Aucun joueur trouvé
+        UE_LOG(LogTemp, Warning, TEXT("%s: cannot rewind to %.2f s (timeline starts at %.2f s)"),
+            *GetName(), ServerTime, Timeline.GetStartTime());
+        return false;
     }
     
-    // Calculer la distance au joueur le plus proche
-    float MinDistance = TNumericLimits<float>::Max();
+    return ShowGridState(PastGrid);
+}
+
+bool ADestructibleTerrain::RewindTerrainModifications(int32 Count)
+{
+    if (GetNetMode() == NM_DedicatedServer || GetNetMode() == NM_ListenServer || !MeshData.bIsValid)
+    {
+        return false;
+    }
     
-    for (AActor* PlayerActor : PlayerPawns)
+    FTerrainGrid PastGrid;
+    if (!Timeline.ReconstructBeforeLastEdits(Count, PastGrid))
     {
-        float Distance = FVector::Distance(GetActorLocation(), PlayerActor->GetActorLocation());
-        MinDistance = FMath::Min(MinDistance, Distance);
+        UE_LOG(LogTemp, Warning, TEXT("%s: cannot rewind %d modifications (%d recorded)"),
+            *GetName(), Count, Timeline.GetEditCount());
+        return false;
     }
     
-    return MinDistance;
+    return ShowGridState(PastGrid);
 }
 
-void ADestructibleTerrain::SwitchResolution(bool bUseLowResolution)
+void ADestructibleTerrain::ResumeLiveTerrain()
 {
-    if (!HasAuthority() || !bUseLOD)
+    if (!bTimelineRewound)
     {
-        // Ne changer la résolution que sur le serveur
         return;
     }
+    bTimelineRewound = false;
+    
+    // Le terrain courant n'a jamais été touché : il suffit de l'afficher à nouveau
+    TerrainLODMesh->ClearAllMeshSections();
+    TerrainMesh->SetMeshSectionVisible(0, true);
+    
+    // Les niveaux de LOD déjà calculés sont renvoyés tels quels (UpdateLOD masque à nouveau la section complète)
+    for (TPair<FIntPoint, FTerrainSectionLODChain>& Pair : SectionLODChains)
+    {
+        Pair.Value.CurrentLevel = INDEX_NONE;
+    }
+    UpdateLOD();
+}
+
+bool ADestructibleTerrain::ShowGridState(const FTerrainGrid& State)
+{
+    SCOPE_CYCLE_COUNTER(STAT_TerrainApplyModifications);
+    TRACE_CPUPROFILER_EVENT_SCOPE(ADestructibleTerrain::ShowGridState);
+    
+    // Rendu seul : la grille, le mesh, les collisions, la navigation, la minimap et le décor restent ceux du terrain courant.
+    // Le mesh de l'état passé reprend les triangles de l'adjacence (mesh intact) sans ceux qui touchent un vertex détruit.
+    const int32 VerticesPerFace = HorizontalResolution * VerticalResolution;
+    if (VerticesPerFace <= 0 || MeshData.Vertices.Num() % VerticesPerFace != 0 ||
+        State.GetCarvedMask().Num() != VerticesPerFace || !TerrainLODMesh)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: past terrain state does not match the current mesh layout"), *GetName());
+        return false;
+    }
     
-    // Sauvegarder les résolutions actuelles
-    static int32 HighHorizontalResolution = HorizontalResolution;
-    static int32 HighVerticalResolution = VerticalResolution;
+    if (!Topology.IsValidFor(MeshData.Vertices.Num(), MeshData.Triangles.Num()))
+    {
+        LLM_SCOPE_BYTAG(Terrain_Topology);
+        Topology.Build(MeshData.Triangles, MeshData.Vertices.Num());
+    }
+    
+    const TBitArray<>& PastCarved = State.GetCarvedMask();
+    const int32 TriangleCount = Topology.Triangles.Num() / 3;
+    TBitArray<> PastAlive(false, TriangleCount);
+    
+    FTerrainMeshData PastMesh;
+    PastMesh.Vertices = MeshData.Vertices;
+    PastMesh.VertexColors = MeshData.VertexColors;
+    PastMesh.Normals = MeshData.Normals;
+    PastMesh.Triangles.Reserve(Topology.Triangles.Num());
     
-    if (bUseLowResolution)
+    for (int32 TriIdx = 0; TriIdx < TriangleCount; ++TriIdx)
     {
-        // Sauvegarder la haute résolution si ce n'est pas déjà fait
-        if (HorizontalResolution > LODHorizontalResolution)
+        bool bAlive = true;
+        for (int32 Corner = 0; Corner < 3 && bAlive; ++Corner)
         {
-            HighHorizontalResolution = HorizontalResolution;
-            HighVerticalResolution = VerticalResolution;
+            bAlive = !PastCarved[Topology.Triangles[TriIdx * 3 + Corner] % VerticesPerFace];
+        }
+        if (bAlive)
+        {
+            PastAlive[TriIdx] = true;
+            PastMesh.Triangles.Append(&Topology.Triangles[TriIdx * 3], 3);
         }
-        
-        // Passer à la basse résolution
-        HorizontalResolution = LODHorizontalResolution;
-        VerticalResolution = LODVerticalResolution;
     }
-    else
+    
+    // Seules les normales des vertices dont une face diffère du terrain courant sont recalculées
+    TBitArray<> IsTouched(false, PastMesh.Vertices.Num());
+    for (int32 TriIdx = 0; TriIdx < TriangleCount; ++TriIdx)
     {
-        // Restaurer la résolution normale
-        HorizontalResolution = HighHorizontalResolution;
-        VerticalResolution = HighVerticalResolution;
+        const bool bPastAlive = PastAlive[TriIdx];
+        if (bPastAlive == Topology.AliveTriangles[TriIdx])
+        {
+            continue;
+        }
+        for (int32 Corner = 0; Corner < 3; ++Corner)
+        {
+            const int32 VertexIndex = Topology.Triangles[TriIdx * 3 + Corner];
+            if (!IsTouched[VertexIndex])
+            {
+                IsTouched[VertexIndex] = true;
+                const FVector Normal = Topology.ComputeVertexNormal(VertexIndex, PastMesh.Vertices, PastAlive);
+                PastMesh.Normals[VertexIndex] = Normal.IsZero() ? FVector(0.0f, -1.0f, 0.0f) : Normal;
+            }
+        }
     }
     
-    // Réappliquer toutes les modifications avec la nouvelle résolution
-    GenerateTerrain();
+    // Affiché par TerrainLODMesh (sans collision) à la place du mesh courant et de ses sections de LOD
+    bTimelineRewound = true;
+    TerrainMesh->SetMeshSectionVisible(0, false);
+    TerrainLODMesh->ClearAllMeshSections();
+    
+    TArray<FVector2D> UVs;
+    TArray<FProcMeshTangent> Tangents;
+    BuildRenderAttributes(PastMesh.Vertices, UVs, Tangents);
+    
+    TerrainLODMesh->CreateMeshSection_LinearColor(
+        0,
+        PastMesh.Vertices,
+        PastMesh.Triangles,
+        PastMesh.Normals,
+        UVs,
+        ConvertColorsToLinear(PastMesh.VertexColors),
+        Tangents,
+        false
+    );
+    TerrainLODMesh->SetMaterial(0, TerrainMesh->GetMaterial(0));
+    return true;
+}
+
+void ADestructibleTerrain::Multicast_ForceVisualUpdate_Implementation()
+{
+    UE_LOG(LogTemp, Log, TEXT("ForceVisualUpdate called on %s"), HasAuthority() ? TEXT("server") : TEXT("client"));
     
-    // Log pour le débogage
-    UE_LOG(LogTemp, Log, TEXT("Switched terrain resolution to %s (%d x %d)"), 
-        bUseLowResolution ? TEXT("LOD") : TEXT("normal"),
-        HorizontalResolution, VerticalResolution);
+    if (MeshData.bIsValid)
+    {
+        // Recréer le mesh à partir des données actuelles
+        CreateMeshFromData(MeshData);
+    }
+    else if (bIsInitialized)
+    {
+        // Si les données ne sont pas valides mais que le terrain est initialisé, régénérer
+        GenerateTerrain();
+    }
+}
+
+bool ADestructibleTerrain::IsLODActive() const
+{
+    // Un serveur dédié n'affiche rien : aucun LOD à calculer
+    return bUseLOD && bIsInitialized && MeshData.bIsValid && TerrainLODMesh &&
+           GetNetMode() != NM_DedicatedServer;
+}
+
+int32 ADestructibleTerrain::GetSectionRenderIndex(const FIntPoint& SectionCoord) const
+{
+    return SectionCoord.Y * GetSectionCount().X + SectionCoord.X;
+}
+
+void ADestructibleTerrain::ResetLODSections()
+{
+    SectionLODChains.Empty();
+    
+    if (TerrainLODMesh)
+    {
+        TerrainLODMesh->ClearAllMeshSections();
+    }
+}
+
+void ADestructibleTerrain::UpdateLOD()
+{
+    // Pendant l'affichage d'un état passé, TerrainLODMesh porte ce seul état
+    if (!IsLODActive() || bTimelineRewound)
+    {
+        return;
+    }
+    
+    SCOPE_CYCLE_COUNTER(STAT_TerrainUpdateLOD);
+    TRACE_CPUPROFILER_EVENT_SCOPE(ADestructibleTerrain::UpdateLOD);
+    LLM_SCOPE_BYTAG(Terrain_LOD);
+    
+    UTerrainLODSubsystem* LODSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UTerrainLODSubsystem>() : nullptr;
+    if (!LODSubsystem || LODSubsystem->GetViewLocations().Num() == 0)
+    {
+        return;
+    }
+    
+    // Seules les caméras locales comptent : le LOD n'est jamais partagé entre machines
+    TArray<FVector> LocalViews;
+    for (const FVector& ViewLocation : LODSubsystem->GetViewLocations())
+    {
+        LocalViews.Add(GetActorTransform().InverseTransformPosition(ViewLocation));
+    }
+    
+    SyncGridSettings();
+    
+    // Le mesh complet reste la référence pour les collisions, mais n'est plus dessiné
+    TerrainMesh->SetMeshSectionVisible(0, false);
+    
+    const FVector2D Step = GetGridStep();
+    const int32 LevelCount = FMath::Clamp(LODLevelCount, 1, 6);
+    
+    int32 RebuiltSections = 0;
+    int32 SwitchedSections = 0;
+    
+    FIntPoint SectionCount = GetSectionCount();
+    for (int32 y = 0; y < SectionCount.Y; ++y)
+    {
+        for (int32 x = 0; x < SectionCount.X; ++x)
+        {
+            FIntPoint SectionCoord(x, y);
+            FTerrainSectionLODChain& Chain = SectionLODChains.FindOrAdd(SectionCoord);
+            const int32 PreviousLevel = Chain.CurrentLevel;
+            
+            // Les niveaux ne sont recalculés que pour les sections touchées par une modification
+            if (Chain.bDirty || Chain.Levels.Num() != LevelCount)
+            {
+#if !UE_BUILD_SHIPPING
+                const uint64 BuildStartCycle = FPlatformTime::Cycles64();
+#endif
+                BuildSectionLODChain(SectionCoord, Chain);
+                RebuiltSections++;
+#if !UE_BUILD_SHIPPING
+                AddSectionRebuildCycles(SectionCoord, FPlatformTime::Cycles64() - BuildStartCycle);
+#endif
+            }
+            
+            FIntPoint Min, Max;
+            GetSectionCellRange(SectionCoord, Min, Max);
+            FBox SectionBounds(
+                FVector(Min.X * Step.X, 0.0f, Min.Y * Step.Y),
+                FVector(Max.X * Step.X, TerrainDepth, Max.Y * Step.Y));
+            
+            // Le point de vue le plus proche décide (écran partagé)
+            float DistanceSquared = TNumericLimits<float>::Max();
+            for (const FVector& LocalView : LocalViews)
+            {
+                DistanceSquared = FMath::Min(DistanceSquared, (float)SectionBounds.ComputeSquaredDistanceToPoint(LocalView));
+            }
+            float Distance = FMath::Sqrt(DistanceSquared);
+            int32 Level = SelectSectionLODLevel(Distance, PreviousLevel);
+            
+            if (Level != Chain.CurrentLevel)
+            {
+                UploadSectionLOD(SectionCoord, Chain, Level);
+                SwitchedSections++;
+            }
+        }
+    }
+    
+    if (RebuiltSections > 0 || SwitchedSections > 0)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Terrain LOD updated: %d sections rebuilt, %d sections switched"), 
+            RebuiltSections, SwitchedSections);
+    }
+}
+
+void ADestructibleTerrain::BuildSectionLODChain(const FIntPoint& SectionCoord, FTerrainSectionLODChain& OutChain) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(ADestructibleTerrain::BuildSectionLODChain);
+    
+    const int32 LevelCount = FMath::Clamp(LODLevelCount, 1, 6);
+    const int32 MinLevel = GetMinLODLevel();
+    
+    OutChain.Levels.SetNum(LevelCount);
+    for (int32 Level = 0; Level < LevelCount; ++Level)
+    {
+        // Les niveaux sacrifiés au budget mémoire restent vides
+        if (Level < MinLevel)
+        {
+            OutChain.Levels[Level] = FTerrainMeshData();
+            continue;
+        }
+        BuildSectionLODMesh(SectionCoord, 1 << Level, OutChain.Levels[Level]);
+    }
+    
+    // Forcer le renvoi du niveau courant, son contenu a changé
+    OutChain.CurrentLevel = INDEX_NONE;
+    OutChain.bDirty = false;
+}
+
+void ADestructibleTerrain::BuildSectionLODMesh(const FIntPoint& SectionCoord, int32 Stride, FTerrainMeshData& OutMeshData) const
+{
+    OutMeshData = FTerrainMeshData();
+    
+    FIntPoint Min, Max;
+    GetSectionCellRange(SectionCoord, Min, Max);
+    if (Max.X <= Min.X || Max.Y <= Min.Y)
+    {
+        return;
+    }
+    
+    // Colonnes et lignes de la grille conservées à ce niveau ; les bords de section sont toujours gardés
+    TArray<int32> Columns;
+    TArray<int32> Rows;
+    for (int32 x = Min.X; x < Max.X; x += Stride)
+    {
+        Columns.Add(x);
+    }
+    Columns.Add(Max.X);
+    for (int32 y = Min.Y; y < Max.Y; y += Stride)
+    {
+        Rows.Add(y);
+    }
+    Rows.Add(Max.Y);
+    
+    const int32 NumColumns = Columns.Num();
+    const int32 NumRows = Rows.Num();
+    const int32 VerticesPerLayer = NumColumns * NumRows;
+    const FVector2D Step = GetGridStep();
+    
+    // Couches : face avant, face arrière puis couches internes (mêmes profondeurs que GenerateInternalStructure)
+    const bool bInternal = bGenerateInternalStructure && InternalLayerCount > 0;
+    const int32 LayerCount = 2 + (bInternal ? InternalLayerCount : 0);
+    const float LayerDepth = bInternal ? (TerrainDepth - 2 * InternalLayerThickness) / InternalLayerCount : 0.0f;
+    
+    OutMeshData.Vertices.SetNumUninitialized(LayerCount * VerticesPerLayer);
+    OutMeshData.VertexColors.SetNumUninitialized(LayerCount * VerticesPerLayer);
+    
+    for (int32 Layer = 0; Layer < LayerCount; ++Layer)
+    {
+        const int32 InternalIndex = Layer - 2;
+        const float LayerY = Layer == 0 ? 0.0f : (Layer == 1 ? TerrainDepth : InternalLayerThickness + InternalIndex * LayerDepth);
+        
+        FLinearColor BaseColor(0.5f, 0.25f, 0.0f, 1.0f);
+        if (InternalIndex >= 0 && InternalLayerColors.Num() > 0)
+        {
+            BaseColor = InternalLayerColors.IsValidIndex(InternalIndex) ? InternalLayerColors[InternalIndex] : InternalLayerColors[0];
+        }
+        
+        for (int32 r = 0; r < NumRows; ++r)
+        {
+            for (int32 c = 0; c < NumColumns; ++c)
+            {
+                const int32 VertexIndex = Layer * VerticesPerLayer + r * NumColumns + c;
+                OutMeshData.Vertices[VertexIndex] = FVector(Columns[c] * Step.X, LayerY, Rows[r] * Step.Y);
+                
+                if (InternalIndex < 0)
+                {
+                    OutMeshData.VertexColors[VertexIndex] = FColor(75, 150, 75, 255);
+                    continue;
+                }
+                
+                // Variation déterministe : une section reconstruite garde les mêmes couleurs
+                FLinearColor LayerColor = BaseColor;
+                const float ColorVariation = (GetTypeHash(FIntVector(Columns[c], Rows[r], InternalIndex)) % 2001) / 10000.0f - 0.1f;
+                LayerColor.R = FMath::Clamp(LayerColor.R + ColorVariation, 0.0f, 1.0f);
+                LayerColor.G = FMath::Clamp(LayerColor.G + ColorVariation, 0.0f, 1.0f);
+                LayerColor.B = FMath::Clamp(LayerColor.B + ColorVariation, 0.0f, 1.0f);
+                OutMeshData.VertexColors[VertexIndex] = LayerColor.ToFColor(true);
+            }
+        }
+    }
+    
+    // Une portion de grille simplifiée n'est gardée que si aucun vertex fin qu'elle recouvre n'est détruit :
+    // un cratère plus petit que le pas du niveau agrandit le trou au lieu de disparaître
+    auto IsRangeIntact = [this](int32 X0, int32 X1, int32 Y0, int32 Y1)
+    {
+        for (int32 y = Y0; y <= Y1; ++y)
+        {
+            for (int32 x = X0; x <= X1; ++x)
+            {
+                if (IsGridVertexCarved(x, y))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    
+    auto IsCarved = [&](int32 c, int32 r)
+    {
+        return IsGridVertexCarved(Columns[c], Rows[r]);
+    };
+    
+    TArray<int32>& Triangles = OutMeshData.Triangles;
+    
+    for (int32 r = 0; r < NumRows - 1; ++r)
+    {
+        for (int32 c = 0; c < NumColumns - 1; ++c)
+        {
+            // Au niveau 0, même règle par triangle que le mesh complet
+            if (Stride > 1 && !IsRangeIntact(Columns[c], Columns[c + 1], Rows[r], Rows[r + 1]))
+            {
+                continue;
+            }
+            
+            const bool bFirstAlive = !IsCarved(c, r) && !IsCarved(c, r + 1) && !IsCarved(c + 1, r);
+            const bool bSecondAlive = !IsCarved(c + 1, r) && !IsCarved(c, r + 1) && !IsCarved(c + 1, r + 1);
+            
+            for (int32 Layer = 0; Layer < LayerCount; ++Layer)
+            {
+                const int32 Current = Layer * VerticesPerLayer + r * NumColumns + c;
+                const int32 Next = Current + 1;
+                const int32 Bottom = Current + NumColumns;
+                const int32 BottomNext = Bottom + 1;
+                
+                // Mêmes orientations que GenerateTerrain() et GenerateInternalStructure()
+                if (bFirstAlive)
+                {
+                    if (Layer == 0)
+                    {
+                        Triangles.Append({ Current, Bottom, Next });
+                    }
+                    else if (Layer == 1)
+                    {
+                        Triangles.Append({ Next, Bottom, Current });
+                    }
+                    else
+                    {
+                        Triangles.Append({ Current, Next, Bottom });
+                    }
+                }
+                
+                if (bSecondAlive)
+                {
+                    if (Layer == 0)
+                    {
+                        Triangles.Append({ Next, Bottom, BottomNext });
+                    }
+                    else if (Layer == 1)
+                    {
+                        Triangles.Append({ BottomNext, Bottom, Next });
+                    }
+                    else
+                    {
+                        Triangles.Append({ Next, BottomNext, Bottom });
+                    }
+                }
+            }
+        }
+    }
+    
+    // Faces latérales, uniquement quand la section touche le bord du terrain
+    auto Front = [&](int32 c, int32 r) { return r * NumColumns + c; };
+    auto Back = [&](int32 c, int32 r) { return VerticesPerLayer + r * NumColumns + c; };
+    
+    if (Min.Y == 0)
+    {
+        for (int32 c = 0; c < NumColumns - 1; ++c)
+        {
+            if (IsRangeIntact(Columns[c], Columns[c + 1], 0, 0))
+            {
+                Triangles.Append({ Front(c, 0), Front(c + 1, 0), Back(c, 0) });
+                Triangles.Append({ Back(c, 0), Front(c + 1, 0), Back(c + 1, 0) });
+            }
+        }
+    }
+    
+    if (Max.Y == VerticalResolution - 1)
+    {
+        const int32 r = NumRows - 1;
+        for (int32 c = 0; c < NumColumns - 1; ++c)
+        {
+            if (IsRangeIntact(Columns[c], Columns[c + 1], Max.Y, Max.Y))
+            {
+                Triangles.Append({ Front(c + 1, r), Front(c, r), Back(c, r) });
+                Triangles.Append({ Back(c + 1, r), Front(c + 1, r), Back(c, r) });
+            }
+        }
+    }
+    
+    if (Min.X == 0)
+    {
+        for (int32 r = 0; r < NumRows - 1; ++r)
+        {
+            if (IsRangeIntact(0, 0, Rows[r], Rows[r + 1]))
+            {
+                Triangles.Append({ Front(0, r), Back(0, r), Front(0, r + 1) });
+                Triangles.Append({ Front(0, r + 1), Back(0, r), Back(0, r + 1) });
+            }
+        }
+    }
+    
+    if (Max.X == HorizontalResolution - 1)
+    {
+        const int32 c = NumColumns - 1;
+        for (int32 r = 0; r < NumRows - 1; ++r)
+        {
+            if (IsRangeIntact(Max.X, Max.X, Rows[r], Rows[r + 1]))
+            {
+                Triangles.Append({ Back(c, r), Front(c, r), Front(c, r + 1) });
+                Triangles.Append({ Back(c, r + 1), Back(c, r), Front(c, r + 1) });
+            }
+        }
+    }
+    
+    // Normales par gather, avec la même convention que le mesh complet
+    FTerrainMeshTopology SectionTopology;
+    SectionTopology.Build(Triangles, OutMeshData.Vertices.Num());
+    OutMeshData.Normals.SetNumUninitialized(OutMeshData.Vertices.Num());
+    SectionTopology.ComputeVertexNormals(OutMeshData.Vertices, OutMeshData.Normals, 0, OutMeshData.Vertices.Num());
+    
+    // Les jupes reprennent les normales des faces et ne participent donc pas au calcul ci-dessus
+    AddSectionSkirts(Min, Max, Columns, Rows, Stride, OutMeshData);
+    
+    OutMeshData.bIsValid = true;
+}
+
+void ADestructibleTerrain::AddSectionSkirts(const FIntPoint& Min, const FIntPoint& Max, const TArray<int32>& Columns, const TArray<int32>& Rows, int32 Stride, FTerrainMeshData& InOutMeshData) const
+{
+    const float SkirtDepth = FMath::Min(LODSkirtDepth, TerrainDepth * 0.5f);
+    if (SkirtDepth <= 0.0f)
+    {
+        return;
+    }
+    
+    const int32 NumColumns = Columns.Num();
+    const int32 NumRows = Rows.Num();
+    const int32 VerticesPerLayer = NumColumns * NumRows;
+    
+    // Bords partagés avec une section voisine (les bords du terrain ont déjà leurs faces latérales)
+    struct FSkirtEdge
+    {
+        FIntPoint Start;   // (colonne, ligne) locale du premier vertex
+        FIntPoint Dir;     // Avancée le long du bord
+        int32 Count;       // Nombre de vertices du bord
+    };
+    
+    TArray<FSkirtEdge, TInlineAllocator<4>> Edges;
+    if (Min.X > 0)
+    {
+        Edges.Add({ FIntPoint(0, 0), FIntPoint(0, 1), NumRows });
+    }
+    if (Max.X < HorizontalResolution - 1)
+    {
+        Edges.Add({ FIntPoint(NumColumns - 1, 0), FIntPoint(0, 1), NumRows });
+    }
+    if (Min.Y > 0)
+    {
+        Edges.Add({ FIntPoint(0, 0), FIntPoint(1, 0), NumColumns });
+    }
+    if (Max.Y < VerticalResolution - 1)
+    {
+        Edges.Add({ FIntPoint(0, NumRows - 1), FIntPoint(1, 0), NumColumns });
+    }
+    
+    for (const FSkirtEdge& Edge : Edges)
+    {
+        for (int32 i = 0; i < Edge.Count - 1; ++i)
+        {
+            const FIntPoint A = Edge.Start + Edge.Dir * i;
+            const FIntPoint B = A + Edge.Dir;
+            
+            // Pas de jupe le long d'un segment détruit (même règle que les cellules du niveau)
+            bool bIntact = true;
+            for (int32 y = Rows[A.Y]; y <= Rows[B.Y] && bIntact; ++y)
+            {
+                for (int32 x = Columns[A.X]; x <= Columns[B.X] && bIntact; ++x)
+                {
+                    bIntact = !IsGridVertexCarved(x, y);
+                }
+            }
+            if (!bIntact)
+            {
+                continue;
+            }
+            
+            // Une jupe sous la face avant (vers l'intérieur) et une sous la face arrière
+            for (int32 Layer = 0; Layer < 2; ++Layer)
+            {
+                const int32 SourceA = Layer * VerticesPerLayer + A.Y * NumColumns + A.X;
+                const int32 SourceB = Layer * VerticesPerLayer + B.Y * NumColumns + B.X;
+                const FVector Offset(0.0f, Layer == 0 ? SkirtDepth : -SkirtDepth, 0.0f);
+                
+                const int32 SkirtA = InOutMeshData.Vertices.Num();
+                const int32 SkirtB = SkirtA + 1;
+                for (int32 Source : { SourceA, SourceB })
+                {
+                    InOutMeshData.Vertices.Add(InOutMeshData.Vertices[Source] + Offset);
+                    InOutMeshData.Normals.Add(InOutMeshData.Normals[Source]);
+                    InOutMeshData.VertexColors.Add(InOutMeshData.VertexColors[Source]);
+                }
+                
+                // Jupe visible des deux côtés : l'orientation du bord dépend de la section
+                InOutMeshData.Triangles.Append({ SourceA, SourceB, SkirtA, SkirtA, SourceB, SkirtB });
+                InOutMeshData.Triangles.Append({ SkirtA, SourceB, SourceA, SkirtB, SourceB, SkirtA });
+            }
+        }
+    }
+}
+
+int32 ADestructibleTerrain::SelectSectionLODLevel(float Distance, int32 CurrentLevel) const
+{
+    const float LevelDistance = FMath::Max(LODDistanceThreshold, 1.0f);
+    const int32 LevelCount = FMath::Clamp(LODLevelCount, 1, 6);
+    const int32 MinLevel = GetMinLODLevel();
+    const int32 TargetLevel = FMath::Clamp(FMath::FloorToInt(Distance / LevelDistance), MinLevel, LevelCount - 1);
+    
+    if (CurrentLevel == INDEX_NONE || CurrentLevel < MinLevel || TargetLevel == CurrentLevel)
+    {
+        return TargetLevel;
+    }
+    
+    // Ne changer de niveau qu'une fois la frontière franchie d'une marge suffisante
+    const float Margin = LevelDistance * FMath::Clamp(LODHysteresis, 0.0f, 0.5f);
+    if (TargetLevel > CurrentLevel)
+    {
+        const float Boundary = (CurrentLevel + 1) * LevelDistance;
+        return Distance > Boundary + Margin ? TargetLevel : CurrentLevel;
+    }
+    
+    const float Boundary = CurrentLevel * LevelDistance;
+    return Distance < Boundary - Margin ? TargetLevel : CurrentLevel;
+}
+
+void ADestructibleTerrain::UploadSectionLOD(const FIntPoint& SectionCoord, FTerrainSectionLODChain& Chain, int32 Level)
+{
+    const int32 RenderIndex = GetSectionRenderIndex(SectionCoord);
+    Chain.CurrentLevel = Level;
+    
+    const FTerrainMeshData& LevelData = Chain.Levels[Level];
+    if (LevelData.Triangles.Num() == 0)
+    {
+        // Section entièrement détruite
+        TerrainLODMesh->ClearMeshSection(RenderIndex);
+        return;
+    }
+    
+    TArray<FVector2D> UVs;
+    TArray<FProcMeshTangent> Tangents;
+    BuildRenderAttributes(LevelData.Vertices, UVs, Tangents);
+    
+    TerrainLODMesh->CreateMeshSection_LinearColor(
+        RenderIndex,
+        LevelData.Vertices,
+        LevelData.Triangles,
+        LevelData.Normals,
+        UVs,
+        ConvertColorsToLinear(LevelData.VertexColors),
+        Tangents,
+        false  // Les collisions restent portées par TerrainMesh
+    );
+    
+    TerrainLODMesh->SetMaterial(RenderIndex, TerrainMesh->GetMaterial(0));
+}
+
+FVector2D ADestructibleTerrain::GetGridStep() const
+{
+    return Grid.GetStep();
+}
+
+FTerrainGridSettings ADestructibleTerrain::MakeGridSettings() const
+{
+    FTerrainGridSettings Settings;
+    Settings.ResolutionX = HorizontalResolution;
+    Settings.ResolutionY = VerticalResolution;
+    Settings.Width = TerrainWidth;
+    Settings.Height = TerrainHeight;
+    Settings.Depth = TerrainDepth;
+    Settings.bUseSections = bUseTerrainSections;
+    Settings.SectionSizeX = SectionSizeX;
+    Settings.SectionSizeY = SectionSizeY;
+    return Settings;
+}
+
+void ADestructibleTerrain::SyncGridSettings()
+{
+    // Les clients n'appellent jamais GenerateTerrain(), le masque est donc créé à la demande
+    if (Grid.GetCarvedMask().Num() != FMath::Max(HorizontalResolution, 2) * FMath::Max(VerticalResolution, 2))
+    {
+        ResetCarvedVertices();
+    }
+    else if (Grid.GetSettings() != MakeGridSettings())
+    {
+        Grid.SetSettings(MakeGridSettings());
+    }
+}
+
+void ADestructibleTerrain::ResetCarvedVertices()
+{
+    Grid.SetSettings(MakeGridSettings());
+    Grid.Reset();
+    
+    // Le masque vierge doit recevoir à nouveau les modifications repliées
+    bCoveragePending = CompactedCoverage.FoldedCount > 0;
+    
+    // Une régénération repart d'une chronologie vide et met fin à l'affichage d'un état passé
+    Timeline.Reset();
+    if (bTimelineRewound)
+    {
+        bTimelineRewound = false;
+        TerrainMesh->SetMeshSectionVisible(0, true);
+    }
+    
+#if !UE_BUILD_SHIPPING
+    SectionDebugStats.Empty();
+#endif
+    
+    // Les collisions simples et les LOD dérivent du masque : tout doit être reconstruit
+    SectionCollisionBoxes.Empty();
+    DirtyCollisionSections.Empty();
+    ResetLODSections();
+    NavGraph.Reset();
+    DirtyNavSections.Empty();
+    PendingNavDirtySections.Empty();
+    
+    if (Minimap)
+    {
+        Minimap->MarkAllDirty();
+    }
+    
+    if (SurfaceProps)
+    {
+        SurfaceProps->MarkAllDirty();
+    }
+}
+
+void ADestructibleTerrain::CarveVertices(const FTerrainModification& Modification, TArray<int32>* OutNewlyCarved)
+{
+    SyncGridSettings();
+    
+    FIntPoint MinSection, MaxSection;
+    if (!Grid.CarveRect(Modification.Position, Modification.Size, OutNewlyCarved, MinSection, MaxSection))
+    {
+        return;
+    }
+    
+    // Vertices couverts par le rectangle (mêmes bornes que CarveRect), puis les cellules qui les entourent
+    const FVector2D Step = Grid.GetStep();
+    const FIntPoint MaxCellIndex(Grid.GetCellCountX() - 1, Grid.GetCellCountY() - 1);
+    FIntRect CarvedCells;
+    CarvedCells.Min = FIntPoint(FMath::FloorToInt(Modification.Position.X / Step.X) - 1,
+        FMath::FloorToInt(Modification.Position.Y / Step.Y) - 1).ComponentMax(FIntPoint::ZeroValue);
+    CarvedCells.Max = FIntPoint(FMath::CeilToInt((Modification.Position.X + Modification.Size.X) / Step.X),
+        FMath::CeilToInt((Modification.Position.Y + Modification.Size.Y) / Step.Y)).ComponentMin(MaxCellIndex);
+    
+    MarkCarvedSectionsDirty(MinSection, MaxSection, &CarvedCells);
+}
+
+void ADestructibleTerrain::MarkCarvedSectionsDirty(const FIntPoint& MinSection, const FIntPoint& MaxSection, const FIntRect* CarvedCells)
+{
+    // Sections du dessous dont les portions peuvent gagner ou perdre de la place pour l'agent (dégagement et sauts)
+    const int32 NavSectionsBelow = bUseTerrainSections && SectionSizeY > 0.0f ?
+        FMath::Max(1, FMath::CeilToInt(NavAgentHeight / SectionSizeY)) : 1;
+    
+    for (int32 y = MinSection.Y; y <= MaxSection.Y; ++y)
+    {
+        for (int32 x = MinSection.X; x <= MaxSection.X; ++x)
+        {
+            DirtyCollisionSections.Add(FIntPoint(x, y));
+            
+#if !UE_BUILD_SHIPPING
+            // Nouvelle reconstruction : son coût repart de zéro
+            FTerrainSectionDebugStats& Stats = SectionDebugStats.FindOrAdd(FIntPoint(x, y));
+            Stats.RebuildCount++;
+            Stats.LastRebuildCycles = 0;
+#endif
+            
+            if (FTerrainSectionLODChain* Chain = SectionLODChains.Find(FIntPoint(x, y)))
+            {
+                Chain->bDirty = true;
+            }
+            
+            // Les sections du dessous peuvent perdre ou gagner des surfaces dégagées ou des sauts
+            for (int32 Below = 0; Below <= NavSectionsBelow; ++Below)
+            {
+                DirtyNavSections.Add(FIntPoint(x, FMath::Max(y - Below, 0)));
+            }
+            PendingNavDirtySections.Add(FIntPoint(x, y));
+        }
+    }
+    
+    ScheduleNavDirtyFlush();
+    
+    if (Minimap)
+    {
+        if (CarvedCells)
+        {
+            Minimap->MarkCellsDirty(CarvedCells->Min, CarvedCells->Max);
+        }
+        else
+        {
+            FIntPoint MinCell, MaxCell, Unused;
+            GetSectionCellRange(MinSection, MinCell, Unused);
+            GetSectionCellRange(MaxSection, Unused, MaxCell);
+            Minimap->MarkCellsDirty(MinCell, MaxCell - FIntPoint(1, 1));
+        }
+    }
+    
+    if (SurfaceProps)
+    {
+        SurfaceProps->MarkSectionsDirty(MinSection, MaxSection);
+    }
+}
+
+bool ADestructibleTerrain::IsGridVertexCarved(int32 X, int32 Y) const
+{
+    return Grid.IsVertexCarved(X, Y);
+}
+
+bool ADestructibleTerrain::IsCellSolid(int32 X, int32 Y) const
+{
+    return Grid.IsCellSolid(X, Y);
+}
+
+FIntPoint ADestructibleTerrain::GetSectionForCell(int32 X, int32 Y) const
+{
+    return Grid.GetSectionForCell(X, Y);
+}
+
+FIntPoint ADestructibleTerrain::GetSectionCount() const
+{
+    return Grid.GetSectionCount();
+}
+
+void ADestructibleTerrain::GetSectionCellRange(const FIntPoint& SectionCoord, FIntPoint& OutMin, FIntPoint& OutMax) const
+{
+    Grid.GetSectionCellRange(SectionCoord, OutMin, OutMax);
+}
+
+void ADestructibleTerrain::BuildSectionCollisionBoxes(const FIntPoint& SectionCoord, TArray<FBox>& OutBoxes) const
+{
+    FIntPoint Min, Max;
+    GetSectionCellRange(SectionCoord, Min, Max);
+    
+    int32 RangeX = Max.X - Min.X;
+    int32 RangeY = Max.Y - Min.Y;
+    if (RangeX <= 0 || RangeY <= 0)
+    {
+        return;
+    }
+    
+    FVector2D Step = GetGridStep();
+    TBitArray<> Consumed(false, RangeX * RangeY);
+    
+    auto IsFree = [&](int32 X, int32 Y)
+    {
+        return !Consumed[(Y - Min.Y) * RangeX + (X - Min.X)] && IsCellSolid(X, Y);
+    };
+    
+    // Fusion gloutonne des cellules pleines en rectangles : une boîte par bande continue
+    for (int32 y = Min.Y; y < Max.Y; ++y)
+    {
+        for (int32 x = Min.X; x < Max.X; ++x)
+        {
+            if (!IsFree(x, y))
+            {
+                continue;
+            }
+            
+            // Étendre le rectangle en X
+            int32 EndX = x + 1;
+            while (EndX < Max.X && IsFree(EndX, y))
+            {
+                ++EndX;
+            }
+            
+            // Étendre le rectangle en Z tant que la ligne complète est pleine
+            int32 EndY = y + 1;
+            while (EndY < Max.Y)
+            {
+                bool bRowSolid = true;
+                for (int32 cx = x; cx < EndX; ++cx)
+                {
+                    if (!IsFree(cx, EndY))
+                    {
+                        bRowSolid = false;
+                        break;
+                    }
+                }
+                
+                if (!bRowSolid)
+                {
+                    break;
+                }
+                ++EndY;
+            }
+            
+            for (int32 cy = y; cy < EndY; ++cy)
+            {
+                for (int32 cx = x; cx < EndX; ++cx)
+                {
+                    Consumed[(cy - Min.Y) * RangeX + (cx - Min.X)] = true;
+                }
+            }
+            
+            // La boîte traverse toute la profondeur du terrain
+            OutBoxes.Add(FBox(
+                FVector(x * Step.X, 0.0f, y * Step.Y),
+                FVector(EndX * Step.X, TerrainDepth, EndY * Step.Y)));
+        }
+    }
+}
+
+void ADestructibleTerrain::UpdateSimpleCollision()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(ADestructibleTerrain::UpdateSimpleCollision);
+    
+    if (!TerrainMesh)
+    {
+        return;
+    }
+    
+    SyncGridSettings();
+    
+    int32 RebuiltSections = 0;
+    int32 TotalBoxes = 0;
+    TArray<TArray<FVector>> ConvexMeshes;
+    
+    FIntPoint SectionCount = GetSectionCount();
+    for (int32 y = 0; y < SectionCount.Y; ++y)
+    {
+        for (int32 x = 0; x < SectionCount.X; ++x)
+        {
+            FIntPoint SectionCoord(x, y);
+            
+            // Ne reconstruire que les sections touchées depuis la dernière mise à jour
+            TArray<FBox>* Boxes = SectionCollisionBoxes.Find(SectionCoord);
+            if (!Boxes || DirtyCollisionSections.Contains(SectionCoord))
+            {
+#if !UE_BUILD_SHIPPING
+                const uint64 BuildStartCycle = FPlatformTime::Cycles64();
+#endif
+                Boxes = &SectionCollisionBoxes.FindOrAdd(SectionCoord);
+                Boxes->Reset();
+                BuildSectionCollisionBoxes(SectionCoord, *Boxes);
+                RebuiltSections++;
+#if !UE_BUILD_SHIPPING
+                AddSectionRebuildCycles(SectionCoord, FPlatformTime::Cycles64() - BuildStartCycle);
+#endif
+            }
+            
+            for (const FBox& Box : *Boxes)
+            {
+                TArray<FVector>& Convex = ConvexMeshes.AddDefaulted_GetRef();
+                Convex.Reserve(8);
+                for (int32 Corner = 0; Corner < 8; ++Corner)
+                {
+                    Convex.Add(FVector(
+                        (Corner & 1) ? Box.Max.X : Box.Min.X,
+                        (Corner & 2) ? Box.Max.Y : Box.Min.Y,
+                        (Corner & 4) ? Box.Max.Z : Box.Min.Z));
+                }
+            }
+            TotalBoxes += Boxes->Num();
+        }
+    }
+    
+    DirtyCollisionSections.Empty();
+    
+    // Boîtes inchangées : le corps déjà cuit reste valable
+    if (RebuiltSections > 0)
+    {
+        TerrainMesh->SetCollisionConvexMeshes(ConvexMeshes);
+    }
+    
+    UE_LOG(LogTemp, Verbose, TEXT("Simple collision updated: %d sections rebuilt, %d boxes total"), 
+        RebuiltSections, TotalBoxes);
+}
+
+FBox ADestructibleTerrain::GetCellBox(int32 X, int32 Y) const
+{
+    return Grid.GetCellBox(X, Y);
+}
+
+// Conversion d'un impact de la grille (repère local) en impact monde
+static void ToQueryHit(const FTransform& ActorTransform, const FTerrainGridHit& GridHit, FTerrainQueryHit& OutHit)
+{
+    OutHit.Time = GridHit.Time;
+    OutHit.Cell = GridHit.Cell;
+    OutHit.Location = ActorTransform.TransformPosition(GridHit.Location);
+    OutHit.Normal = ActorTransform.TransformVectorNoScale(GridHit.Normal);
+}
+
+bool ADestructibleTerrain::IsPointInsideTerrain(const FVector& WorldLocation) const
+{
+    return Grid.IsPointInside(GetActorTransform().InverseTransformPosition(WorldLocation));
+}
+
+bool ADestructibleTerrain::RaycastTerrain(const FVector& Start, const FVector& End, FTerrainQueryHit& OutHit) const
+{
+    const FTransform& ActorTransform = GetActorTransform();
+    
+    FTerrainGridHit GridHit;
+    if (!Grid.Raycast(ActorTransform.InverseTransformPosition(Start), ActorTransform.InverseTransformPosition(End), GridHit))
+    {
+        return false;
+    }
+    
+    ToQueryHit(ActorTransform, GridHit, OutHit);
+    return true;
+}
+
+void ADestructibleTerrain::AccumulateOcclusion(const FVector& Origin, TArrayView<const FVector> Targets, float OriginClearance,
+    TArrayView<float> InOutSolidLengths) const
+{
+    check(Targets.Num() == InOutSolidLengths.Num());
+    
+    // Une seule transformation de l'origine pour toutes les cibles
+    const FTransform& ActorTransform = GetActorTransform();
+    const FVector LocalOrigin = ActorTransform.InverseTransformPosition(Origin);
+    
+    for (int32 i = 0; i < Targets.Num(); ++i)
+    {
+        const float Distance = FVector::Dist(Origin, Targets[i]);
+        if (Distance <= OriginClearance)
+        {
+            continue;
+        }
+        
+        // Fraction du segment dans le terrain, convertie en longueur monde (indépendante de l'échelle de l'acteur)
+        const float SolidFraction = Grid.GetSolidFraction(LocalOrigin, ActorTransform.InverseTransformPosition(Targets[i]),
+            OriginClearance / Distance);
+        InOutSolidLengths[i] += SolidFraction * Distance;
+    }
+}
+
+bool ADestructibleTerrain::OverlapSphereLocal(const FVector& Center, float Radius, FVector* OutClosestPoint, FIntPoint* OutCell) const
+{
+    return Grid.OverlapSphere(Center, Radius, OutClosestPoint, OutCell);
+}
+
+bool ADestructibleTerrain::SweepSphereTerrain(const FVector& Start, const FVector& End, float Radius, FTerrainQueryHit& OutHit) const
+{
+    const FTransform& ActorTransform = GetActorTransform();
+    
+    FTerrainGridHit GridHit;
+    if (!Grid.SweepSphere(ActorTransform.InverseTransformPosition(Start), ActorTransform.InverseTransformPosition(End), Radius, GridHit))
+    {
+        return false;
+    }
+    
+    ToQueryHit(ActorTransform, GridHit, OutHit);
+    return true;
+}
+
+void ADestructibleTerrain::GetStandableSurfaceCells(float Clearance, TArray<FIntPoint>& OutCells) const
+{
+    Grid.GetStandableSurfaceCells(Clearance, OutCells);
+}
+
+FVector ADestructibleTerrain::GetSurfaceLocation(const FIntPoint& Cell, float Alpha) const
+{
+    const FVector2D Step = GetGridStep();
+    const FVector Local(
+        (Cell.X + FMath::Clamp(Alpha, 0.0f, 1.0f)) * Step.X,
+        TerrainDepth * 0.5f,
+        (Cell.Y + 1) * Step.Y);
+    
+    return GetActorTransform().TransformPosition(Local);
+}
+
+void ADestructibleTerrain::UpdateNavGraph()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(ADestructibleTerrain::UpdateNavGraph);
+    
+    SyncGridSettings();
+    
+    const bool bFullBuild = !NavGraph.IsBuilt();
+    const int32 DirtyCount = DirtyNavSections.Num();
+    
+    NavGraph.Update(*this, DirtyNavSections);
+    DirtyNavSections.Empty();
+    
+    if (bFullBuild || DirtyCount > 0)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Surface nav graph updated (%s, %d sections): %d spans"), 
+            bFullBuild ? TEXT("full") : TEXT("incremental"), DirtyCount, NavGraph.GetSpanCount());
+    }
+}
+
+bool ADestructibleTerrain::FindSurfacePath(const FVector& Start, const FVector& Goal, TArray<FVector>& OutPath)
+{
+    UpdateNavGraph();
+    
+    const FTransform& ActorTransform = GetActorTransform();
+    if (!NavGraph.FindPath(*this, ActorTransform.InverseTransformPosition(Start), ActorTransform.InverseTransformPosition(Goal), OutPath))
+    {
+        return false;
+    }
+    
+    for (FVector& Point : OutPath)
+    {
+        Point = ActorTransform.TransformPosition(Point);
+    }
+    return true;
+}
+
+FBox ADestructibleTerrain::GetSectionWorldBounds(const FIntPoint& SectionCoord) const
+{
+    FIntPoint Min, Max;
+    GetSectionCellRange(SectionCoord, Min, Max);
+    
+    FVector2D Step = GetGridStep();
+    FBox LocalBounds(
+        FVector(Min.X * Step.X, 0.0f, Min.Y * Step.Y),
+        FVector(Max.X * Step.X, TerrainDepth, Max.Y * Step.Y));
+    
+    return LocalBounds.TransformBy(GetActorTransform());
+}
+
+void ADestructibleTerrain::RebuildNavGeometry()
+{
+    UWorld* World = GetWorld();
+    if (!NavGeometry || !World || !FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+    {
+        return;
+    }
+    
+    PendingNavDirtySections.Empty();
+    NavGeometry->UpdateAllSections();
+    NavGeometry->UpdateBounds();
+    
+    // Seul cas où toute l'emprise du terrain est invalidée
+    FNavigationSystem::UpdateComponentData(*NavGeometry);
+}
+
+void ADestructibleTerrain::ScheduleNavDirtyFlush()
+{
+    UWorld* World = GetWorld();
+    if (bNavFlushScheduled || PendingNavDirtySections.Num() == 0 || !World)
+    {
+        return;
+    }
+    
+    // Sans système de navigation (clients), rien à invalider
+    if (!FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+    {
+        PendingNavDirtySections.Empty();
+        return;
+    }
+    
+    bNavFlushScheduled = true;
+    World->GetTimerManager().SetTimerForNextTick(this, &ADestructibleTerrain::FlushNavDirtySections);
+}
+
+void ADestructibleTerrain::FlushNavDirtySections()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(ADestructibleTerrain::FlushNavDirtySections);
+    
+    bNavFlushScheduled = false;
+    
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    if (!NavSys || !NavGeometry)
+    {
+        PendingNavDirtySections.Empty();
+        return;
+    }
+    
+    // Un lot limité par frame : la génération des tuiles (asynchrone) n'est jamais submergée d'un coup
+    TArray<FIntPoint> Batch;
+    for (auto It = PendingNavDirtySections.CreateIterator(); It && Batch.Num() < NavDirtySectionsPerFrame; ++It)
+    {
+        Batch.Add(*It);
+        It.RemoveCurrent();
+    }
+    
+    // Géométrie à jour avant que les tuiles ne la rassemblent
+    NavGeometry->UpdateSections(Batch);
+    
+    for (const FIntPoint& SectionCoord : Batch)
+    {
+        NavSys->AddDirtyArea(GetSectionWorldBounds(SectionCoord), ENavigationDirtyFlag::All);
+    }
+    
+    UE_LOG(LogTemp, Verbose, TEXT("Navmesh invalidated for %d terrain sections (%d pending)"), 
+        Batch.Num(), PendingNavDirtySections.Num());
+    
+    ScheduleNavDirtyFlush();
+}
+
+#if !UE_BUILD_SHIPPING
+void ADestructibleTerrain::AddSectionRebuildCycles(const FIntPoint& SectionCoord, uint64 Cycles)
+{
+    SectionDebugStats.FindOrAdd(SectionCoord).LastRebuildCycles += Cycles;
+}
+
+void ADestructibleTerrain::CountSectionTriangles(TMap<FIntPoint, int32>& OutCounts) const
+{
+    if (IsLODActive())
+    {
+        for (const TPair<FIntPoint, FTerrainSectionLODChain>& Pair : SectionLODChains)
+        {
+            const FTerrainSectionLODChain& Chain = Pair.Value;
+            if (Chain.Levels.IsValidIndex(Chain.CurrentLevel))
+            {
+                OutCounts.Add(Pair.Key, Chain.Levels[Chain.CurrentLevel].Triangles.Num() / 3);
+            }
+        }
+        return;
+    }
+    
+    // Mesh complet : chaque triangle compte pour la section qui contient son centre (faces et structure interne)
+    const FVector2D Step = GetGridStep();
+    const FIntPoint MaxCell(FMath::Max(HorizontalResolution - 2, 0), FMath::Max(VerticalResolution - 2, 0));
+    for (int32 i = 0; i + 2 < MeshData.Triangles.Num(); i += 3)
+    {
+        const FVector Center = (MeshData.Vertices[MeshData.Triangles[i]] + MeshData.Vertices[MeshData.Triangles[i + 1]] +
+            MeshData.Vertices[MeshData.Triangles[i + 2]]) / 3.0f;
+        const int32 CellX = FMath::Clamp(FMath::FloorToInt(Center.X / Step.X), 0, MaxCell.X);
+        const int32 CellY = FMath::Clamp(FMath::FloorToInt(Center.Z / Step.Y), 0, MaxCell.Y);
+        OutCounts.FindOrAdd(GetSectionForCell(CellX, CellY))++;
+    }
+}
+
+void ADestructibleTerrain::DrawSectionHeatmap(ETerrainSectionHeatmapMode Mode, float LifeTime) const
+{
+    UWorld* World = GetWorld();
+    if (!World || Mode == ETerrainSectionHeatmapMode::Off || !MeshData.bIsValid)
+    {
+        return;
+    }
+    
+    TMap<FIntPoint, int32> TriangleCounts;
+    CountSectionTriangles(TriangleCounts);
+    
+    auto GetSectionValue = [&](const FIntPoint& SectionCoord) -> double
+    {
+        const FTerrainSectionDebugStats* Stats = SectionDebugStats.Find(SectionCoord);
+        switch (Mode)
+        {
+        case ETerrainSectionHeatmapMode::RebuildCount:
+            return Stats ? Stats->RebuildCount : 0;
+        case ETerrainSectionHeatmapMode::RebuildCost:
+            return Stats ? FPlatformTime::ToMilliseconds64(Stats->LastRebuildCycles) : 0.0;
+        default:
+            return TriangleCounts.FindRef(SectionCoord);
+        }
+    };
+    
+    // Couleurs relatives à la section la plus chargée du terrain : vert (froid) à rouge (chaud)
+    const FIntPoint SectionCount = GetSectionCount();
+    double MaxValue = 0.0;
+    for (int32 y = 0; y < SectionCount.Y; ++y)
+    {
+        for (int32 x = 0; x < SectionCount.X; ++x)
+        {
+            MaxValue = FMath::Max(MaxValue, GetSectionValue(FIntPoint(x, y)));
+        }
+    }
+    
+    for (int32 y = 0; y < SectionCount.Y; ++y)
+    {
+        for (int32 x = 0; x < SectionCount.X; ++x)
+        {
+            const FIntPoint SectionCoord(x, y);
+            const FBox Bounds = GetSectionWorldBounds(SectionCoord);
+            const float Heat = MaxValue > 0.0 ? (float)(GetSectionValue(SectionCoord) / MaxValue) : 0.0f;
+            
+            FColor HeatColor = FLinearColor::LerpUsingHSV(FLinearColor::Green, FLinearColor::Red, Heat).ToFColor(true);
+            DrawDebugString(World, Bounds.GetCenter(), FString::Printf(TEXT("%d rebuilds\n%.2f ms\n%d tris"),
+                SectionDebugStats.FindRef(SectionCoord).RebuildCount,
+                FPlatformTime::ToMilliseconds64(SectionDebugStats.FindRef(SectionCoord).LastRebuildCycles),
+                TriangleCounts.FindRef(SectionCoord)), nullptr, HeatColor, LifeTime);
+            
+            HeatColor.A = 64;
+            DrawDebugSolidBox(World, Bounds, HeatColor, FTransform::Identity, false, LifeTime, SDPG_World);
+            
+            // En attente : collisions simples, chaîne de LOD ou navmesh pas encore reconstruites
+            const FTerrainSectionLODChain* Chain = SectionLODChains.Find(SectionCoord);
+            const bool bPending =
+                (CollisionMode == ETerrainCollisionMode::SimplePrimitives && DirtyCollisionSections.Contains(SectionCoord)) ||
+                (Chain && Chain->bDirty && Chain->Levels.Num() > 0) ||
+                PendingNavDirtySections.Contains(SectionCoord);
+            
+            DrawDebugBox(World, Bounds.GetCenter(), Bounds.GetExtent(), bPending ? FColor::Magenta : FColor::White,
+                false, LifeTime, SDPG_Foreground, bPending ? 4.0f : 1.0f);
+        }
+    }
+}
+#endif
+
+static int64 GetMeshDataAllocatedSize(const FTerrainMeshData& Data)
+{
+    return Data.Vertices.GetAllocatedSize() + Data.Triangles.GetAllocatedSize() +
+           Data.Normals.GetAllocatedSize() + Data.VertexColors.GetAllocatedSize();
+}
+
+static int64 GetProcMeshAllocatedSize(UProceduralMeshComponent* Mesh)
+{
+    int64 Size = 0;
+    if (Mesh)
+    {
+        for (int32 SectionIndex = 0; SectionIndex < Mesh->GetNumSections(); ++SectionIndex)
+        {
+            if (const FProcMeshSection* Section = Mesh->GetProcMeshSection(SectionIndex))
+            {
+                Size += Section->ProcVertexBuffer.GetAllocatedSize() + Section->ProcIndexBuffer.GetAllocatedSize();
+            }
+        }
+    }
+    return Size;
+}
+
+void ADestructibleTerrain::GetMemoryReport(FTerrainMemoryReport& OutReport) const
+{
+    OutReport = FTerrainMemoryReport();
+    
+    OutReport.MeshDataBytes = GetMeshDataAllocatedSize(MeshData);
+    
+    OutReport.TopologyBytes = Topology.GetAllocatedSize() + Grid.GetAllocatedSize();
+    
+    OutReport.InternalBytes = InternalVertices.GetAllocatedSize() + InternalTriangles.GetAllocatedSize() +
+        InternalNormals.GetAllocatedSize() + InternalVertexColors.GetAllocatedSize();
+    
+    OutReport.LODBytes = SectionLODChains.GetAllocatedSize();
+    for (const TPair<FIntPoint, FTerrainSectionLODChain>& Pair : SectionLODChains)
+    {
+        OutReport.LODBytes += Pair.Value.Levels.GetAllocatedSize();
+        for (const FTerrainMeshData& Level : Pair.Value.Levels)
+        {
+            OutReport.LODBytes += GetMeshDataAllocatedSize(Level);
+        }
+    }
+    
+    OutReport.RenderBytes = GetProcMeshAllocatedSize(TerrainMesh) + GetProcMeshAllocatedSize(TerrainLODMesh) +
+        (Minimap ? Minimap->GetAllocatedSize() : 0) + (SurfaceProps ? SurfaceProps->GetAllocatedSize() : 0);
+    
+    OutReport.CollisionBytes = SectionCollisionBoxes.GetAllocatedSize() + DirtyCollisionSections.GetAllocatedSize();
+    for (const TPair<FIntPoint, TArray<FBox>>& Pair : SectionCollisionBoxes)
+    {
+        OutReport.CollisionBytes += Pair.Value.GetAllocatedSize();
+    }
+    if (UBodySetup* BodySetup = TerrainMesh ? TerrainMesh->GetBodySetup() : nullptr)
+    {
+        OutReport.CollisionBytes += BodySetup->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+    }
+    
+    OutReport.NavigationBytes = NavGraph.GetAllocatedSize() + DirtyNavSections.GetAllocatedSize() +
+        PendingNavDirtySections.GetAllocatedSize() + (NavGeometry ? NavGeometry->GetAllocatedSize() : 0);
+    
+    OutReport.ModificationBytes = TerrainModifications.GetAllocatedSize() + AppliedModifications.GetAllocatedSize() +
+        SectionModifications.GetAllocatedSize() + JoinSnapshot.GetAllocatedSize() +
+        CompactedCoverage.Runs.GetAllocatedSize() + ReplicatedCoverage.GetAllocatedSize() + CoverageGrid.GetAllocatedSize() +
+        Timeline.GetAllocatedSize();
+    for (const TPair<FIntPoint, FTerrainModificationArray>& Pair : SectionModifications)
+    {
+        OutReport.ModificationBytes += Pair.Value.Modifications.GetAllocatedSize();
+    }
+}
+
+int32 ADestructibleTerrain::GetMinLODLevel() const
+{
+    const int32 LevelCount = FMath::Clamp(LODLevelCount, 1, 6);
+    return MemoryPressure >= ETerrainMemoryPressure::CoarseLOD ? FMath::Min(1, LevelCount - 1) : 0;
+}
+
+void ADestructibleTerrain::TrimMemory()
+{
+    // Les tampons de la structure interne ne servent qu'à la génération : ils sont déjà dans MeshData
+    InternalVertices.Empty();
+    InternalTriangles.Empty();
+    InternalNormals.Empty();
+    InternalVertexColors.Empty();
+    
+    // Marge laissée par les mises à jour incrémentales
+    MeshData.Vertices.Shrink();
+    MeshData.Triangles.Shrink();
+    MeshData.Normals.Shrink();
+    MeshData.VertexColors.Shrink();
+    Topology.Triangles.Shrink();
+    Topology.VertexTriangles.Shrink();
+    Topology.VertexTriangleOffsets.Shrink();
+    TerrainModifications.Shrink();
+    AppliedModifications.Shrink();
+}
+
+bool ADestructibleTerrain::IncreaseMemoryPressure()
+{
+    switch (MemoryPressure)
+    {
+    case ETerrainMemoryPressure::None:
+        MemoryPressure = ETerrainMemoryPressure::TrimBuffers;
+        TrimMemory();
+        break;
+        
+    case ETerrainMemoryPressure::TrimBuffers:
+        // Au-delà, la collision change : un client se limite aux niveaux de rendu et de tampons
+        if (!HasAuthority() && (!IsLODActive() || GetMinLODLevel() == 0))
+        {
+            return false;
+        }
+        
+        MemoryPressure = ETerrainMemoryPressure::CoarseLOD;
+        if (!IsLODActive() || GetMinLODLevel() == 0)
+        {
+            // Pas de LOD ici (serveur dédié) : rien à gagner, passer au niveau suivant
+            return IncreaseMemoryPressure();
+        }
+        
+        // Les chaînes sont reconstruites sans leur niveau le plus fin
+        for (TPair<FIntPoint, FTerrainSectionLODChain>& Pair : SectionLODChains)
+        {
+            Pair.Value.bDirty = true;
+        }
+        UpdateLOD();
+        break;
+        
+    case ETerrainMemoryPressure::CoarseLOD:
+        // La collision doit rester identique partout : seul le serveur la simplifie, les clients suivent par réplication
+        if (!HasAuthority())
+        {
+            return false;
+        }
+        
+        MemoryPressure = ETerrainMemoryPressure::SimpleCollision;
+        if (CollisionMode == ETerrainCollisionMode::SimplePrimitives)
+        {
+            return IncreaseMemoryPressure();
+        }
+        
+        // Le mesh complexe cuit est remplacé par les boîtes des sections
+        CollisionMode = ETerrainCollisionMode::SimplePrimitives;
+        if (MeshData.bIsValid)
+        {
+            CreateMeshFromData(MeshData);
+        }
+        break;
+        
+    case ETerrainMemoryPressure::SimpleCollision:
+        // Seul le serveur fait autorité sur la géométrie, les clients la reçoivent
+        if (!HasAuthority() || !bIsInitialized || !bGenerateInternalStructure || InternalLayerCount <= 0)
+        {
+            return false;
+        }
+        
+        MemoryPressure = ETerrainMemoryPressure::DropInternalLayers;
+        bGenerateInternalStructure = false;
+        
+        // Régénérer la grille sans couches internes, puis rejouer les modifications
+        GenerateTerrain();
+        AppliedModifications.Reset();
+        ApplyTerrainModifications();
+        break;
+        
+    default:
+        return false;
+    }
+    
+    UE_LOG(LogTemp, Warning, TEXT("%s: terrain memory pressure raised to %d"), *GetName(), (int32)MemoryPressure);
+    return true;
 }
@@ -0,0 +1,386 @@
+#include "DestructibleTerrainSubsystem.h"
+#include "ADestructibleTerrain.h"
+#include "VoxelTerrain.h"
+#include "TerrainMemory.h"
+#include "TerrainStats.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "TimerManager.h"
+
+#if !UE_BUILD_SHIPPING
+// Fréquence de rafraîchissement de la carte de chaleur des sections
+static const float SectionHeatmapInterval = 0.25f;
+#endif
+
+void UDestructibleTerrainSubsystem::Deinitialize()
+{
+#if !UE_BUILD_SHIPPING
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(SectionHeatmapTimerHandle);
+    }
+#endif
+    
+    TerrainBounds.Empty();
+    Cells.Empty();
+    VoxelTerrains.Empty();
+    
+    Super::Deinitialize();
+}
+
+void UDestructibleTerrainSubsystem::GetCellRange(const FBox& Box, FIntVector& OutMin, FIntVector& OutMax) const
+{
+    OutMin = FIntVector(
+        FMath::FloorToInt(Box.Min.X / CellSize),
+        FMath::FloorToInt(Box.Min.Y / CellSize),
+        FMath::FloorToInt(Box.Min.Z / CellSize));
+    OutMax = FIntVector(
+        FMath::FloorToInt(Box.Max.X / CellSize),
+        FMath::FloorToInt(Box.Max.Y / CellSize),
+        FMath::FloorToInt(Box.Max.Z / CellSize));
+}
+
+void UDestructibleTerrainSubsystem::RegisterTerrain(ADestructibleTerrain* Terrain)
+{
+    if (!Terrain)
+    {
+        return;
+    }
+    
+    FBox Bounds = Terrain->GetTerrainWorldBounds();
+    
+    // Un terrain déjà connu est retiré de ses anciennes cellules
+    if (const FBox* OldBounds = TerrainBounds.Find(Terrain))
+    {
+        if (OldBounds->Min == Bounds.Min && OldBounds->Max == Bounds.Max)
+        {
+            return;
+        }
+        RemoveFromCells(Terrain, *OldBounds);
+    }
+    
+    TerrainBounds.Add(Terrain, Bounds);
+    
+    FIntVector Min, Max;
+    GetCellRange(Bounds, Min, Max);
+    for (int32 z = Min.Z; z <= Max.Z; ++z)
+    {
+        for (int32 y = Min.Y; y <= Max.Y; ++y)
+        {
+            for (int32 x = Min.X; x <= Max.X; ++x)
+            {
+                Cells.FindOrAdd(FIntVector(x, y, z)).Add(Terrain);
+            }
+        }
+    }
+}
+
+void UDestructibleTerrainSubsystem::UnregisterTerrain(ADestructibleTerrain* Terrain)
+{
+    FBox Bounds;
+    if (TerrainBounds.RemoveAndCopyValue(Terrain, Bounds))
+    {
+        RemoveFromCells(Terrain, Bounds);
+    }
+}
+
+void UDestructibleTerrainSubsystem::RemoveFromCells(ADestructibleTerrain* Terrain, const FBox& Bounds)
+{
+    FIntVector Min, Max;
+    GetCellRange(Bounds, Min, Max);
+    for (int32 z = Min.Z; z <= Max.Z; ++z)
+    {
+        for (int32 y = Min.Y; y <= Max.Y; ++y)
+        {
+            for (int32 x = Min.X; x <= Max.X; ++x)
+            {
+                FIntVector Cell(x, y, z);
+                if (TArray<TWeakObjectPtr<ADestructibleTerrain>>* CellTerrains = Cells.Find(Cell))
+                {
+                    CellTerrains->RemoveAllSwap([Terrain](const TWeakObjectPtr<ADestructibleTerrain>& Entry)
+                    {
+                        return !Entry.IsValid() || Entry.Get() == Terrain;
+                    });
+                    
+                    if (CellTerrains->Num() == 0)
+                    {
+                        Cells.Remove(Cell);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void UDestructibleTerrainSubsystem::FindTerrainsInBox(const FBox& WorldBox, TArray<ADestructibleTerrain*>& OutTerrains) const
+{
+    FIntVector Min, Max;
+    GetCellRange(WorldBox, Min, Max);
+    
+    for (int32 z = Min.Z; z <= Max.Z; ++z)
+    {
+        for (int32 y = Min.Y; y <= Max.Y; ++y)
+        {
+            for (int32 x = Min.X; x <= Max.X; ++x)
+            {
+                const TArray<TWeakObjectPtr<ADestructibleTerrain>>* CellTerrains = Cells.Find(FIntVector(x, y, z));
+                if (!CellTerrains)
+                {
+                    continue;
+                }
+                
+                for (const TWeakObjectPtr<ADestructibleTerrain>& Entry : *CellTerrains)
+                {
+                    ADestructibleTerrain* Terrain = Entry.Get();
+                    if (!Terrain || OutTerrains.Contains(Terrain))
+                    {
+                        continue;
+                    }
+                    
+                    // Test précis sur les bornes, la cellule n'étant qu'un pré-filtre
+                    const FBox* Bounds = TerrainBounds.Find(Entry);
+                    if (Bounds && Bounds->Intersect(WorldBox))
+                    {
+                        OutTerrains.Add(Terrain);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void UDestructibleTerrainSubsystem::FindTerrainsInSphere(const FVector& Center, float Radius, TArray<ADestructibleTerrain*>& OutTerrains) const
+{
+    TArray<ADestructibleTerrain*> Candidates;
+    FindTerrainsInBox(FBox(Center - FVector(Radius), Center + FVector(Radius)), Candidates);
+    
+    for (ADestructibleTerrain* Terrain : Candidates)
+    {
+        if (TerrainBounds[Terrain].ComputeSquaredDistanceToPoint(Center) <= FMath::Square(Radius))
+        {
+            OutTerrains.Add(Terrain);
+        }
+    }
+}
+
+void UDestructibleTerrainSubsystem::RegisterVoxelTerrain(AVoxelTerrain* Terrain)
+{
+    if (Terrain)
+    {
+        VoxelTerrains.AddUnique(Terrain);
+    }
+}
+
+void UDestructibleTerrainSubsystem::UnregisterVoxelTerrain(AVoxelTerrain* Terrain)
+{
+    VoxelTerrains.RemoveAllSwap([Terrain](const TWeakObjectPtr<AVoxelTerrain>& Entry)
+    {
+        return !Entry.IsValid() || Entry.Get() == Terrain;
+    });
+}
+
+void UDestructibleTerrainSubsystem::FindVoxelTerrainsInSphere(const FVector& Center, float Radius, TArray<AVoxelTerrain*>& OutTerrains) const
+{
+    for (const TWeakObjectPtr<AVoxelTerrain>& Entry : VoxelTerrains)
+    {
+        AVoxelTerrain* Terrain = Entry.Get();
+        if (Terrain && Terrain->GetTerrainWorldBounds().ComputeSquaredDistanceToPoint(Center) <= FMath::Square(Radius))
+        {
+            OutTerrains.Add(Terrain);
+        }
+    }
+}
+
+bool UDestructibleTerrainSubsystem::RaycastTerrains(const FVector& Start, const FVector& End, FTerrainQueryHit& OutHit, ADestructibleTerrain** OutTerrain) const
+{
+    TArray<ADestructibleTerrain*> Candidates;
+    FindTerrainsInBox(FBox(Start.ComponentMin(End), Start.ComponentMax(End)), Candidates);
+    
+    bool bHit = false;
+    for (ADestructibleTerrain* Terrain : Candidates)
+    {
+        FTerrainQueryHit Hit;
+        if (Terrain->RaycastTerrain(Start, End, Hit) && (!bHit || Hit.Time < OutHit.Time))
+        {
+            OutHit = Hit;
+            bHit = true;
+            
+            if (OutTerrain)
+            {
+                *OutTerrain = Terrain;
+            }
+        }
+    }
+    
+    return bHit;
+}
+
+void UDestructibleTerrainSubsystem::GetTerrainOcclusion(const FVector& Origin, const TArray<FVector>& Targets, float OriginClearance, TArray<float>& OutSolidLengths) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_TerrainOcclusionQuery);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UDestructibleTerrainSubsystem::GetTerrainOcclusion);
+    
+    OutSolidLengths.Init(0.0f, Targets.Num());
+    if (Targets.Num() == 0)
+    {
+        return;
+    }
+    
+    // Seuls les terrains recoupant la boîte de tous les segments peuvent masquer une cible
+    FBox QueryBox(Origin, Origin);
+    for (const FVector& Target : Targets)
+    {
+        QueryBox += Target;
+    }
+    
+    TArray<ADestructibleTerrain*> Candidates;
+    FindTerrainsInBox(QueryBox, Candidates);
+    
+    for (ADestructibleTerrain* Terrain : Candidates)
+    {
+        Terrain->AccumulateOcclusion(Origin, Targets, OriginClearance, OutSolidLengths);
+    }
+}
+
+void UDestructibleTerrainSubsystem::GetAllTerrains(TArray<ADestructibleTerrain*>& OutTerrains) const
+{
+    for (const TPair<TWeakObjectPtr<ADestructibleTerrain>, FBox>& Pair : TerrainBounds)
+    {
+        if (ADestructibleTerrain* Terrain = Pair.Key.Get())
+        {
+            OutTerrains.Add(Terrain);
+        }
+    }
+}
+
+void UDestructibleTerrainSubsystem::EnforceMemoryBudget()
+{
+    const int64 BudgetBytes = (int64)GetTerrainMemoryBudgetMB() * 1024 * 1024;
+    if (BudgetBytes <= 0 || bEnforcingMemoryBudget)
+    {
+        return;
+    }
+    
+    TGuardValue<bool> EnforcingGuard(bEnforcingMemoryBudget, true);
+    
+    TArray<ADestructibleTerrain*> Terrains;
+    GetAllTerrains(Terrains);
+    
+    TArray<int64> TerrainBytes;
+    TerrainBytes.SetNumUninitialized(Terrains.Num());
+    int64 TotalBytes = 0;
+    for (int32 i = 0; i < Terrains.Num(); ++i)
+    {
+        FTerrainMemoryReport Report;
+        Terrains[i]->GetMemoryReport(Report);
+        TerrainBytes[i] = Report.GetTotalBytes();
+        TotalBytes += TerrainBytes[i];
+    }
+    
+    if (TotalBytes <= BudgetBytes)
+    {
+        return;
+    }
+    
+    UE_LOG(LogTemp, Warning, TEXT("Terrain memory (%lld KiB) exceeds the %d MiB budget, simplifying terrains"), 
+        TotalBytes / 1024, GetTerrainMemoryBudgetMB());
+    
+    // Le plus gros terrain encore simplifiable perd un niveau, puis on recompte
+    TBitArray<> Exhausted(false, Terrains.Num());
+    while (TotalBytes > BudgetBytes)
+    {
+        int32 Largest = INDEX_NONE;
+        for (int32 i = 0; i < Terrains.Num(); ++i)
+        {
+            if (!Exhausted[i] && (Largest == INDEX_NONE || TerrainBytes[i] > TerrainBytes[Largest]))
+            {
+                Largest = i;
+            }
+        }
+        
+        if (Largest == INDEX_NONE)
+        {
+            if (!bMemoryBudgetExhausted)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Terrain memory (%lld KiB) still exceeds the budget with every terrain fully simplified"), 
+                    TotalBytes / 1024);
+                bMemoryBudgetExhausted = true;
+            }
+            return;
+        }
+        
+        if (!Terrains[Largest]->IncreaseMemoryPressure())
+        {
+            Exhausted[Largest] = true;
+            continue;
+        }
+        
+        FTerrainMemoryReport Report;
+        Terrains[Largest]->GetMemoryReport(Report);
+        TotalBytes += Report.GetTotalBytes() - TerrainBytes[Largest];
+        TerrainBytes[Largest] = Report.GetTotalBytes();
+    }
+}
+
+#if !UE_BUILD_SHIPPING
+void UDestructibleTerrainSubsystem::SetSectionHeatmapMode(ETerrainSectionHeatmapMode Mode)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+    
+    SectionHeatmapMode = Mode;
+    
+    FTimerManager& TimerManager = World->GetTimerManager();
+    if (Mode == ETerrainSectionHeatmapMode::Off)
+    {
+        TimerManager.ClearTimer(SectionHeatmapTimerHandle);
+        return;
+    }
+    
+    if (!TimerManager.IsTimerActive(SectionHeatmapTimerHandle))
+    {
+        TimerManager.SetTimer(SectionHeatmapTimerHandle, this, &UDestructibleTerrainSubsystem::DrawSectionHeatmaps,
+            SectionHeatmapInterval, true, 0.0f);
+    }
+}
+
+void UDestructibleTerrainSubsystem::DrawSectionHeatmaps()
+{
+    TArray<ADestructibleTerrain*> Terrains;
+    GetAllTerrains(Terrains);
+    
+    // Chaque dessin dure jusqu'au suivant : pas de scintillement, et rien ne reste affiché après l'arrêt
+    for (ADestructibleTerrain* Terrain : Terrains)
+    {
+        Terrain->DrawSectionHeatmap(SectionHeatmapMode, SectionHeatmapInterval * 1.1f);
+    }
+}
+
+// Terrain.Debug.SectionHeatmap [0-3] : 0 arrêt, 1 nombre de reconstructions, 2 coût de la dernière, 3 triangles
+// Sans argument, bascule entre l'arrêt et le nombre de reconstructions
+static FAutoConsoleCommandWithWorldAndArgs TerrainSectionHeatmapCommand(
+    TEXT("Terrain.Debug.SectionHeatmap"),
+    TEXT("Colore les sections des terrains destructibles : 0 = arrêt, 1 = nombre de reconstructions, ")
+    TEXT("2 = coût de la dernière reconstruction, 3 = densité de triangles. Les sections en attente sont entourées en magenta."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UDestructibleTerrainSubsystem* TerrainSubsystem = World ? World->GetSubsystem<UDestructibleTerrainSubsystem>() : nullptr;
+        if (!TerrainSubsystem)
+        {
+            return;
+        }
+        
+        ETerrainSectionHeatmapMode Mode = TerrainSubsystem->GetSectionHeatmapMode() == ETerrainSectionHeatmapMode::Off
+            ? ETerrainSectionHeatmapMode::RebuildCount
+            : ETerrainSectionHeatmapMode::Off;
+        if (Args.Num() > 0)
+        {
+            Mode = (ETerrainSectionHeatmapMode)FMath::Clamp(FCString::Atoi(*Args[0]), 0, (int32)ETerrainSectionHeatmapMode::TriangleDensity);
+        }
+        
+        TerrainSubsystem->SetSectionHeatmapMode(Mode);
+    }));
+#endif
@@ -0,0 +1,386 @@
+#include "TerrainBenchmark.h"
+#include "ADestructibleTerrain.h"
+#include "TerrainMemory.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "Misc/AutomationTest.h"
+
+// Dimensions des terrains de test (celles du terrain par défaut)
+static const float BenchmarkTerrainWidth = 2000.0f;
+static const float BenchmarkTerrainHeight = 2000.0f;
+static const float BenchmarkTerrainDepth = 1000.0f;
+
+static double MedianMs(TArray<double>& Samples)
+{
+    if (Samples.Num() == 0)
+    {
+        return 0.0;
+    }
+    Samples.Sort();
+    return Samples[Samples.Num() / 2];
+}
+
+void FTerrainBenchmark::Run(UWorld* World, TArray<FTerrainBenchmarkResult>& OutResults) const
+{
+    OutResults.Reset();
+    if (!World || World->GetNetMode() == NM_Client)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Terrain benchmark needs a standalone or server world"));
+        return;
+    }
+
+    for (int32 Resolution : Resolutions)
+    {
+        RunResolution(World, FMath::Max(Resolution, 2), OutResults);
+    }
+}
+
+void FTerrainBenchmark::RunResolution(UWorld* World, int32 Resolution, TArray<FTerrainBenchmarkResult>& OutResults) const
+{
+    // Loin sous le niveau : les terrains temporaires ne recouvrent rien du jeu
+    const FTransform SpawnTransform(FVector(0.0f, 0.0f, -100000.0f));
+
+    ADestructibleTerrain* Terrain = World->SpawnActorDeferred<ADestructibleTerrain>(ADestructibleTerrain::StaticClass(), SpawnTransform);
+    if (!Terrain)
+    {
+        return;
+    }
+    Terrain->HorizontalResolution = Resolution;
+    Terrain->VerticalResolution = Resolution;
+    Terrain->FinishSpawning(SpawnTransform);
+
+    // Première génération (sections, registre spatial) hors mesure
+    Terrain->InitializeTerrain(BenchmarkTerrainWidth, BenchmarkTerrainHeight, BenchmarkTerrainDepth);
+
+    TArray<double> GenerateSamples;
+    for (int32 i = 0; i < FMath::Max(Repeats, 1); ++i)
+    {
+        const double Start = FPlatformTime::Seconds();
+        Terrain->GenerateTerrain();
+        GenerateSamples.Add((FPlatformTime::Seconds() - Start) * 1000.0);
+    }
+    const double GenerateMs = MedianMs(GenerateSamples);
+
+    for (int32 ModificationCount : ModificationCounts)
+    {
+        // Repartir d'un terrain intact, sans la couverture repliée du scénario précédent
+        Terrain->TerrainModifications.Reset();
+        Terrain->AppliedModifications.Reset();
+        Terrain->CompactedCoverage = FTerrainCompactedCoverage();
+        Terrain->ReplicatedCoverage.Reset();
+        Terrain->CoverageGrid.Reset();
+        Terrain->bCoveragePending = false;
+        for (TPair<FIntPoint, FTerrainModificationArray>& Pair : Terrain->SectionModifications)
+        {
+            Pair.Value.Modifications.Reset();
+        }
+        Terrain->GenerateTerrain();
+
+        // Séquence scriptée : explosions à des positions et rayons tirés d'une graine fixe
+        FRandomStream Stream(Seed + ModificationCount);
+        double ApplyTotalMs = 0.0;
+        double ApplyMaxMs = 0.0;
+        for (int32 i = 0; i < ModificationCount; ++i)
+        {
+            FVector2D Center(Stream.FRandRange(0.0f, BenchmarkTerrainWidth), Stream.FRandRange(0.0f, BenchmarkTerrainHeight));
+            const float Radius = Stream.FRandRange(40.0f, 150.0f);
+
+            // Même forme que les explosions du jeu (AWormsProjectile) : zone carrée centrée sur l'impact
+            Terrain->TerrainModifications.Add(FTerrainModification(Center - FVector2D(Radius, Radius), FVector2D(Radius * 2.0f, Radius * 2.0f)));
+
+            const double Start = FPlatformTime::Seconds();
+            Terrain->ApplyTerrainModifications();
+            const double ElapsedMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+            ApplyTotalMs += ElapsedMs;
+            ApplyMaxMs = FMath::Max(ApplyMaxMs, ElapsedMs);
+        }
+
+        TArray<double> CreateMeshSamples;
+        for (int32 i = 0; i < FMath::Max(Repeats, 1); ++i)
+        {
+            const double Start = FPlatformTime::Seconds();
+            Terrain->CreateMeshFromData(Terrain->MeshData);
+            CreateMeshSamples.Add((FPlatformTime::Seconds() - Start) * 1000.0);
+        }
+
+        FTerrainMemoryReport MemoryReport;
+        Terrain->GetMemoryReport(MemoryReport);
+
+        FTerrainBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+        Result.Resolution = Resolution;
+        Result.ModificationCount = ModificationCount;
+        Result.GenerateMs = GenerateMs;
+        Result.CreateMeshMs = MedianMs(CreateMeshSamples);
+        Result.ApplyMsPerModification = ModificationCount > 0 ? ApplyTotalMs / ModificationCount : 0.0;
+        Result.ApplyMsMax = ApplyMaxMs;
+        Result.TriangleCount = Terrain->MeshData.Triangles.Num() / 3;
+        Result.MemoryBytes = MemoryReport.GetTotalBytes();
+
+        UE_LOG(LogTemp, Display, TEXT("Terrain benchmark %dx%d, %d modifications: generate %.3f ms, apply %.3f ms/mod (max %.3f), create mesh %.3f ms, %d triangles, %lld KiB"),
+            Resolution, Resolution, ModificationCount, Result.GenerateMs, Result.ApplyMsPerModification, Result.ApplyMsMax,
+            Result.CreateMeshMs, Result.TriangleCount, Result.MemoryBytes / 1024);
+    }
+
+    Terrain->Destroy();
+}
+
+int32 FTerrainBenchmark::CompareToBaseline(const TArray<FTerrainBenchmarkResult>& Results, const TArray<FTerrainBenchmarkResult>& Baseline) const
+{
+    int32 Regressions = 0;
+
+    auto CheckMetric = [this, &Regressions](const FTerrainBenchmarkResult& Result, const TCHAR* Name, double Current, double Reference, double MinDelta)
+    {
+        if (Current > Reference * (1.0 + RegressionThreshold) && Current - Reference > MinDelta)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Terrain benchmark regression %dx%d / %d modifications: %s %.3f (baseline %.3f, +%.0f%%)"),
+                Result.Resolution, Result.Resolution, Result.ModificationCount, Name, Current, Reference,
+                Reference > 0.0 ? (Current / Reference - 1.0) * 100.0 : 100.0);
+            Regressions++;
+        }
+    };
+
+    for (const FTerrainBenchmarkResult& Result : Results)
+    {
+        const FTerrainBenchmarkResult* Reference = Baseline.FindByPredicate([&Result](const FTerrainBenchmarkResult& Entry)
+        {
+            return Entry.Resolution == Result.Resolution && Entry.ModificationCount == Result.ModificationCount;
+        });
+
+        // Un scénario sans référence ne peut pas être validé : compté comme une régression
+        if (!Reference)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Terrain benchmark: no baseline for %dx%d / %d modifications"),
+                Result.Resolution, Result.Resolution, Result.ModificationCount);
+            Regressions++;
+            continue;
+        }
+
+        CheckMetric(Result, TEXT("GenerateMs"), Result.GenerateMs, Reference->GenerateMs, MinTimeDeltaMs);
+        CheckMetric(Result, TEXT("ApplyMsPerModification"), Result.ApplyMsPerModification, Reference->ApplyMsPerModification, MinTimeDeltaMs);
+        CheckMetric(Result, TEXT("CreateMeshMs"), Result.CreateMeshMs, Reference->CreateMeshMs, MinTimeDeltaMs);
+        CheckMetric(Result, TEXT("TriangleCount"), Result.TriangleCount, Reference->TriangleCount, 0.0);
+        CheckMetric(Result, TEXT("MemoryBytes"), (double)Result.MemoryBytes, (double)Reference->MemoryBytes, 0.0);
+    }
+
+    return Regressions;
+}
+
+static const TCHAR* BenchmarkCsvHeader = TEXT("Resolution,Modifications,GenerateMs,ApplyMsPerModification,ApplyMsMax,CreateMeshMs,Triangles,MemoryBytes");
+
+bool FTerrainBenchmark::WriteCsv(const FString& Path, const TArray<FTerrainBenchmarkResult>& Results)
+{
+    TArray<FString> Lines;
+    Lines.Add(BenchmarkCsvHeader);
+    for (const FTerrainBenchmarkResult& Result : Results)
+    {
+        Lines.Add(FString::Printf(TEXT("%d,%d,%.4f,%.4f,%.4f,%.4f,%d,%lld"),
+            Result.Resolution, Result.ModificationCount, Result.GenerateMs, Result.ApplyMsPerModification,
+            Result.ApplyMsMax, Result.CreateMeshMs, Result.TriangleCount, Result.MemoryBytes));
+    }
+    return FFileHelper::SaveStringArrayToFile(Lines, *Path);
+}
+
+bool FTerrainBenchmark::ReadCsv(const FString& Path, TArray<FTerrainBenchmarkResult>& OutResults)
+{
+    OutResults.Reset();
+
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+    {
+        return false;
+    }
+
+    for (const FString& Line : Lines)
+    {
+        // En-tête et lignes de commentaire (#) ignorés
+        if (Line.StartsWith(TEXT("#")) || Line.StartsWith(TEXT("Resolution,")))
+        {
+            continue;
+        }
+
+        TArray<FString> Fields;
+        Line.ParseIntoArray(Fields, TEXT(","));
+        if (Fields.Num() < 8)
+        {
+            continue;
+        }
+
+        FTerrainBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+        Result.Resolution = FCString::Atoi(*Fields[0]);
+        Result.ModificationCount = FCString::Atoi(*Fields[1]);
+        Result.GenerateMs = FCString::Atod(*Fields[2]);
+        Result.ApplyMsPerModification = FCString::Atod(*Fields[3]);
+        Result.ApplyMsMax = FCString::Atod(*Fields[4]);
+        Result.CreateMeshMs = FCString::Atod(*Fields[5]);
+        Result.TriangleCount = FCString::Atoi(*Fields[6]);
+        Result.MemoryBytes = FCString::Atoi64(*Fields[7]);
+    }
+
+    // Fichier présent mais sans aucune ligne exploitable : illisible
+    return OutResults.Num() > 0;
+}
+
+bool FTerrainBenchmark::RunAndCompare(UWorld* World, bool bWriteBaseline, TArray<FTerrainBenchmarkResult>& OutResults) const
+{
+    Run(World, OutResults);
+    if (OutResults.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Terrain benchmark produced no results"));
+        return false;
+    }
+
+    const FString OutputPath = GetOutputPath();
+    if (WriteCsv(OutputPath, OutResults))
+    {
+        UE_LOG(LogTemp, Display, TEXT("Terrain benchmark results written to %s"), *OutputPath);
+    }
+
+    const FString BaselinePath = GetBaselinePath();
+    if (bWriteBaseline)
+    {
+        if (!WriteCsv(BaselinePath, OutResults))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Terrain benchmark: could not write the baseline %s"), *BaselinePath);
+            return false;
+        }
+        UE_LOG(LogTemp, Display, TEXT("Terrain benchmark baseline updated: %s"), *BaselinePath);
+        return true;
+    }
+
+    // Sans référence, rien ne prouve l'absence de régression : échec, pas un simple avertissement
+    TArray<FTerrainBenchmarkResult> Baseline;
+    if (!ReadCsv(BaselinePath, Baseline))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Terrain benchmark: missing or unreadable baseline %s (run with WriteBaseline to create it)"), *BaselinePath);
+        return false;
+    }
+
+    const int32 Regressions = CompareToBaseline(OutResults, Baseline);
+    UE_LOG(LogTemp, Display, TEXT("Terrain benchmark: %d regressions against the baseline"), Regressions);
+    return Regressions == 0;
+}
+
+FString FTerrainBenchmark::GetBaselinePath()
+{
+    return FPaths::Combine(FPaths::ProjectConfigDir(), TEXT("TerrainBenchmarkBaseline.csv"));
+}
+
+FString FTerrainBenchmark::GetOutputPath()
+{
+    return FPaths::Combine(FPaths::ProfilingDir(), TEXT("TerrainBenchmark"),
+        FString::Printf(TEXT("TerrainBenchmark-%s.csv"), *FDateTime::Now().ToString()));
+}
+
+// Terrain.Benchmark [Resolutions=16,64,128] [Counts=10,100,1000] [Threshold=0.2] [WriteBaseline] [Exit]
+// Exit quitte le processus avec le code 1 en cas de régression, de référence absente ou illisible (intégration continue)
+static FAutoConsoleCommandWithWorldAndArgs TerrainBenchmarkCommand(
+    TEXT("Terrain.Benchmark"),
+    TEXT("Mesure génération, modifications et création du mesh du terrain, écrit un CSV et le compare à la référence."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        FTerrainBenchmark Benchmark;
+        bool bWriteBaseline = false;
+        bool bExit = false;
+
+        auto ParseIntList = [](const FString& Value, TArray<int32>& OutList)
+        {
+            TArray<FString> Items;
+            Value.ParseIntoArray(Items, TEXT(","));
+            OutList.Reset();
+            for (const FString& Item : Items)
+            {
+                OutList.Add(FCString::Atoi(*Item));
+            }
+        };
+
+        for (const FString& Arg : Args)
+        {
+            FString Key, Value;
+            if (Arg.Split(TEXT("="), &Key, &Value))
+            {
+                if (Key == TEXT("Resolutions"))
+                {
+                    ParseIntList(Value, Benchmark.Resolutions);
+                }
+                else if (Key == TEXT("Counts"))
+                {
+                    ParseIntList(Value, Benchmark.ModificationCounts);
+                }
+                else if (Key == TEXT("Threshold"))
+                {
+                    Benchmark.RegressionThreshold = FCString::Atof(*Value);
+                }
+            }
+            else if (Arg == TEXT("WriteBaseline"))
+            {
+                bWriteBaseline = true;
+            }
+            else if (Arg == TEXT("Exit"))
+            {
+                bExit = true;
+            }
+        }
+
+        TArray<FTerrainBenchmarkResult> Results;
+        const bool bPassed = Benchmark.RunAndCompare(World, bWriteBaseline, Results);
+
+        if (bExit)
+        {
+            FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+        }
+    }));
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Même mesure que Terrain.Benchmark, une résolution par test, dans le monde de jeu courant (-game)
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FTerrainBenchmarkTest, "Worms3d.Terrain.Benchmark",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+void FTerrainBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    const FTerrainBenchmark Defaults;
+    for (int32 Resolution : Defaults.Resolutions)
+    {
+        OutBeautifiedNames.Add(FString::Printf(TEXT("%dx%d"), Resolution, Resolution));
+        OutTestCommands.Add(FString::FromInt(Resolution));
+    }
+}
+
+bool FTerrainBenchmarkTest::RunTest(const FString& Parameters)
+{
+    UWorld* World = nullptr;
+    for (const FWorldContext& Context : GEngine->GetWorldContexts())
+    {
+        if ((Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && Context.World())
+        {
+            World = Context.World();
+            break;
+        }
+    }
+
+    if (!World)
+    {
+        AddError(TEXT("Terrain benchmark needs a game world (run with -game or in PIE)"));
+        return false;
+    }
+
+    FTerrainBenchmark Benchmark;
+    Benchmark.Resolutions = { FCString::Atoi(*Parameters) };
+
+    // Les régressions et la référence manquante sont détaillées par les erreurs du log, rattachées au test
+    TArray<FTerrainBenchmarkResult> Results;
+    if (!Benchmark.RunAndCompare(World, false, Results))
+    {
+        AddError(FString::Printf(TEXT("Terrain benchmark %s failed against %s"), *Parameters, *FTerrainBenchmark::GetBaselinePath()));
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,216 @@
+#include "TerrainChunkManager.h"
+#include "WormGameMode.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+ATerrainChunkManager::ATerrainChunkManager()
+{
+    // Le streaming est évalué par un timer, jamais à chaque frame
+    PrimaryActorTick.bCanEverTick = false;
+    
+    // Seul le serveur gère les chunks : ceux-ci sont répliqués individuellement
+    bReplicates = false;
+    
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+    
+    ChunkClass = ADestructibleTerrain::StaticClass();
+    ChunkCountX = 10;
+    ChunkCountY = 1;
+    ChunkWidth = 2000.0f;
+    ChunkHeight = 2000.0f;
+    ChunkDepth = 1000.0f;
+    ChunkHorizontalResolution = 15;
+    ChunkVerticalResolution = 15;
+    
+    StreamInDistance = 6000.0f;
+    StreamOutDistance = 8000.0f;
+    CollisionDistance = 3000.0f;
+    StreamingInterval = 0.5f;
+}
+
+void ATerrainChunkManager::BeginPlay()
+{
+    Super::BeginPlay();
+    
+    if (!HasAuthority())
+    {
+        return;
+    }
+    
+    // Tous les chunks sont connus dès le départ, mais aucun n'est construit avant d'être proche d'un joueur
+    for (int32 y = 0; y < ChunkCountY; ++y)
+    {
+        for (int32 x = 0; x < ChunkCountX; ++x)
+        {
+            Chunks.Add(FIntPoint(x, y));
+        }
+    }
+    
+    GetWorldTimerManager().SetTimer(StreamingTimerHandle, this, &ATerrainChunkManager::UpdateStreaming, StreamingInterval, true, 0.0f);
+}
+
+void ATerrainChunkManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    GetWorldTimerManager().ClearTimer(StreamingTimerHandle);
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+FIntPoint ATerrainChunkManager::GetChunkAt(const FVector& WorldLocation) const
+{
+    // Même repère que les chunks : X en largeur, Z en hauteur
+    FVector Local = GetActorTransform().InverseTransformPosition(WorldLocation);
+    int32 X = FMath::FloorToInt(Local.X / ChunkWidth);
+    int32 Y = FMath::FloorToInt(Local.Z / ChunkHeight);
+    
+    if (X < 0 || Y < 0 || X >= ChunkCountX || Y >= ChunkCountY)
+    {
+        return FIntPoint(INDEX_NONE, INDEX_NONE);
+    }
+    
+    return FIntPoint(X, Y);
+}
+
+ADestructibleTerrain* ATerrainChunkManager::GetLoadedChunk(FIntPoint ChunkCoord) const
+{
+    const FTerrainChunkRecord* Record = Chunks.Find(ChunkCoord);
+    return Record ? Record->Chunk : nullptr;
+}
+
+FBox ATerrainChunkManager::GetChunkWorldBounds(const FIntPoint& ChunkCoord) const
+{
+    FBox LocalBounds(
+        FVector(ChunkCoord.X * ChunkWidth, 0.0f, ChunkCoord.Y * ChunkHeight),
+        FVector((ChunkCoord.X + 1) * ChunkWidth, ChunkDepth, (ChunkCoord.Y + 1) * ChunkHeight));
+    
+    return LocalBounds.TransformBy(GetActorTransform());
+}
+
+void ATerrainChunkManager::GatherFocusPoints(TArray<FVector>& OutPoints) const
+{
+    // Parcours des seuls controllers, pas de tous les acteurs du monde
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        APlayerController* PC = It->Get();
+        if (!PC)
+        {
+            continue;
+        }
+        
+        FVector ViewLocation;
+        FRotator ViewRotation;
+        PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+        OutPoints.Add(ViewLocation);
+        
+        if (APawn* Pawn = PC->GetPawn())
+        {
+            OutPoints.Add(Pawn->GetActorLocation());
+        }
+    }
+    
+    // Le ver actif peut être contrôlé par une IA : ses tirs doivent toujours trouver du terrain
+    if (AWormGameMode* GameMode = GetWorld()->GetAuthGameMode<AWormGameMode>())
+    {
+        if (AWormCharacter* ActiveWorm = GameMode->GetActiveWorm())
+        {
+            OutPoints.Add(ActiveWorm->GetActorLocation());
+        }
+    }
+}
+
+void ATerrainChunkManager::UpdateStreaming()
+{
+    TArray<FVector> FocusPoints;
+    GatherFocusPoints(FocusPoints);
+    
+    int32 Loaded = 0;
+    int32 Unloaded = 0;
+    
+    for (TPair<FIntPoint, FTerrainChunkRecord>& Pair : Chunks)
+    {
+        FBox Bounds = GetChunkWorldBounds(Pair.Key);
+        
+        float DistanceSquared = TNumericLimits<float>::Max();
+        for (const FVector& Point : FocusPoints)
+        {
+            DistanceSquared = FMath::Min(DistanceSquared, (float)Bounds.ComputeSquaredDistanceToPoint(Point));
+        }
+        float Distance = FMath::Sqrt(DistanceSquared);
+        
+        FTerrainChunkRecord& Record = Pair.Value;
+        
+        // Le chunk a pu être détruit par ailleurs (fin de niveau, éditeur)
+        if (Record.Chunk && !IsValid(Record.Chunk))
+        {
+            Record.Chunk = nullptr;
+        }
+        
+        if (!Record.Chunk)
+        {
+            if (Distance <= StreamInDistance)
+            {
+                LoadChunk(Pair.Key, Record);
+                Loaded++;
+            }
+        }
+        else if (Distance > FMath::Max(StreamOutDistance, StreamInDistance))
+        {
+            UnloadChunk(Record);
+            Unloaded++;
+        }
+        
+        if (Record.Chunk)
+        {
+            Record.Chunk->SetTerrainCollisionActive(Distance <= CollisionDistance);
+        }
+    }
+    
+    if (Loaded > 0 || Unloaded > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Terrain streaming: %d chunks loaded, %d unloaded"), Loaded, Unloaded);
+    }
+}
+
+void ATerrainChunkManager::LoadChunk(const FIntPoint& ChunkCoord, FTerrainChunkRecord& Record)
+{
+    if (!ChunkClass)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TerrainChunkManager: ChunkClass non défini!"));
+        return;
+    }
+    
+    FTransform ChunkTransform(
+        GetActorRotation(),
+        GetActorTransform().TransformPosition(FVector(ChunkCoord.X * ChunkWidth, 0.0f, ChunkCoord.Y * ChunkHeight)));
+    
+    // Spawn différé : dimensions et modifications sont en place avant BeginPlay()
+    ADestructibleTerrain* Chunk = GetWorld()->SpawnActorDeferred<ADestructibleTerrain>(
+        ChunkClass, ChunkTransform, this, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    
+    if (!Chunk)
+    {
+        return;
+    }
+    
+    Chunk->TerrainWidth = ChunkWidth;
+    Chunk->TerrainHeight = ChunkHeight;
+    Chunk->TerrainDepth = ChunkDepth;
+    Chunk->HorizontalResolution = ChunkHorizontalResolution;
+    Chunk->VerticalResolution = ChunkVerticalResolution;
+    
+    if (Record.Snapshot.Num() > 0)
+    {
+        Chunk->LoadSnapshot(Record.Snapshot);
+    }
+    
+    Chunk->FinishSpawning(ChunkTransform);
+    Record.Chunk = Chunk;
+}
+
+void ATerrainChunkManager::UnloadChunk(FTerrainChunkRecord& Record)
+{
+    // Les cratères survivent au déchargement : ils seront rejoués au prochain chargement
+    Record.Chunk->SaveSnapshot(Record.Snapshot);
+    Record.Chunk->Destroy();
+    Record.Chunk = nullptr;
+}
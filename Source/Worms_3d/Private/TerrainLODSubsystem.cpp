@@ -0,0 +1,128 @@
+#include "TerrainLODSubsystem.h"
+#include "ADestructibleTerrain.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+void UTerrainLODSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(UpdateTimerHandle);
+    }
+    
+    ViewPoints.Empty();
+    Terrains.Empty();
+    ViewLocations.Empty();
+    
+    Super::Deinitialize();
+}
+
+void UTerrainLODSubsystem::RegisterViewPoint(const UObject* Owner, FTerrainViewPointGetter Getter)
+{
+    if (!Owner || !Getter)
+    {
+        return;
+    }
+    
+    UnregisterViewPoint(Owner);
+    ViewPoints.Add({ Owner, MoveTemp(Getter) });
+    
+    bForceUpdate = true;
+    UpdateTimerState();
+}
+
+void UTerrainLODSubsystem::UnregisterViewPoint(const UObject* Owner)
+{
+    ViewPoints.RemoveAll([Owner](const FViewPoint& ViewPoint)
+    {
+        return !ViewPoint.Owner.IsValid() || ViewPoint.Owner.Get() == Owner;
+    });
+    
+    UpdateTimerState();
+}
+
+void UTerrainLODSubsystem::RegisterTerrain(ADestructibleTerrain* Terrain)
+{
+    if (!Terrain)
+    {
+        return;
+    }
+    
+    Terrains.AddUnique(Terrain);
+    
+    bForceUpdate = true;
+    UpdateTimerState();
+}
+
+void UTerrainLODSubsystem::UnregisterTerrain(ADestructibleTerrain* Terrain)
+{
+    Terrains.RemoveAll([Terrain](const TWeakObjectPtr<ADestructibleTerrain>& Registered)
+    {
+        return !Registered.IsValid() || Registered.Get() == Terrain;
+    });
+    
+    UpdateTimerState();
+}
+
+void UTerrainLODSubsystem::UpdateTimerState()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+    
+    FTimerManager& TimerManager = World->GetTimerManager();
+    
+    // Aucun travail tant qu'il manque un point de vue ou un terrain (serveur dédié notamment)
+    if (ViewPoints.Num() == 0 || Terrains.Num() == 0)
+    {
+        TimerManager.ClearTimer(UpdateTimerHandle);
+        return;
+    }
+    
+    if (!TimerManager.IsTimerActive(UpdateTimerHandle))
+    {
+        TimerManager.SetTimer(UpdateTimerHandle, this, &UTerrainLODSubsystem::SampleViewPoints, UpdateInterval, true, 0.0f);
+    }
+}
+
+void UTerrainLODSubsystem::SampleViewPoints()
+{
+    TArray<FVector> NewLocations;
+    NewLocations.Reserve(ViewPoints.Num());
+    
+    for (const FViewPoint& ViewPoint : ViewPoints)
+    {
+        FVector Location;
+        if (ViewPoint.Owner.IsValid() && ViewPoint.Getter(Location))
+        {
+            NewLocations.Add(Location);
+        }
+    }
+    
+    // Réévaluer seulement si un point de vue est apparu, a disparu ou s'est suffisamment déplacé
+    bool bMoved = bForceUpdate || NewLocations.Num() != ViewLocations.Num();
+    for (int32 i = 0; !bMoved && i < NewLocations.Num(); ++i)
+    {
+        bMoved = FVector::DistSquared(NewLocations[i], ViewLocations[i]) > FMath::Square(MoveThreshold);
+    }
+    
+    if (!bMoved)
+    {
+        return;
+    }
+    
+    ViewLocations = MoveTemp(NewLocations);
+    bForceUpdate = false;
+    
+    // Copie : un terrain peut se désenregistrer pendant sa mise à jour
+    TArray<TWeakObjectPtr<ADestructibleTerrain>> TerrainsToUpdate = Terrains;
+    for (const TWeakObjectPtr<ADestructibleTerrain>& Terrain : TerrainsToUpdate)
+    {
+        if (Terrain.IsValid())
+        {
+            Terrain->UpdateLOD();
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#include "TerrainMemory.h"
+#include "ADestructibleTerrain.h"
+#include "DestructibleTerrainSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+
+// Tag parent "Terrain" : les catégories sont ses enfants et s'additionnent sous un total Terrain dans stat LLM et Insights
+LLM_DEFINE_TAG(Terrain);
+LLM_DEFINE_TAG(Terrain_MeshData, NAME_None, TEXT("Terrain"));
+LLM_DEFINE_TAG(Terrain_Topology, NAME_None, TEXT("Terrain"));
+LLM_DEFINE_TAG(Terrain_Internal, NAME_None, TEXT("Terrain"));
+LLM_DEFINE_TAG(Terrain_LOD, NAME_None, TEXT("Terrain"));
+LLM_DEFINE_TAG(Terrain_Render, NAME_None, TEXT("Terrain"));
+LLM_DEFINE_TAG(Terrain_Collision, NAME_None, TEXT("Terrain"));
+LLM_DEFINE_TAG(Terrain_Navigation, NAME_None, TEXT("Terrain"));
+LLM_DEFINE_TAG(Terrain_Modifications, NAME_None, TEXT("Terrain"));
+
+static TAutoConsoleVariable<int32> CVarTerrainMemoryBudgetMB(
+    TEXT("Terrain.MemoryBudgetMB"),
+    512,
+    TEXT("Budget mémoire de l'ensemble des terrains destructibles d'un monde, en Mio (0 = pas de limite).\n")
+    TEXT("Au-delà, les terrains les plus gros sont simplifiés un niveau à la fois."),
+    ECVF_Default);
+
+int32 GetTerrainMemoryBudgetMB()
+{
+    return CVarTerrainMemoryBudgetMB.GetValueOnGameThread();
+}
+
+FTerrainMemoryReport& FTerrainMemoryReport::operator+=(const FTerrainMemoryReport& Other)
+{
+    MeshDataBytes += Other.MeshDataBytes;
+    TopologyBytes += Other.TopologyBytes;
+    InternalBytes += Other.InternalBytes;
+    LODBytes += Other.LODBytes;
+    RenderBytes += Other.RenderBytes;
+    CollisionBytes += Other.CollisionBytes;
+    NavigationBytes += Other.NavigationBytes;
+    ModificationBytes += Other.ModificationBytes;
+    return *this;
+}
+
+FString FTerrainMemoryReport::ToString() const
+{
+    return FString::Printf(
+        TEXT("Total %lld KiB | MeshData %lld, Topology %lld, Internal %lld, LOD %lld, Render %lld, Collision %lld, Navigation %lld, Modifications %lld"),
+        GetTotalBytes() / 1024, MeshDataBytes / 1024, TopologyBytes / 1024, InternalBytes / 1024, LODBytes / 1024,
+        RenderBytes / 1024, CollisionBytes / 1024, NavigationBytes / 1024, ModificationBytes / 1024);
+}
+
+// Terrain.MemReport : mémoire de chaque terrain du monde, puis le total face au budget
+static FAutoConsoleCommandWithWorldAndArgs TerrainMemReportCommand(
+    TEXT("Terrain.MemReport"),
+    TEXT("Affiche la mémoire occupée par chaque terrain destructible, par catégorie de tampon."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UDestructibleTerrainSubsystem* TerrainSubsystem = World ? World->GetSubsystem<UDestructibleTerrainSubsystem>() : nullptr;
+        if (!TerrainSubsystem)
+        {
+            return;
+        }
+
+        TArray<ADestructibleTerrain*> Terrains;
+        TerrainSubsystem->GetAllTerrains(Terrains);
+
+        FTerrainMemoryReport Total;
+        for (ADestructibleTerrain* Terrain : Terrains)
+        {
+            FTerrainMemoryReport Report;
+            Terrain->GetMemoryReport(Report);
+            Total += Report;
+
+            UE_LOG(LogTemp, Display, TEXT("%s (pressure %d): %s"),
+                *Terrain->GetName(), (int32)Terrain->GetMemoryPressure(), *Report.ToString());
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("%d terrains: %s (budget %d MiB)"),
+            Terrains.Num(), *Total.ToString(), GetTerrainMemoryBudgetMB());
+    }));
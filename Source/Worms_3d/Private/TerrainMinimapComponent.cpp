@@ -0,0 +1,196 @@
+#include "TerrainMinimapComponent.h"
+#include "ADestructibleTerrain.h"
+#include "TerrainMemory.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+UTerrainMinimapComponent::UTerrainMinimapComponent()
+{
+    // Mis à jour sur modification uniquement, jamais à chaque frame
+    PrimaryComponentTick.bCanEverTick = false;
+    SetIsReplicatedByDefault(false);
+    
+    MaxTextureSize = 256;
+    SolidColor = FColor(75, 150, 75, 255);
+    EmptyColor = FColor(0, 0, 0, 0);
+    Texture = nullptr;
+}
+
+void UTerrainMinimapComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearAllTimersForObject(this);
+    }
+    bFlushScheduled = false;
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+ADestructibleTerrain* UTerrainMinimapComponent::GetTerrain() const
+{
+    return Cast<ADestructibleTerrain>(GetOwner());
+}
+
+bool UTerrainMinimapComponent::WorldToMinimapUV(const FVector& WorldLocation, FVector2D& OutUV) const
+{
+    const ADestructibleTerrain* Terrain = GetTerrain();
+    if (!Terrain || Terrain->TerrainWidth <= 0.0f || Terrain->TerrainHeight <= 0.0f)
+    {
+        return false;
+    }
+    
+    // Repère local : X en largeur, Z en hauteur ; la ligne 0 de la texture est le haut du terrain
+    const FVector Local = Terrain->GetActorTransform().InverseTransformPosition(WorldLocation);
+    OutUV = FVector2D(Local.X / Terrain->TerrainWidth, 1.0 - Local.Z / Terrain->TerrainHeight);
+    return OutUV.X >= 0.0 && OutUV.X <= 1.0 && OutUV.Y >= 0.0 && OutUV.Y <= 1.0;
+}
+
+void UTerrainMinimapComponent::MarkCellsDirty(const FIntPoint& MinCell, const FIntPoint& MaxCell)
+{
+    DirtyMin = DirtyMin.ComponentMin(MinCell);
+    DirtyMax = DirtyMax.ComponentMax(MaxCell);
+    ScheduleFlush();
+}
+
+void UTerrainMinimapComponent::MarkAllDirty()
+{
+    bAllDirty = true;
+    ScheduleFlush();
+}
+
+void UTerrainMinimapComponent::ScheduleFlush()
+{
+    // Aucune minimap sur un serveur dédié
+    UWorld* World = GetWorld();
+    if (bFlushScheduled || !World || !World->IsGameWorld() || GetNetMode() == NM_DedicatedServer)
+    {
+        return;
+    }
+    
+    // Toutes les modifications d'une frame partagent un seul envoi
+    bFlushScheduled = true;
+    World->GetTimerManager().SetTimerForNextTick(this, &UTerrainMinimapComponent::FlushDirtyRegion);
+}
+
+void UTerrainMinimapComponent::FlushDirtyRegion()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UTerrainMinimapComponent::FlushDirtyRegion);
+    LLM_SCOPE_BYTAG(Terrain_Render);
+    
+    bFlushScheduled = false;
+    
+    const ADestructibleTerrain* Terrain = GetTerrain();
+    if (!Terrain || !Terrain->MeshData.bIsValid)
+    {
+        return;
+    }
+    
+    FIntPoint Min, Max;
+    if (EnsureTexture() || bAllDirty)
+    {
+        Min = FIntPoint::ZeroValue;
+        Max = TextureSize - FIntPoint(1, 1);
+    }
+    else if (DirtyMin.X <= DirtyMax.X && DirtyMin.Y <= DirtyMax.Y)
+    {
+        // Cellules -> pixels (par excès) ; les lignes de la texture vont du haut vers le bas du terrain
+        const FIntPoint CellCount(Terrain->Grid.GetCellCountX(), Terrain->Grid.GetCellCountY());
+        Min.X = FMath::FloorToInt((float)DirtyMin.X * TextureSize.X / CellCount.X);
+        Max.X = FMath::CeilToInt((float)(DirtyMax.X + 1) * TextureSize.X / CellCount.X) - 1;
+        Min.Y = TextureSize.Y - FMath::CeilToInt((float)(DirtyMax.Y + 1) * TextureSize.Y / CellCount.Y);
+        Max.Y = TextureSize.Y - 1 - FMath::FloorToInt((float)DirtyMin.Y * TextureSize.Y / CellCount.Y);
+        
+        Min = Min.ComponentMax(FIntPoint::ZeroValue);
+        Max = Max.ComponentMin(TextureSize - FIntPoint(1, 1));
+    }
+    else
+    {
+        return;
+    }
+    
+    bAllDirty = false;
+    DirtyMin = FIntPoint(MAX_int32, MAX_int32);
+    DirtyMax = FIntPoint(MIN_int32, MIN_int32);
+    
+    if (!Texture || Min.X > Max.X || Min.Y > Max.Y)
+    {
+        return;
+    }
+    
+    FillPixels(Min, Max);
+    
+    // Copie du seul rectangle modifié, libérée par le render thread une fois envoyée
+    const int32 RegionWidth = Max.X - Min.X + 1;
+    const int32 RegionHeight = Max.Y - Min.Y + 1;
+    FColor* RegionPixels = new FColor[RegionWidth * RegionHeight];
+    for (int32 y = 0; y < RegionHeight; ++y)
+    {
+        FMemory::Memcpy(&RegionPixels[y * RegionWidth], &Pixels[(Min.Y + y) * TextureSize.X + Min.X], RegionWidth * sizeof(FColor));
+    }
+    
+    FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(Min.X, Min.Y, 0, 0, RegionWidth, RegionHeight);
+    Texture->UpdateTextureRegions(0, 1, Region, RegionWidth * sizeof(FColor), sizeof(FColor), (uint8*)RegionPixels,
+        [](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+        {
+            delete[] (FColor*)SrcData;
+            delete Regions;
+        });
+    
+    UE_LOG(LogTemp, Verbose, TEXT("%s: minimap region %dx%d updated"), *GetOwner()->GetName(), RegionWidth, RegionHeight);
+}
+
+bool UTerrainMinimapComponent::EnsureTexture()
+{
+    const ADestructibleTerrain* Terrain = GetTerrain();
+    const int32 CellCountX = FMath::Max(Terrain->Grid.GetCellCountX(), 1);
+    const int32 CellCountY = FMath::Max(Terrain->Grid.GetCellCountY(), 1);
+    
+    // Un pixel par cellule, sous-échantillonné au-delà de MaxTextureSize
+    const float Scale = FMath::Min(1.0f, (float)MaxTextureSize / FMath::Max(CellCountX, CellCountY));
+    const FIntPoint NewSize(
+        FMath::Max(FMath::RoundToInt(CellCountX * Scale), 1),
+        FMath::Max(FMath::RoundToInt(CellCountY * Scale), 1));
+    
+    if (Texture && NewSize == TextureSize)
+    {
+        return false;
+    }
+    
+    TextureSize = NewSize;
+    Pixels.SetNumUninitialized(TextureSize.X * TextureSize.Y);
+    
+    Texture = UTexture2D::CreateTransient(TextureSize.X, TextureSize.Y, PF_B8G8R8A8, TEXT("TerrainMinimap"));
+    if (!Texture)
+    {
+        return false;
+    }
+    
+    // Cellules nettes, sans mips ni streaming : la texture est mise à jour par régions
+    Texture->Filter = TF_Nearest;
+    Texture->AddressX = TA_Clamp;
+    Texture->AddressY = TA_Clamp;
+    Texture->NeverStream = true;
+    Texture->SRGB = true;
+    Texture->UpdateResource();
+    return true;
+}
+
+void UTerrainMinimapComponent::FillPixels(const FIntPoint& Min, const FIntPoint& Max)
+{
+    const FTerrainGrid& Grid = GetTerrain()->Grid;
+    const int32 CellCountX = Grid.GetCellCountX();
+    const int32 CellCountY = Grid.GetCellCountY();
+    
+    // Chaque pixel prend l'état de la cellule sous son centre
+    for (int32 y = Min.Y; y <= Max.Y; ++y)
+    {
+        const int32 CellY = CellCountY - 1 - FMath::FloorToInt((y + 0.5f) * CellCountY / TextureSize.Y);
+        for (int32 x = Min.X; x <= Max.X; ++x)
+        {
+            const int32 CellX = FMath::FloorToInt((x + 0.5f) * CellCountX / TextureSize.X);
+            Pixels[y * TextureSize.X + x] = Grid.IsCellSolid(CellX, CellY) ? SolidColor : EmptyColor;
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#include "TerrainMinimapWidget.h"
+#include "ADestructibleTerrain.h"
+#include "TerrainMinimapComponent.h"
+#include "DestructibleTerrainSubsystem.h"
+#include "WormGameState.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerState.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+
+void UTerrainMinimapWidget::FindTerrains(TArray<ADestructibleTerrain*>& OutTerrains) const
+{
+    if (Terrain)
+    {
+        OutTerrains.Add(Terrain);
+        return;
+    }
+    
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+    
+    if (UDestructibleTerrainSubsystem* TerrainSubsystem = World->GetSubsystem<UDestructibleTerrainSubsystem>())
+    {
+        TerrainSubsystem->GetAllTerrains(OutTerrains);
+    }
+    
+    // Terrain du GameState pas encore enregistré (dimensions pas encore répliquées)
+    if (AWormGameState* WormGameState = World->GetGameState<AWormGameState>())
+    {
+        if (WormGameState->DestructibleTerrain)
+        {
+            OutTerrains.AddUnique(WormGameState->DestructibleTerrain);
+        }
+    }
+}
+
+int32 UTerrainMinimapWidget::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    LayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+    
+    TArray<ADestructibleTerrain*> Terrains;
+    FindTerrains(Terrains);
+    
+    // Rectangle englobant des terrains dans le plan X / Z du monde
+    TArray<const UTerrainMinimapComponent*, TInlineAllocator<8>> Minimaps;
+    TArray<FBox, TInlineAllocator<8>> Bounds;
+    FBox WorldBounds(ForceInit);
+    for (const ADestructibleTerrain* MinimapTerrain : Terrains)
+    {
+        const UTerrainMinimapComponent* Minimap = MinimapTerrain ? MinimapTerrain->Minimap : nullptr;
+        if (!Minimap || !Minimap->GetTexture())
+        {
+            continue;
+        }
+        Minimaps.Add(Minimap);
+        WorldBounds += Bounds.Add_GetRef(MinimapTerrain->GetTerrainWorldBounds());
+    }
+    
+    const FVector WorldSize = WorldBounds.GetSize();
+    if (Minimaps.Num() == 0 || WorldSize.X <= 0.0 || WorldSize.Z <= 0.0)
+    {
+        return LayerId;
+    }
+    
+    // Position monde -> coordonnées [0, 1] du widget (0, 0 en haut à gauche)
+    auto WorldToUV = [&WorldBounds, &WorldSize](const FVector& Location)
+    {
+        return FVector2D((Location.X - WorldBounds.Min.X) / WorldSize.X, (WorldBounds.Max.Z - Location.Z) / WorldSize.Z);
+    };
+    
+    // Les textures ne changent que lorsqu'une explosion les a mises à jour
+    const FVector2D Size = AllottedGeometry.GetLocalSize();
+    TerrainBrushes.SetNum(Minimaps.Num());
+    ++LayerId;
+    for (int32 i = 0; i < Minimaps.Num(); ++i)
+    {
+        const FVector2D TopLeft = WorldToUV(FVector(Bounds[i].Min.X, 0.0, Bounds[i].Max.Z)) * Size;
+        const FVector2D BottomRight = WorldToUV(FVector(Bounds[i].Max.X, 0.0, Bounds[i].Min.Z)) * Size;
+        
+        FSlateBrush& TerrainBrush = TerrainBrushes[i];
+        TerrainBrush.SetResourceObject(Minimaps[i]->GetTexture());
+        TerrainBrush.ImageSize = BottomRight - TopLeft;
+        FSlateDrawElement::MakeBox(OutDrawElements, LayerId,
+            AllottedGeometry.ToPaintGeometry(BottomRight - TopLeft, FSlateLayoutTransform(TopLeft)), &TerrainBrush,
+            ESlateDrawEffect::None, InWidgetStyle.GetColorAndOpacityTint());
+    }
+    
+    // Vers de tous les joueurs, le joueur actif étant reconnu par son nom répliqué
+    const AWormGameState* WormGameState = GetWorld() ? GetWorld()->GetGameState<AWormGameState>() : nullptr;
+    if (!WormGameState)
+    {
+        return LayerId;
+    }
+    
+    const FSlateBrush* MarkerBrush = FCoreStyle::Get().GetBrush("WhiteBrush");
+    ++LayerId;
+    
+    for (const APlayerState* PlayerState : WormGameState->PlayerArray)
+    {
+        const APawn* Worm = PlayerState ? PlayerState->GetPawn() : nullptr;
+        if (!Worm)
+        {
+            continue;
+        }
+        
+        const FVector2D UV = WorldToUV(Worm->GetActorLocation());
+        if (UV.X < 0.0 || UV.X > 1.0 || UV.Y < 0.0 || UV.Y > 1.0)
+        {
+            continue;
+        }
+        
+        const bool bActive = PlayerState->GetPlayerName() == WormGameState->CurrentPlayerName;
+        const float MarkerSize = bActive ? WormMarkerSize * 1.5f : WormMarkerSize;
+        const FVector2D Offset = UV * Size - FVector2D(MarkerSize * 0.5f);
+        
+        FSlateDrawElement::MakeBox(OutDrawElements, LayerId,
+            AllottedGeometry.ToPaintGeometry(FVector2D(MarkerSize), FSlateLayoutTransform(Offset)),
+            MarkerBrush, ESlateDrawEffect::None, bActive ? ActiveWormColor : WormColor);
+    }
+    
+    return LayerId;
+}
@@ -0,0 +1,159 @@
+#include "TerrainNavGeometryComponent.h"
+#include "ADestructibleTerrain.h"
+#include "TerrainMemory.h"
+#include "AI/NavigationSystemHelpers.h"
+
+UTerrainNavGeometryComponent::UTerrainNavGeometryComponent()
+{
+    // Composant purement logique : ni rendu ni collision
+    SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    SetGenerateOverlapEvents(false);
+    bHiddenInGame = true;
+    SetCanEverAffectNavigation(true);
+    bHasCustomNavigableGeometry = EHasCustomNavigableGeometry::EvenIfNotCollision;
+}
+
+ADestructibleTerrain* UTerrainNavGeometryComponent::GetTerrain() const
+{
+    return Cast<ADestructibleTerrain>(GetOwner());
+}
+
+FBoxSphereBounds UTerrainNavGeometryComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+    const ADestructibleTerrain* Terrain = GetTerrain();
+    if (!Terrain)
+    {
+        return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0.0f);
+    }
+    
+    FBox LocalBounds(FVector::ZeroVector, FVector(Terrain->TerrainWidth, Terrain->TerrainDepth, Terrain->TerrainHeight));
+    return FBoxSphereBounds(LocalBounds.TransformBy(LocalToWorld));
+}
+
+void UTerrainNavGeometryComponent::UpdateSections(const TArray<FIntPoint>& SectionCoords)
+{
+    ADestructibleTerrain* Terrain = GetTerrain();
+    if (!Terrain)
+    {
+        return;
+    }
+    
+    LLM_SCOPE_BYTAG(Terrain_Navigation);
+    
+    // Construire hors verrou, puis échanger
+    TArray<TPair<FIntPoint, TArray<FBox>>> Rebuilt;
+    Rebuilt.Reserve(SectionCoords.Num());
+    for (const FIntPoint& SectionCoord : SectionCoords)
+    {
+        TPair<FIntPoint, TArray<FBox>>& Entry = Rebuilt.AddDefaulted_GetRef();
+        Entry.Key = SectionCoord;
+        Terrain->BuildSectionCollisionBoxes(SectionCoord, Entry.Value);
+    }
+    
+    FScopeLock Lock(&SectionBoxesLock);
+    for (TPair<FIntPoint, TArray<FBox>>& Entry : Rebuilt)
+    {
+        SectionBoxes.Add(Entry.Key, MoveTemp(Entry.Value));
+    }
+}
+
+void UTerrainNavGeometryComponent::UpdateAllSections()
+{
+    ADestructibleTerrain* Terrain = GetTerrain();
+    if (!Terrain)
+    {
+        return;
+    }
+    
+    TArray<FIntPoint> SectionCoords;
+    FIntPoint SectionCount = Terrain->GetSectionCount();
+    for (int32 y = 0; y < SectionCount.Y; ++y)
+    {
+        for (int32 x = 0; x < SectionCount.X; ++x)
+        {
+            SectionCoords.Add(FIntPoint(x, y));
+        }
+    }
+    
+    {
+        FScopeLock Lock(&SectionBoxesLock);
+        SectionBoxes.Empty();
+    }
+    UpdateSections(SectionCoords);
+}
+
+SIZE_T UTerrainNavGeometryComponent::GetAllocatedSize() const
+{
+    FScopeLock Lock(&SectionBoxesLock);
+    
+    SIZE_T Size = SectionBoxes.GetAllocatedSize();
+    for (const TPair<FIntPoint, TArray<FBox>>& Pair : SectionBoxes)
+    {
+        Size += Pair.Value.GetAllocatedSize();
+    }
+    return Size;
+}
+
+bool UTerrainNavGeometryComponent::DoCustomNavigableGeometryExport(FNavigableGeometryExport& GeomExport) const
+{
+    // Chemin de secours quand la géométrie est rassemblée d'un bloc (générateur sans découpage par tranche) :
+    // toutes les boîtes sont exportées, et false évite l'export de la collision par défaut
+    ExportSectionBoxes(GeomExport, nullptr);
+    return false;
+}
+
+void UTerrainNavGeometryComponent::GatherGeometrySlice(FNavigableGeometryExport& GeomExport, const FBox& SliceBox) const
+{
+    const FBox LocalSlice = SliceBox.InverseTransformBy(GetComponentTransform());
+    ExportSectionBoxes(GeomExport, &LocalSlice);
+}
+
+void UTerrainNavGeometryComponent::ExportSectionBoxes(FNavigableGeometryExport& GeomExport, const FBox* LocalSlice) const
+{
+    const FTransform& LocalToWorld = GetComponentTransform();
+    
+    TArray<FVector> Vertices;
+    TArray<int32> Indices;
+    
+    // Faces d'une boîte : 6 quads, 2 triangles chacun
+    static const int32 BoxIndices[36] = {
+        0, 2, 1, 1, 2, 3,   // Y min
+        4, 5, 6, 5, 7, 6,   // Y max
+        0, 1, 4, 1, 5, 4,   // Z min
+        2, 6, 3, 3, 6, 7,   // Z max
+        0, 4, 2, 2, 4, 6,   // X min
+        1, 3, 5, 3, 7, 5    // X max
+    };
+    
+    {
+        FScopeLock Lock(&SectionBoxesLock);
+        for (const TPair<FIntPoint, TArray<FBox>>& Pair : SectionBoxes)
+        {
+            for (const FBox& Box : Pair.Value)
+            {
+                if (LocalSlice && !Box.Intersect(*LocalSlice))
+                {
+                    continue;
+                }
+                
+                const int32 Base = Vertices.Num();
+                for (int32 Corner = 0; Corner < 8; ++Corner)
+                {
+                    Vertices.Add(FVector(
+                        (Corner & 1) ? Box.Max.X : Box.Min.X,
+                        (Corner & 4) ? Box.Max.Y : Box.Min.Y,
+                        (Corner & 2) ? Box.Max.Z : Box.Min.Z));
+                }
+                for (int32 Index : BoxIndices)
+                {
+                    Indices.Add(Base + Index);
+                }
+            }
+        }
+    }
+    
+    if (Indices.Num() > 0)
+    {
+        GeomExport.ExportCustomMesh(Vertices.GetData(), Vertices.Num(), Indices.GetData(), Indices.Num(), LocalToWorld);
+    }
+}
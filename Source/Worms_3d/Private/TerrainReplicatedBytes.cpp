@@ -0,0 +1,78 @@
+#include "TerrainReplicatedBytes.h"
+
+bool FTerrainReplicatedBytes::SetBytes(const TArray<uint8>& Bytes)
+{
+    if (Bytes.Num() > MaxBytes)
+    {
+        return false;
+    }
+    
+    const int32 ChunkCount = FMath::DivideAndRoundUp(Bytes.Num(), ChunkSize);
+    if (Items.Num() > ChunkCount)
+    {
+        Items.SetNum(ChunkCount);
+        MarkArrayDirty();
+    }
+    
+    for (int32 ChunkIndex = 0; ChunkIndex < ChunkCount; ++ChunkIndex)
+    {
+        const int32 Offset = ChunkIndex * ChunkSize;
+        const int32 Size = FMath::Min(ChunkSize, Bytes.Num() - Offset);
+        
+        FTerrainByteChunk& Chunk = Items.IsValidIndex(ChunkIndex) ? Items[ChunkIndex] : Items.AddDefaulted_GetRef();
+        
+        // Morceau inchangé : rien à renvoyer
+        if (Chunk.Index == ChunkIndex && Chunk.ChunkCount == ChunkCount && Chunk.Data.Num() == Size &&
+            FMemory::Memcmp(Chunk.Data.GetData(), Bytes.GetData() + Offset, Size) == 0)
+        {
+            continue;
+        }
+        
+        Chunk.Index = ChunkIndex;
+        Chunk.ChunkCount = ChunkCount;
+        Chunk.Data = TArray<uint8>(Bytes.GetData() + Offset, Size);
+        MarkItemDirty(Chunk);
+    }
+    return true;
+}
+
+void FTerrainReplicatedBytes::Reset()
+{
+    if (Items.Num() > 0)
+    {
+        Items.Reset();
+        MarkArrayDirty();
+    }
+}
+
+bool FTerrainReplicatedBytes::GetBytes(TArray<uint8>& OutBytes) const
+{
+    OutBytes.Reset();
+    
+    TArray<const FTerrainByteChunk*, TInlineAllocator<32>> Ordered;
+    Ordered.Init(nullptr, Items.Num());
+    for (const FTerrainByteChunk& Chunk : Items)
+    {
+        if (Chunk.ChunkCount != Items.Num() || !Ordered.IsValidIndex(Chunk.Index) || Ordered[Chunk.Index])
+        {
+            return false;
+        }
+        Ordered[Chunk.Index] = &Chunk;
+    }
+    
+    for (const FTerrainByteChunk* Chunk : Ordered)
+    {
+        OutBytes.Append(Chunk->Data);
+    }
+    return true;
+}
+
+SIZE_T FTerrainReplicatedBytes::GetAllocatedSize() const
+{
+    SIZE_T Size = Items.GetAllocatedSize();
+    for (const FTerrainByteChunk& Chunk : Items)
+    {
+        Size += Chunk.Data.GetAllocatedSize();
+    }
+    return Size;
+}
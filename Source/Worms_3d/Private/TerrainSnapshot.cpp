@@ -0,0 +1,289 @@
+#include "TerrainSnapshot.h"
+#include "DestructibleTerrainSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Format de compression des données (stocké dans l'en-tête)
+enum class ETerrainSnapshotCompression : uint8
+{
+    None,
+    Oodle
+};
+
+// Garde-fou contre un en-tête corrompu ou malveillant (un instantané fait normalement quelques Kio)
+static const int32 MaxSnapshotPayloadBytes = 64 * 1024 * 1024;
+
+static void SerializeModification(FArchive& Ar, FTerrainModification& Mod)
+{
+    // Un cratère circulaire se résume à son centre et son rayon, un rectangle à sa position et sa taille
+    // Coordonnées en float : les positions locales du terrain n'ont pas besoin de la précision double
+    uint8 bCircular = Mod.bIsCircular ? 1 : 0;
+    Ar << bCircular;
+    
+    if (bCircular)
+    {
+        float CenterX = Mod.CircleCenter.X;
+        float CenterY = Mod.CircleCenter.Y;
+        float Radius = Mod.CircleRadius;
+        Ar << CenterX << CenterY << Radius;
+        
+        if (Ar.IsLoading())
+        {
+            Mod = FTerrainModification::MakeCircular(FVector2D(CenterX, CenterY), Radius);
+        }
+    }
+    else
+    {
+        float PositionX = Mod.Position.X;
+        float PositionY = Mod.Position.Y;
+        float SizeX = Mod.Size.X;
+        float SizeY = Mod.Size.Y;
+        Ar << PositionX << PositionY << SizeX << SizeY;
+        
+        if (Ar.IsLoading())
+        {
+            Mod = FTerrainModification(FVector2D(PositionX, PositionY), FVector2D(SizeX, SizeY));
+        }
+    }
+}
+
+void FTerrainSnapshot::SerializePayload(FArchive& Ar, ETerrainSnapshotVersion Version)
+{
+    Ar << GridSettings.ResolutionX << GridSettings.ResolutionY;
+    Ar << GridSettings.Width << GridSettings.Height << GridSettings.Depth;
+    Ar << GridSettings.bUseSections << GridSettings.SectionSizeX << GridSettings.SectionSizeY;
+    
+    int32 ModificationCount = Modifications.Num();
+    Ar << ModificationCount;
+    
+    if (Ar.IsLoading())
+    {
+        // Chaque modification occupe au moins 13 octets : un compte plus grand que les données est invalide
+        if (ModificationCount < 0 || ModificationCount > (Ar.TotalSize() - Ar.Tell()) / 13)
+        {
+            Ar.SetError();
+            return;
+        }
+        Modifications.SetNum(ModificationCount);
+    }
+    
+    for (FTerrainModification& Mod : Modifications)
+    {
+        SerializeModification(Ar, Mod);
+    }
+    
+    if (Version >= ETerrainSnapshotVersion::CompactedCoverage)
+    {
+        Ar << FoldedCount;
+        Ar << CoverageRuns;
+    }
+}
+
+bool FTerrainSnapshot::Save(TArray<uint8>& OutBytes) const
+{
+    // Données brutes
+    TArray<uint8> Payload;
+    FMemoryWriter PayloadWriter(Payload);
+    const_cast<FTerrainSnapshot*>(this)->SerializePayload(PayloadWriter, ETerrainSnapshotVersion::Latest);
+    
+    // Compression Oodle, conservée seulement si elle réduit la taille
+    ETerrainSnapshotCompression Compression = ETerrainSnapshotCompression::None;
+    TArray<uint8> Compressed;
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, Payload.Num());
+    Compressed.SetNumUninitialized(CompressedSize);
+    if (FCompression::CompressMemory(NAME_Oodle, Compressed.GetData(), CompressedSize, Payload.GetData(), Payload.Num()) &&
+        CompressedSize < Payload.Num())
+    {
+        Compression = ETerrainSnapshotCompression::Oodle;
+        Compressed.SetNum(CompressedSize);
+    }
+    else
+    {
+        Compressed = Payload;
+    }
+    
+    uint32 SnapshotMagic = Magic;
+    uint16 Version = (uint16)ETerrainSnapshotVersion::Latest;
+    uint8 CompressionFormat = (uint8)Compression;
+    int32 UncompressedSize = Payload.Num();
+    int32 StoredSize = Compressed.Num();
+    uint32 Checksum = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+    
+    OutBytes.Reset();
+    FMemoryWriter Writer(OutBytes);
+    Writer << SnapshotMagic << Version << CompressionFormat << UncompressedSize << StoredSize << Checksum;
+    Writer.Serialize(Compressed.GetData(), Compressed.Num());
+    
+    return !Writer.IsError();
+}
+
+bool FTerrainSnapshot::Load(const TArray<uint8>& Bytes)
+{
+    FMemoryReader Reader(Bytes);
+    
+    uint32 SnapshotMagic = 0;
+    uint16 Version = 0;
+    uint8 CompressionFormat = 0;
+    int32 UncompressedSize = 0;
+    int32 StoredSize = 0;
+    uint32 Checksum = 0;
+    Reader << SnapshotMagic << Version << CompressionFormat << UncompressedSize << StoredSize << Checksum;
+    
+    if (Reader.IsError() || SnapshotMagic != Magic)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Terrain snapshot: invalid header"));
+        return false;
+    }
+    
+    if (Version == 0 || Version > (uint16)ETerrainSnapshotVersion::Latest)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Terrain snapshot: unsupported version %d (latest %d)"),
+            Version, (int32)ETerrainSnapshotVersion::Latest);
+        return false;
+    }
+    
+    if (UncompressedSize < 0 || UncompressedSize > MaxSnapshotPayloadBytes ||
+        StoredSize < 0 || StoredSize != Bytes.Num() - Reader.Tell())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Terrain snapshot: invalid sizes (%d stored, %d uncompressed)"), StoredSize, UncompressedSize);
+        return false;
+    }
+    
+    const uint8* Stored = Bytes.GetData() + Reader.Tell();
+    TArray<uint8> Payload;
+    Payload.SetNumUninitialized(UncompressedSize);
+    
+    switch ((ETerrainSnapshotCompression)CompressionFormat)
+    {
+    case ETerrainSnapshotCompression::None:
+        if (StoredSize != UncompressedSize)
+        {
+            return false;
+        }
+        FMemory::Memcpy(Payload.GetData(), Stored, StoredSize);
+        break;
+    
+    case ETerrainSnapshotCompression::Oodle:
+        if (!FCompression::UncompressMemory(NAME_Oodle, Payload.GetData(), UncompressedSize, Stored, StoredSize))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Terrain snapshot: decompression failed"));
+            return false;
+        }
+        break;
+    
+    default:
+        UE_LOG(LogTemp, Warning, TEXT("Terrain snapshot: unknown compression format %d"), CompressionFormat);
+        return false;
+    }
+    
+    if (FCrc::MemCrc32(Payload.GetData(), Payload.Num()) != Checksum)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Terrain snapshot: checksum mismatch"));
+        return false;
+    }
+    
+    // Lecture dans une copie : l'instantané courant n'est pas modifié en cas d'échec
+    FTerrainSnapshot Loaded;
+    FMemoryReader PayloadReader(Payload);
+    Loaded.SerializePayload(PayloadReader, (ETerrainSnapshotVersion)Version);
+    
+    if (PayloadReader.IsError() || Loaded.GridSettings.ResolutionX < 2 || Loaded.GridSettings.ResolutionY < 2)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Terrain snapshot: invalid payload"));
+        return false;
+    }
+    
+    *this = MoveTemp(Loaded);
+    return true;
+}
+
+bool FTerrainSnapshot::SaveToFile(const FString& Path) const
+{
+    TArray<uint8> Bytes;
+    return Save(Bytes) && FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+bool FTerrainSnapshot::LoadFromFile(const FString& Path)
+{
+    TArray<uint8> Bytes;
+    return FFileHelper::LoadFileToArray(Bytes, *Path) && Load(Bytes);
+}
+
+// Un fichier par terrain du monde : Saved/TerrainSnapshots/<NomDuTerrain>.tsnp
+static FString GetTerrainSnapshotPath(const ADestructibleTerrain& Terrain)
+{
+    return FPaths::ProjectSavedDir() / TEXT("TerrainSnapshots") / Terrain.GetName() + TEXT(".tsnp");
+}
+
+// Terrain.Snapshot.Save / Terrain.Snapshot.Load : point de sauvegarde serveur de tous les terrains du monde
+static FAutoConsoleCommandWithWorldAndArgs TerrainSnapshotSaveCommand(
+    TEXT("Terrain.Snapshot.Save"),
+    TEXT("Écrit un instantané de chaque terrain destructible du monde dans Saved/TerrainSnapshots."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UDestructibleTerrainSubsystem* TerrainSubsystem = World ? World->GetSubsystem<UDestructibleTerrainSubsystem>() : nullptr;
+        if (!TerrainSubsystem)
+        {
+            return;
+        }
+        
+        TArray<ADestructibleTerrain*> Terrains;
+        TerrainSubsystem->GetAllTerrains(Terrains);
+        
+        for (ADestructibleTerrain* Terrain : Terrains)
+        {
+            TArray<uint8> Bytes;
+            const FString Path = GetTerrainSnapshotPath(*Terrain);
+            if (Terrain->SaveSnapshot(Bytes) && FFileHelper::SaveArrayToFile(Bytes, *Path))
+            {
+                UE_LOG(LogTemp, Display, TEXT("%s: %d modifications saved to %s (%d bytes)"),
+                    *Terrain->GetName(), Terrain->GetTerrainModifications().Num(), *Path, Bytes.Num());
+            }
+            else
+            {
+                UE_LOG(LogTemp, Error, TEXT("%s: failed to save snapshot to %s"), *Terrain->GetName(), *Path);
+            }
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldAndArgs TerrainSnapshotLoadCommand(
+    TEXT("Terrain.Snapshot.Load"),
+    TEXT("Restaure les terrains destructibles du monde à partir de leurs instantanés (serveur)."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UDestructibleTerrainSubsystem* TerrainSubsystem = World ? World->GetSubsystem<UDestructibleTerrainSubsystem>() : nullptr;
+        if (!TerrainSubsystem)
+        {
+            return;
+        }
+        
+        TArray<ADestructibleTerrain*> Terrains;
+        TerrainSubsystem->GetAllTerrains(Terrains);
+        
+        for (ADestructibleTerrain* Terrain : Terrains)
+        {
+            TArray<uint8> Bytes;
+            const FString Path = GetTerrainSnapshotPath(*Terrain);
+            if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+            {
+                continue;
+            }
+            
+            const double StartTime = FPlatformTime::Seconds();
+            if (Terrain->LoadSnapshot(Bytes))
+            {
+                UE_LOG(LogTemp, Display, TEXT("%s: restored from %s in %.2f ms"),
+                    *Terrain->GetName(), *Path, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+            }
+            else
+            {
+                UE_LOG(LogTemp, Error, TEXT("%s: failed to restore snapshot %s"), *Terrain->GetName(), *Path);
+            }
+        }
+    }));
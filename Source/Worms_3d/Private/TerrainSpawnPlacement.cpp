@@ -0,0 +1,87 @@
+#include "TerrainSpawnPlacement.h"
+#include "ADestructibleTerrain.h"
+
+int32 FTerrainSpawnPlacement::FindSpawnTransforms(const TArray<ADestructibleTerrain*>& Terrains, int32 Count,
+    const FTerrainSpawnPlacementSettings& Settings, TArray<FTransform>& OutTransforms)
+{
+    OutTransforms.Reset();
+    if (Count <= 0)
+    {
+        return 0;
+    }
+    
+    FRandomStream Stream(Settings.Seed != 0 ? Settings.Seed : FMath::Rand());
+    
+    // 1. Candidats : un point au hasard sur le dessus de chaque cellule praticable
+    TArray<FVector> Candidates;
+    TArray<FIntPoint> SurfaceCells;
+    for (ADestructibleTerrain* Terrain : Terrains)
+    {
+        if (!Terrain)
+        {
+            continue;
+        }
+        
+        SurfaceCells.Reset();
+        Terrain->GetStandableSurfaceCells(Settings.Clearance, SurfaceCells);
+        
+        Candidates.Reserve(Candidates.Num() + SurfaceCells.Num());
+        for (const FIntPoint& Cell : SurfaceCells)
+        {
+            Candidates.Add(Terrain->GetSurfaceLocation(Cell, Stream.FRandRange(0.2f, 0.8f)));
+        }
+    }
+    
+    // 2. Ordre aléatoire (Fisher-Yates) pour que le premier arrivé ne favorise aucune zone
+    for (int32 i = Candidates.Num() - 1; i > 0; --i)
+    {
+        Candidates.Swap(i, Stream.RandRange(0, i));
+    }
+    
+    // 3. Tirage de Poisson : grille de fond de pas r / sqrt(2), seules les 5 x 5 cases voisines peuvent contenir
+    // un point trop proche. La distance est mesurée en 3D : des terrains à des profondeurs différentes peuvent placer
+    // plusieurs points dans une même case, d'où plusieurs points par case
+    const float Radius = FMath::Max(Settings.MinSeparation, 1.0f);
+    const float RadiusSquared = Radius * Radius;
+    const float GridCell = Radius / UE_SQRT_2;
+    TMultiMap<FIntPoint, FVector> Accepted;
+    Accepted.Reserve(Count);
+    
+    auto GridKey = [GridCell](const FVector& Point)
+    {
+        // Le terrain est dans le plan X/Z
+        return FIntPoint(FMath::FloorToInt(Point.X / GridCell), FMath::FloorToInt(Point.Z / GridCell));
+    };
+    
+    for (const FVector& Candidate : Candidates)
+    {
+        const FIntPoint Key = GridKey(Candidate);
+        
+        bool bTooClose = false;
+        for (int32 dy = -2; dy <= 2 && !bTooClose; ++dy)
+        {
+            for (int32 dx = -2; dx <= 2 && !bTooClose; ++dx)
+            {
+                for (TMultiMap<FIntPoint, FVector>::TConstKeyIterator It = Accepted.CreateConstKeyIterator(Key + FIntPoint(dx, dy)); It && !bTooClose; ++It)
+                {
+                    bTooClose = FVector::DistSquared(It.Value(), Candidate) < RadiusSquared;
+                }
+            }
+        }
+        
+        if (bTooClose)
+        {
+            continue;
+        }
+        
+        Accepted.Add(Key, Candidate);
+        OutTransforms.Add(FTransform(Candidate + FVector(0.0f, 0.0f, Settings.HeightOffset)));
+        
+        if (OutTransforms.Num() >= Count)
+        {
+            break;
+        }
+    }
+    
+    return OutTransforms.Num();
+}
@@ -0,0 +1,47 @@
+#include "TerrainStats.h"
+#include "ADestructibleTerrain.h"
+#include "Trace/Trace.inl"
+
+DEFINE_STAT(STAT_TerrainGenerate);
+DEFINE_STAT(STAT_TerrainApplyModifications);
+DEFINE_STAT(STAT_TerrainComputeNormals);
+DEFINE_STAT(STAT_TerrainCreateMesh);
+DEFINE_STAT(STAT_TerrainCollisionCooking);
+DEFINE_STAT(STAT_TerrainUpdateLOD);
+DEFINE_STAT(STAT_TerrainOcclusionQuery);
+DEFINE_STAT(STAT_TerrainVoxelCarve);
+DEFINE_STAT(STAT_TerrainVoxelChunkMesh);
+
+DEFINE_STAT(STAT_TerrainModificationsApplied);
+
+UE_TRACE_CHANNEL_DEFINE(TerrainChannel);
+
+UE_TRACE_EVENT_BEGIN(Terrain, Modification)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint64, DurationCycles)
+    UE_TRACE_EVENT_FIELD(uint32, TerrainId)
+    UE_TRACE_EVENT_FIELD(float, PositionX)
+    UE_TRACE_EVENT_FIELD(float, PositionY)
+    UE_TRACE_EVENT_FIELD(float, SizeX)
+    UE_TRACE_EVENT_FIELD(float, SizeY)
+    UE_TRACE_EVENT_FIELD(bool, bIsCircular)
+    UE_TRACE_EVENT_FIELD(int32, CarvedVertexCount)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, TerrainName)
+UE_TRACE_EVENT_END()
+
+void TraceTerrainModification(const ADestructibleTerrain& Terrain, const FTerrainModification& Mod,
+    uint64 StartCycle, uint64 DurationCycles, int32 CarvedVertexCount)
+{
+    // UE_TRACE_LOG déclare une variable locale portant le nom de l'événement (Modification)
+    UE_TRACE_LOG(Terrain, Modification, TerrainChannel)
+        << Modification.Cycle(StartCycle)
+        << Modification.DurationCycles(DurationCycles)
+        << Modification.TerrainId(Terrain.GetUniqueID())
+        << Modification.PositionX((float)Mod.Position.X)
+        << Modification.PositionY((float)Mod.Position.Y)
+        << Modification.SizeX((float)Mod.Size.X)
+        << Modification.SizeY((float)Mod.Size.Y)
+        << Modification.bIsCircular(Mod.bIsCircular)
+        << Modification.CarvedVertexCount(CarvedVertexCount)
+        << Modification.TerrainName(*Terrain.GetName());
+}
@@ -0,0 +1,375 @@
+#include "TerrainSurfaceNavGraph.h"
+#include "ADestructibleTerrain.h"
+#include "TerrainMemory.h"
+#include "Algo/Reverse.h"
+
+void FTerrainSurfaceNavGraph::Reset()
+{
+    Spans.Empty();
+    SectionSpans.Empty();
+    bBuilt = false;
+}
+
+void FTerrainSurfaceNavGraph::RemoveSectionSpans(const FIntPoint& SectionCoord)
+{
+    TArray<int32> Removed;
+    if (!SectionSpans.RemoveAndCopyValue(SectionCoord, Removed) || Removed.Num() == 0)
+    {
+        return;
+    }
+    
+    TSet<int32> RemovedSet(Removed);
+    
+    // Seules les portions des sections voisines peuvent pointer vers celles-ci
+    for (int32 dy = -1; dy <= 1; ++dy)
+    {
+        for (int32 dx = -1; dx <= 1; ++dx)
+        {
+            if (const TArray<int32>* Neighbours = SectionSpans.Find(SectionCoord + FIntPoint(dx, dy)))
+            {
+                for (int32 SpanId : *Neighbours)
+                {
+                    Spans[SpanId].Links.RemoveAllSwap([&RemovedSet](const FTerrainNavLink& Link)
+                    {
+                        return RemovedSet.Contains(Link.Target);
+                    });
+                }
+            }
+        }
+    }
+    
+    for (int32 SpanId : Removed)
+    {
+        Spans.RemoveAt(SpanId);
+    }
+}
+
+void FTerrainSurfaceNavGraph::BuildSectionSpans(const ADestructibleTerrain& Terrain, const FIntPoint& SectionCoord)
+{
+    FIntPoint Min, Max;
+    Terrain.GetSectionCellRange(SectionCoord, Min, Max);
+    
+    const FVector2D Step = Terrain.GetGridStep();
+    const int32 ClearCells = FMath::Max(1, FMath::CeilToInt(Terrain.NavAgentHeight / Step.Y));
+    
+    auto IsStandable = [&](int32 X, int32 Y)
+    {
+        if (!Terrain.IsCellSolid(X, Y))
+        {
+            return false;
+        }
+        
+        // Le dessus du terrain est toujours dégagé
+        for (int32 Above = Y + 1; Above <= Y + ClearCells && Above < Terrain.VerticalResolution - 1; ++Above)
+        {
+            if (Terrain.IsCellSolid(X, Above))
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    
+    TArray<int32>& Ids = SectionSpans.FindOrAdd(SectionCoord);
+    
+    for (int32 y = Min.Y; y < Max.Y; ++y)
+    {
+        int32 x = Min.X;
+        while (x < Max.X)
+        {
+            if (!IsStandable(x, y))
+            {
+                ++x;
+                continue;
+            }
+            
+            FTerrainNavSpan Span;
+            Span.Row = y;
+            Span.MinX = x;
+            Span.Section = SectionCoord;
+            while (x + 1 < Max.X && IsStandable(x + 1, y))
+            {
+                ++x;
+            }
+            Span.MaxX = x;
+            ++x;
+            
+            Ids.Add(Spans.Add(MoveTemp(Span)));
+        }
+    }
+}
+
+bool FTerrainSurfaceNavGraph::EvaluateLink(const ADestructibleTerrain& Terrain, const FTerrainNavSpan& From, const FTerrainNavSpan& To, FTerrainNavLink& OutLink) const
+{
+    const FVector2D Step = Terrain.GetGridStep();
+    
+    // Nombre de cellules vides entre les deux portions (0 si elles se touchent ou se chevauchent)
+    const int32 GapCells = FMath::Max(0, FMath::Max(From.MinX, To.MinX) - FMath::Min(From.MaxX, To.MaxX) - 1);
+    const bool bTouching = From.MaxX + 1 >= To.MinX && To.MaxX + 1 >= From.MinX;
+    const int32 Rise = To.Row - From.Row;
+    
+    const float CenterFrom = (From.MinX + From.MaxX + 1) * 0.5f * Step.X;
+    const float CenterTo = (To.MinX + To.MaxX + 1) * 0.5f * Step.X;
+    const float Distance = FVector2D(CenterTo - CenterFrom, Rise * Step.Y).Size();
+    
+    // Marche : portions voisines à une marche près
+    if (bTouching && FMath::Abs(Rise) <= 1)
+    {
+        OutLink.Cost = Distance;
+        OutLink.bJump = false;
+        return true;
+    }
+    
+    // Saut : l'écart horizontal et la montée doivent être franchissables ; une chute peut être plus haute
+    const float GapDistance = GapCells * Step.X;
+    const float Height = Rise * Step.Y;
+    const float MaxHeight = Rise >= 0 ? Terrain.NavMaxJumpHeight : Terrain.NavMaxJumpHeight * 3.0f;
+    if (GapDistance <= Terrain.NavMaxJumpDistance && FMath::Abs(Height) <= MaxHeight && IsJumpClear(Terrain, From, To))
+    {
+        OutLink.Cost = Distance * 1.5f;
+        OutLink.bJump = true;
+        return true;
+    }
+    
+    return false;
+}
+
+bool FTerrainSurfaceNavGraph::IsJumpClear(const ADestructibleTerrain& Terrain, const FTerrainNavSpan& From, const FTerrainNavSpan& To) const
+{
+    const FVector2D Step = Terrain.GetGridStep();
+    const float Depth = Terrain.Grid.GetSettings().Depth * 0.5f;
+    
+    // Pieds au centre de la première cellule au-dessus d'une portion, tête NavAgentHeight plus haut
+    auto FootPoint = [&Step, Depth](int32 Column, int32 Row)
+    {
+        return FVector((Column + 0.5f) * Step.X, Depth, (Row + 1.5f) * Step.Y);
+    };
+    const FVector Head(0.0f, 0.0f, FMath::Max(Terrain.NavAgentHeight - 0.5f * Step.Y, 0.0f));
+    
+    auto IsSegmentClear = [&Terrain](const FVector& Start, const FVector& End)
+    {
+        FTerrainGridHit Hit;
+        return !Terrain.Grid.Raycast(Start, End, Hit);
+    };
+    
+    // Départ de chaque bord de la portion, arrivée sur la cellule de la cible la plus proche du pas suivant ;
+    // trajectoire en deux segments par un sommet à la hauteur du plus haut des deux points
+    for (int32 Side = -1; Side <= 1; Side += 2)
+    {
+        const int32 LaunchColumn = Side < 0 ? From.MinX : From.MaxX;
+        const int32 LandColumn = FMath::Clamp(LaunchColumn + Side, To.MinX, To.MaxX);
+        const FVector Launch = FootPoint(LaunchColumn, From.Row);
+        const FVector Land = FootPoint(LandColumn, To.Row);
+        const FVector Apex((Launch.X + Land.X) * 0.5f, Depth, FMath::Max(Launch.Z, Land.Z));
+        
+        if (IsSegmentClear(Launch, Apex) && IsSegmentClear(Apex, Land) &&
+            IsSegmentClear(Launch + Head, Apex + Head) && IsSegmentClear(Apex + Head, Land + Head))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FTerrainSurfaceNavGraph::Update(const ADestructibleTerrain& Terrain, const TSet<FIntPoint>& DirtySections)
+{
+    LLM_SCOPE_BYTAG(Terrain_Navigation);
+    
+    TSet<FIntPoint> Sections;
+    if (!bBuilt)
+    {
+        Reset();
+        
+        FIntPoint SectionCount = Terrain.GetSectionCount();
+        for (int32 y = 0; y < SectionCount.Y; ++y)
+        {
+            for (int32 x = 0; x < SectionCount.X; ++x)
+            {
+                Sections.Add(FIntPoint(x, y));
+            }
+        }
+        bBuilt = true;
+    }
+    else
+    {
+        Sections = DirtySections;
+    }
+    
+    if (Sections.Num() == 0)
+    {
+        return;
+    }
+    
+    // 1. Remplacer les portions des sections modifiées
+    for (const FIntPoint& SectionCoord : Sections)
+    {
+        RemoveSectionSpans(SectionCoord);
+    }
+    for (const FIntPoint& SectionCoord : Sections)
+    {
+        BuildSectionSpans(Terrain, SectionCoord);
+    }
+    
+    // 2. Relier chaque nouvelle portion aux portions de sa section et des sections voisines
+    for (const FIntPoint& SectionCoord : Sections)
+    {
+        for (int32 SpanId : SectionSpans[SectionCoord])
+        {
+            for (int32 dy = -1; dy <= 1; ++dy)
+            {
+                for (int32 dx = -1; dx <= 1; ++dx)
+                {
+                    const FIntPoint Neighbour = SectionCoord + FIntPoint(dx, dy);
+                    const TArray<int32>* NeighbourIds = SectionSpans.Find(Neighbour);
+                    if (!NeighbourIds)
+                    {
+                        continue;
+                    }
+                    
+                    // Une paire de portions toutes deux reconstruites n'est traitée qu'une fois
+                    const bool bNeighbourRebuilt = Sections.Contains(Neighbour);
+                    
+                    for (int32 OtherId : *NeighbourIds)
+                    {
+                        if (OtherId == SpanId || (bNeighbourRebuilt && OtherId < SpanId))
+                        {
+                            continue;
+                        }
+                        
+                        FTerrainNavLink Link;
+                        if (EvaluateLink(Terrain, Spans[SpanId], Spans[OtherId], Link))
+                        {
+                            Link.Target = OtherId;
+                            Spans[SpanId].Links.Add(Link);
+                        }
+                        if (EvaluateLink(Terrain, Spans[OtherId], Spans[SpanId], Link))
+                        {
+                            Link.Target = SpanId;
+                            Spans[OtherId].Links.Add(Link);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+FVector FTerrainSurfaceNavGraph::GetSpanLocation(const ADestructibleTerrain& Terrain, int32 SpanId) const
+{
+    const FTerrainNavSpan& Span = Spans[SpanId];
+    const FVector2D Step = Terrain.GetGridStep();
+    return FVector((Span.MinX + Span.MaxX + 1) * 0.5f * Step.X, Terrain.TerrainDepth * 0.5f, (Span.Row + 1) * Step.Y);
+}
+
+int32 FTerrainSurfaceNavGraph::FindNearestSpan(const ADestructibleTerrain& Terrain, const FVector& LocalPoint) const
+{
+    const FVector2D Step = Terrain.GetGridStep();
+    int32 Best = INDEX_NONE;
+    float BestDistanceSquared = TNumericLimits<float>::Max();
+    
+    for (TSparseArray<FTerrainNavSpan>::TConstIterator It(Spans); It; ++It)
+    {
+        // Distance au segment formant le dessus de la portion
+        const float X = FMath::Clamp(static_cast<float>(LocalPoint.X), It->MinX * Step.X, (It->MaxX + 1) * Step.X);
+        const float Z = (It->Row + 1) * Step.Y;
+        const float DistanceSquared = FMath::Square(LocalPoint.X - X) + FMath::Square(LocalPoint.Z - Z);
+        
+        if (DistanceSquared < BestDistanceSquared)
+        {
+            BestDistanceSquared = DistanceSquared;
+            Best = It.GetIndex();
+        }
+    }
+    
+    return Best;
+}
+
+bool FTerrainSurfaceNavGraph::FindPath(const ADestructibleTerrain& Terrain, const FVector& LocalStart, const FVector& LocalGoal, TArray<FVector>& OutPath) const
+{
+    OutPath.Reset();
+    
+    const int32 StartId = FindNearestSpan(Terrain, LocalStart);
+    const int32 GoalId = FindNearestSpan(Terrain, LocalGoal);
+    if (StartId == INDEX_NONE || GoalId == INDEX_NONE)
+    {
+        return false;
+    }
+    
+    struct FOpenEntry
+    {
+        int32 SpanId;
+        float Score;
+        bool operator<(const FOpenEntry& Other) const { return Score < Other.Score; }
+    };
+    
+    const FVector GoalLocation = GetSpanLocation(Terrain, GoalId);
+    
+    TMap<int32, float> CostSoFar;
+    TMap<int32, int32> CameFrom;
+    TArray<FOpenEntry> Open;
+    
+    CostSoFar.Add(StartId, 0.0f);
+    Open.HeapPush({ StartId, FVector::Dist(GetSpanLocation(Terrain, StartId), GoalLocation) });
+    
+    bool bFound = false;
+    while (Open.Num() > 0)
+    {
+        FOpenEntry Current;
+        Open.HeapPop(Current);
+        
+        if (Current.SpanId == GoalId)
+        {
+            bFound = true;
+            break;
+        }
+        
+        const float CurrentCost = CostSoFar[Current.SpanId];
+        for (const FTerrainNavLink& Link : Spans[Current.SpanId].Links)
+        {
+            const float NewCost = CurrentCost + Link.Cost;
+            const float* KnownCost = CostSoFar.Find(Link.Target);
+            if (KnownCost && *KnownCost <= NewCost)
+            {
+                continue;
+            }
+            
+            CostSoFar.Add(Link.Target, NewCost);
+            CameFrom.Add(Link.Target, Current.SpanId);
+            
+            // Heuristique admissible : distance à vol d'oiseau
+            Open.HeapPush({ Link.Target, NewCost + FVector::Dist(GetSpanLocation(Terrain, Link.Target), GoalLocation) });
+        }
+    }
+    
+    if (!bFound)
+    {
+        return false;
+    }
+    
+    // Remonter le chemin depuis l'arrivée
+    for (int32 SpanId = GoalId; ; SpanId = CameFrom[SpanId])
+    {
+        OutPath.Add(GetSpanLocation(Terrain, SpanId));
+        if (SpanId == StartId)
+        {
+            break;
+        }
+    }
+    Algo::Reverse(OutPath);
+    
+    return true;
+}
+
+SIZE_T FTerrainSurfaceNavGraph::GetAllocatedSize() const
+{
+    SIZE_T Size = Spans.GetAllocatedSize() + SectionSpans.GetAllocatedSize();
+    for (const FTerrainNavSpan& Span : Spans)
+    {
+        Size += Span.Links.GetAllocatedSize();
+    }
+    for (const TPair<FIntPoint, TArray<int32>>& Pair : SectionSpans)
+    {
+        Size += Pair.Value.GetAllocatedSize();
+    }
+    return Size;
+}
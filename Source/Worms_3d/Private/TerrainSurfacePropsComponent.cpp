@@ -0,0 +1,305 @@
+#include "TerrainSurfacePropsComponent.h"
+#include "ADestructibleTerrain.h"
+#include "TerrainMemory.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+UTerrainSurfacePropsComponent::UTerrainSurfacePropsComponent()
+{
+    // Mis à jour sur modification uniquement, jamais à chaque frame
+    PrimaryComponentTick.bCanEverTick = false;
+    SetIsReplicatedByDefault(false);
+    
+    Seed = 0;
+}
+
+void UTerrainSurfacePropsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearAllTimersForObject(this);
+    }
+    bFlushScheduled = false;
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+ADestructibleTerrain* UTerrainSurfacePropsComponent::GetTerrain() const
+{
+    return Cast<ADestructibleTerrain>(GetOwner());
+}
+
+void UTerrainSurfacePropsComponent::MarkSectionsDirty(const FIntPoint& MinSection, const FIntPoint& MaxSection)
+{
+    // Une redispersion complète est déjà prévue : elle part de la grille à jour
+    if (!bAllDirty)
+    {
+        for (int32 y = MinSection.Y; y <= MaxSection.Y; ++y)
+        {
+            for (int32 x = MinSection.X; x <= MaxSection.X; ++x)
+            {
+                DirtySections.Add(FIntPoint(x, y));
+            }
+        }
+    }
+    ScheduleFlush();
+}
+
+void UTerrainSurfacePropsComponent::MarkAllDirty()
+{
+    bAllDirty = true;
+    DirtySections.Reset();
+    ScheduleFlush();
+}
+
+void UTerrainSurfacePropsComponent::ScheduleFlush()
+{
+    // Purement visuel : rien sur un serveur dédié
+    UWorld* World = GetWorld();
+    if (bFlushScheduled || PropTypes.Num() == 0 || !World || !World->IsGameWorld() || GetNetMode() == NM_DedicatedServer)
+    {
+        return;
+    }
+    
+    // Tous les cratères d'une frame partagent une seule mise à jour par HISM
+    bFlushScheduled = true;
+    World->GetTimerManager().SetTimerForNextTick(this, &UTerrainSurfacePropsComponent::FlushDirtySections);
+}
+
+void UTerrainSurfacePropsComponent::FlushDirtySections()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UTerrainSurfacePropsComponent::FlushDirtySections);
+    LLM_SCOPE_BYTAG(Terrain_Render);
+    
+    bFlushScheduled = false;
+    
+    const ADestructibleTerrain* Terrain = GetTerrain();
+    if (!Terrain || !Terrain->MeshData.bIsValid)
+    {
+        return;
+    }
+    
+    if (bAllDirty || Layers.Num() != PropTypes.Num())
+    {
+        bAllDirty = false;
+        DirtySections.Reset();
+        ScatterAll();
+        return;
+    }
+    
+    if (DirtySections.Num() > 0)
+    {
+        const TArray<FIntPoint> Sections = DirtySections.Array();
+        DirtySections.Reset();
+        UpdateSections(Sections);
+    }
+}
+
+FTransform UTerrainSurfacePropsComponent::MakeInstanceTransform(const FTerrainPropType& Type, const FPropInstance& Instance) const
+{
+    // Instance retirée : échelle nulle plutôt que suppression, pour garder des index stables dans le HISM
+    if (Instance.bRemoved)
+    {
+        return FTransform(FQuat::Identity, Instance.Location, FVector::ZeroVector);
+    }
+    return FTransform(FRotator(0.0f, Instance.Yaw, 0.0f), Instance.Location - FVector(0.0f, 0.0f, Type.SinkDepth), FVector(Instance.Scale));
+}
+
+void UTerrainSurfacePropsComponent::ScatterAll()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UTerrainSurfacePropsComponent::ScatterAll);
+    
+    const FTerrainGrid& Grid = GetTerrain()->Grid;
+    const FTerrainGridSettings& Settings = Grid.GetSettings();
+    const FVector2D Step = Grid.GetStep();
+    const int32 CellCountX = Grid.GetCellCountX();
+    
+    // Dispersion sur le dessus du terrain intact (la rangée de cellules du haut) : les positions ne dépendent pas des
+    // dégâts, puis le masque courant fait tomber ou disparaître les instances comme l'auraient fait les modifications
+    const int32 PristineTop = Grid.GetCellCountY() - 1;
+    
+    // Un HISM par type ; recréés seulement si la liste des types a changé
+    if (PropMeshes.Num() != PropTypes.Num())
+    {
+        for (UHierarchicalInstancedStaticMeshComponent* PropMesh : PropMeshes)
+        {
+            if (PropMesh)
+            {
+                PropMesh->DestroyComponent();
+            }
+        }
+        PropMeshes.Reset();
+        
+        for (const FTerrainPropType& Type : PropTypes)
+        {
+            UHierarchicalInstancedStaticMeshComponent* PropMesh = NewObject<UHierarchicalInstancedStaticMeshComponent>(GetOwner());
+            PropMesh->SetStaticMesh(Type.Mesh);
+            PropMesh->SetupAttachment(this);
+            PropMesh->SetIsReplicated(false);
+            
+            // Décor sans collision ni influence sur la navmesh : seul le terrain porte le gameplay
+            PropMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+            PropMesh->SetCanEverAffectNavigation(false);
+            PropMesh->SetCullDistances(0, FMath::RoundToInt(Type.CullDistance));
+            PropMesh->RegisterComponent();
+            PropMeshes.Add(PropMesh);
+        }
+    }
+    
+    Layers.SetNum(PropTypes.Num());
+    
+    int32 TotalInstances = 0;
+    for (int32 TypeIndex = 0; TypeIndex < PropTypes.Num(); ++TypeIndex)
+    {
+        const FTerrainPropType& Type = PropTypes[TypeIndex];
+        FPropLayer& Layer = Layers[TypeIndex];
+        Layer.Instances.Reset();
+        Layer.SectionInstances.Reset();
+        
+        // Tirages identiques quel que soit l'état du terrain : seules les instances sans sol sont écartées
+        FRandomStream Stream(HashCombine(GetTypeHash(Seed), GetTypeHash(TypeIndex)));
+        const int32 SlotCount = FMath::RoundToInt(Settings.Width * Type.Density / 1000.0f);
+        
+        TArray<FTransform> Transforms;
+        Transforms.Reserve(SlotCount);
+        for (int32 Slot = 0; Slot < SlotCount; ++Slot)
+        {
+            const float X = Stream.FRandRange(0.0f, Settings.Width);
+            const float Y = Stream.FRandRange(0.0f, Settings.Depth * Type.DepthFraction);
+            const float Yaw = Stream.FRandRange(0.0f, 360.0f);
+            const float Scale = Stream.FRandRange(Type.ScaleRange.X, Type.ScaleRange.Y);
+            
+            if (CellCountX <= 0 || PristineTop < 0)
+            {
+                continue;
+            }
+            
+            FPropInstance Instance;
+            Instance.SupportCell = FIntPoint(FMath::Clamp(FMath::FloorToInt(X / Step.X), 0, CellCountX - 1), PristineTop);
+            Instance.Location = FVector(X, Y, (PristineTop + 1) * Step.Y);
+            Instance.Yaw = Yaw;
+            Instance.Scale = Scale;
+            SettleInstance(Grid, Type, Instance);
+            
+            // Les instances retirées gardent leur index dans le HISM, sans section
+            const int32 InstanceIndex = Layer.Instances.Add(Instance);
+            if (!Instance.bRemoved)
+            {
+                Layer.SectionInstances.FindOrAdd(Grid.GetSectionForCell(Instance.SupportCell.X, Instance.SupportCell.Y)).Add(InstanceIndex);
+            }
+            Transforms.Add(MakeInstanceTransform(Type, Instance));
+        }
+        
+        UHierarchicalInstancedStaticMeshComponent* PropMesh = PropMeshes[TypeIndex];
+        PropMesh->ClearInstances();
+        PropMesh->AddInstances(Transforms, false);
+        TotalInstances += Transforms.Num();
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("%s: %d surface props scattered (%d types)"), *GetOwner()->GetName(), TotalInstances, PropTypes.Num());
+}
+
+bool UTerrainSurfacePropsComponent::SettleInstance(const FTerrainGrid& Grid, const FTerrainPropType& Type, FPropInstance& Instance) const
+{
+    if (Instance.bRemoved || Grid.IsCellSolid(Instance.SupportCell.X, Instance.SupportCell.Y))
+    {
+        return false;
+    }
+    
+    // Nouveau dessus de la colonne, sous l'ancien support
+    if (Type.bDropToNewSurface)
+    {
+        for (int32 y = Instance.SupportCell.Y - 1; y >= 0; --y)
+        {
+            if (Grid.IsCellSolid(Instance.SupportCell.X, y))
+            {
+                Instance.SupportCell.Y = y;
+                Instance.Location.Z = (y + 1) * Grid.GetStep().Y;
+                return true;
+            }
+        }
+    }
+    
+    Instance.bRemoved = true;
+    return true;
+}
+
+void UTerrainSurfacePropsComponent::UpdateSections(const TArray<FIntPoint>& Sections)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UTerrainSurfacePropsComponent::UpdateSections);
+    
+    const FTerrainGrid& Grid = GetTerrain()->Grid;
+    
+    int32 ChangedTotal = 0;
+    for (int32 TypeIndex = 0; TypeIndex < Layers.Num(); ++TypeIndex)
+    {
+        const FTerrainPropType& Type = PropTypes[TypeIndex];
+        FPropLayer& Layer = Layers[TypeIndex];
+        UHierarchicalInstancedStaticMeshComponent* PropMesh = PropMeshes.IsValidIndex(TypeIndex) ? PropMeshes[TypeIndex] : nullptr;
+        if (!PropMesh)
+        {
+            continue;
+        }
+        
+        // Seules les instances des sections touchées sont examinées ; celles qui tombent changent de section après coup
+        TArray<TPair<int32, FIntPoint>> Moves;
+        int32 ChangedCount = 0;
+        for (const FIntPoint& Section : Sections)
+        {
+            TArray<int32>* Indices = Layer.SectionInstances.Find(Section);
+            if (!Indices)
+            {
+                continue;
+            }
+            
+            for (int32 i = Indices->Num() - 1; i >= 0; --i)
+            {
+                const int32 InstanceIndex = (*Indices)[i];
+                FPropInstance& Instance = Layer.Instances[InstanceIndex];
+                if (!SettleInstance(Grid, Type, Instance))
+                {
+                    continue;
+                }
+                
+                Indices->RemoveAtSwap(i, 1, EAllowShrinking::No);
+                if (!Instance.bRemoved)
+                {
+                    Moves.Emplace(InstanceIndex, Grid.GetSectionForCell(Instance.SupportCell.X, Instance.SupportCell.Y));
+                }
+                
+                // Rendu marqué sale une seule fois, après toutes les instances du type
+                PropMesh->UpdateInstanceTransform(InstanceIndex, MakeInstanceTransform(Type, Instance), false, false, true);
+                ++ChangedCount;
+            }
+        }
+        
+        for (const TPair<int32, FIntPoint>& Move : Moves)
+        {
+            Layer.SectionInstances.FindOrAdd(Move.Value).Add(Move.Key);
+        }
+        
+        if (ChangedCount > 0)
+        {
+            PropMesh->MarkRenderStateDirty();
+            ChangedTotal += ChangedCount;
+        }
+    }
+    
+    UE_LOG(LogTemp, Verbose, TEXT("%s: %d surface props updated in %d sections"), *GetOwner()->GetName(), ChangedTotal, Sections.Num());
+}
+
+SIZE_T UTerrainSurfacePropsComponent::GetAllocatedSize() const
+{
+    SIZE_T Size = Layers.GetAllocatedSize() + DirtySections.GetAllocatedSize();
+    for (const FPropLayer& Layer : Layers)
+    {
+        Size += Layer.Instances.GetAllocatedSize() + Layer.SectionInstances.GetAllocatedSize();
+        for (const TPair<FIntPoint, TArray<int32>>& Pair : Layer.SectionInstances)
+        {
+            Size += Pair.Value.GetAllocatedSize();
+        }
+    }
+    return Size;
+}
@@ -0,0 +1,424 @@
+#include "VoxelTerrain.h"
+#include "TerrainVoxelMesher.h"
+#include "TerrainStats.h"
+#include "TerrainMemory.h"
+#include "DestructibleTerrainSubsystem.h"
+#include "ProceduralMeshComponent.h"
+#include "Materials/MaterialInterface.h"
+#include "Net/UnrealNetwork.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Engine/World.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+// Taille d'un cratère répliqué : centre sur 3 x int16 et rayon sur un uint16, en huitièmes de voxel
+static constexpr int32 ReplicatedCraterBytes = 4 * sizeof(uint16);
+static constexpr float CraterUnitsPerVoxel = 8.0f;
+
+AVoxelTerrain::AVoxelTerrain()
+{
+    // Aucun tick : le volume ne change que sur explosion
+    PrimaryActorTick.bCanEverTick = false;
+    
+    VolumeRoot = CreateDefaultSubobject<USceneComponent>(TEXT("VolumeRoot"));
+    RootComponent = VolumeRoot;
+    
+    // Seuls les cratères sont répliqués, jamais les meshes
+    bReplicates = true;
+    bAlwaysRelevant = true;
+    
+    VoxelSize = 50.0f;
+    ChunkSize = 16;
+    ChunkCount = FIntVector(8, 8, 4);
+    GroundLevel = 0.6f;
+    HillAmplitude = 600.0f;
+    HillWavelength = 4000.0f;
+    Seed = 0;
+    TerrainMaterial = nullptr;
+}
+
+void AVoxelTerrain::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+    
+    DOREPLIFETIME(AVoxelTerrain, Seed);
+    DOREPLIFETIME(AVoxelTerrain, ReplicatedCraters);
+}
+
+void AVoxelTerrain::BeginPlay()
+{
+    Super::BeginPlay();
+    
+    GenerateVolume();
+    
+    // Les cratères reçus avant BeginPlay (client arrivé en cours de partie) sont rejoués sur le volume neuf
+    ApplyPendingCraters();
+    
+    if (UDestructibleTerrainSubsystem* TerrainSubsystem = GetWorld()->GetSubsystem<UDestructibleTerrainSubsystem>())
+    {
+        TerrainSubsystem->RegisterVoxelTerrain(this);
+    }
+}
+
+void AVoxelTerrain::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UDestructibleTerrainSubsystem* TerrainSubsystem = GetWorld()->GetSubsystem<UDestructibleTerrainSubsystem>())
+    {
+        TerrainSubsystem->UnregisterVoxelTerrain(this);
+    }
+    
+    // Les maillages encore en vol retrouveront un pointeur faible invalide ou une version périmée
+    ChunkVersions.Reset();
+    bVolumeGenerated = false;
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+FBox AVoxelTerrain::GetTerrainWorldBounds() const
+{
+    const FVector LocalExtent = FVector(Volume.GetSettings().GetSampleCount() - FIntVector(1, 1, 1)) * Volume.GetSettings().VoxelSize;
+    return FBox(FVector::ZeroVector, LocalExtent).TransformBy(GetActorTransform());
+}
+
+bool AVoxelTerrain::IsPointInsideTerrain(const FVector& WorldLocation) const
+{
+    return bVolumeGenerated && Volume.IsPointSolid(GetActorTransform().InverseTransformPosition(WorldLocation));
+}
+
+void AVoxelTerrain::GenerateVolume()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AVoxelTerrain::GenerateVolume);
+    SCOPE_CYCLE_COUNTER(STAT_TerrainGenerate);
+    LLM_SCOPE_BYTAG(Terrain);
+    
+    FTerrainVoxelSettings Settings;
+    Settings.VoxelSize = VoxelSize;
+    Settings.ChunkSize = ChunkSize;
+    Settings.ChunkCount = ChunkCount;
+    Volume.Initialize(Settings);
+    
+    // Régénération : les anciens meshes ne correspondent plus au volume
+    for (const TPair<FIntVector, UProceduralMeshComponent*>& Pair : ChunkComponents)
+    {
+        Pair.Value->ClearAllMeshSections();
+    }
+    
+    // Sol en relief : distance signée approchée par l'écart vertical à la surface (positive sous le sol)
+    const float VolumeHeight = (Volume.GetSettings().GetSampleCount().Z - 1) * Volume.GetSettings().VoxelSize;
+    const float BaseHeight = VolumeHeight * GroundLevel;
+    const float Frequency = 1.0f / HillWavelength;
+    const FVector2D NoiseOffset(Seed * 0.6180339f, Seed * 0.3819660f);
+    const float Amplitude = HillAmplitude;
+    
+    Volume.Fill([BaseHeight, Frequency, NoiseOffset, Amplitude](const FVector& Position)
+    {
+        const FVector2D NoisePosition = FVector2D(Position.X, Position.Y) * Frequency + NoiseOffset;
+        const float Height = BaseHeight + Amplitude * (FMath::PerlinNoise2D(NoisePosition) + 0.5f * FMath::PerlinNoise2D(NoisePosition * 2.0f));
+        return Height - Position.Z;
+    });
+    bVolumeGenerated = true;
+    
+    // Seuls les chunks que la surface peut traverser sont maillés : le sous-sol plein et le ciel ne coûtent rien
+    TArray<FIntVector> SurfaceChunks;
+    const FIntVector Count = Volume.GetSettings().ChunkCount;
+    for (int32 z = 0; z < Count.Z; ++z)
+    {
+        for (int32 y = 0; y < Count.Y; ++y)
+        {
+            for (int32 x = 0; x < Count.X; ++x)
+            {
+                if (Volume.MayContainSurface(FIntVector(x, y, z)))
+                {
+                    SurfaceChunks.Add(FIntVector(x, y, z));
+                }
+            }
+        }
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("%s: voxel volume generated, %d dense chunks, %d surface chunks, %.1f KB"),
+        *GetName(), Volume.GetDenseChunkCount(), SurfaceChunks.Num(), Volume.GetAllocatedSize() / 1024.0f);
+    
+    RemeshChunks(SurfaceChunks);
+}
+
+void AVoxelTerrain::CarveCrater(const FVector& WorldCenter, float Radius)
+{
+    if (!HasAuthority() || Radius <= 0.0f)
+    {
+        return;
+    }
+    
+    FVoxelCrater Crater;
+    Crater.Center = GetActorTransform().InverseTransformPosition(WorldCenter);
+    Crater.Radius = Radius / GetActorScale3D().GetMax();
+    
+    // Hors du volume : rien à creuser ni à répliquer
+    const FVector LocalExtent = FVector(Volume.GetSettings().GetSampleCount() - FIntVector(1, 1, 1)) * Volume.GetSettings().VoxelSize;
+    if (FBox(FVector::ZeroVector, LocalExtent).ComputeSquaredDistanceToPoint(Crater.Center) > FMath::Square(Crater.Radius))
+    {
+        return;
+    }
+    
+    // Le serveur creuse les valeurs quantifiées, exactement celles que reçoivent les clients
+    {
+        TArray<uint8> Bytes;
+        FMemoryWriter Writer(Bytes);
+        WriteCrater(Writer, Crater);
+        FMemoryReader Reader(Bytes);
+        Crater = ReadCrater(Reader);
+    }
+    
+    Craters.Add(Crater);
+    if (!ReplicateCraters())
+    {
+        // Liste trop grosse : les cratères contenus dans un cratère plus récent ne changent rien au volume
+        const int32 CountBefore = Craters.Num();
+        for (int32 i = Craters.Num() - 2; i >= 0; --i)
+        {
+            for (int32 j = i + 1; j < Craters.Num(); ++j)
+            {
+                if (Craters[i].IsContainedIn(Craters[j]))
+                {
+                    Craters.RemoveAt(i);
+                    break;
+                }
+            }
+        }
+        
+        // Volume du serveur déjà à jour pour les anciens cratères ; les clients rejouent la liste élaguée
+        const bool bPruned = Craters.Num() < CountBefore;
+        if (bPruned)
+        {
+            CraterEpoch++;
+            AppliedCraterCount = Craters.Num() - 1;
+        }
+        
+        if (!ReplicateCraters())
+        {
+            Craters.Pop();
+            AppliedCraterCount = Craters.Num();
+            if (bPruned)
+            {
+                ReplicateCraters();
+            }
+            UE_LOG(LogTemp, Warning, TEXT("%s: crater list full (%d craters, max %d bytes), crater ignored"),
+                *GetName(), Craters.Num(), FTerrainReplicatedBytes::MaxBytes);
+            return;
+        }
+        
+        UE_LOG(LogTemp, Log, TEXT("%s: pruned %d contained craters, %d kept"), *GetName(), CountBefore - Craters.Num(), Craters.Num());
+    }
+    
+    // Le serveur applique tout de suite ; les clients passent par OnRep_Craters
+    ApplyPendingCraters();
+}
+
+bool AVoxelTerrain::ReplicateCraters()
+{
+    LLM_SCOPE_BYTAG(Terrain_Modifications);
+    
+    TArray<uint8> Bytes;
+    Bytes.Reserve(sizeof(int32) + Craters.Num() * ReplicatedCraterBytes);
+    FMemoryWriter Writer(Bytes);
+    
+    int32 Epoch = CraterEpoch;
+    Writer << Epoch;
+    for (const FVoxelCrater& Crater : Craters)
+    {
+        WriteCrater(Writer, Crater);
+    }
+    return ReplicatedCraters.SetBytes(Bytes);
+}
+
+void AVoxelTerrain::WriteCrater(FArchive& Ar, const FVoxelCrater& Crater) const
+{
+    const float Scale = CraterUnitsPerVoxel / VoxelSize;
+    int16 X = (int16)FMath::Clamp(FMath::RoundToInt(Crater.Center.X * Scale), (int32)MIN_int16, (int32)MAX_int16);
+    int16 Y = (int16)FMath::Clamp(FMath::RoundToInt(Crater.Center.Y * Scale), (int32)MIN_int16, (int32)MAX_int16);
+    int16 Z = (int16)FMath::Clamp(FMath::RoundToInt(Crater.Center.Z * Scale), (int32)MIN_int16, (int32)MAX_int16);
+    uint16 R = (uint16)FMath::Clamp(FMath::RoundToInt(Crater.Radius * Scale), 1, (int32)MAX_uint16);
+    Ar << X << Y << Z << R;
+}
+
+FVoxelCrater AVoxelTerrain::ReadCrater(FArchive& Ar) const
+{
+    int16 X = 0, Y = 0, Z = 0;
+    uint16 R = 0;
+    Ar << X << Y << Z << R;
+    
+    const float Unit = VoxelSize / CraterUnitsPerVoxel;
+    FVoxelCrater Crater;
+    Crater.Center = FVector(X, Y, Z) * Unit;
+    Crater.Radius = R * Unit;
+    return Crater;
+}
+
+void AVoxelTerrain::OnRep_Craters()
+{
+    TArray<uint8> Bytes;
+    if (!ReplicatedCraters.GetBytes(Bytes))
+    {
+        // Morceaux encore en route : la liste complète arrivera avec le prochain OnRep
+        return;
+    }
+    
+    int32 Epoch = 0;
+    Craters.Reset();
+    if (Bytes.Num() >= (int32)sizeof(int32))
+    {
+        FMemoryReader Reader(Bytes);
+        Reader << Epoch;
+        
+        const int32 Count = (Bytes.Num() - (int32)sizeof(int32)) / ReplicatedCraterBytes;
+        Craters.Reserve(Count);
+        for (int32 i = 0; i < Count; ++i)
+        {
+            Craters.Add(ReadCrater(Reader));
+        }
+    }
+    
+    // Liste élaguée par le serveur : le volume local est régénéré puis la nouvelle liste rejouée
+    if (Epoch != CraterEpoch)
+    {
+        CraterEpoch = Epoch;
+        if (AppliedCraterCount > 0)
+        {
+            AppliedCraterCount = 0;
+            if (bVolumeGenerated)
+            {
+                GenerateVolume();
+            }
+        }
+    }
+    
+    ApplyPendingCraters();
+}
+
+void AVoxelTerrain::ApplyPendingCraters()
+{
+    if (!bVolumeGenerated)
+    {
+        return;
+    }
+    
+    // Liste réinitialisée par le serveur (nouvelle partie) : le volume est régénéré avant de rejouer les cratères
+    if (AppliedCraterCount > Craters.Num())
+    {
+        AppliedCraterCount = 0;
+        GenerateVolume();
+    }
+    
+    if (AppliedCraterCount == Craters.Num())
+    {
+        return;
+    }
+    
+    TArray<FIntVector> TouchedChunks;
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(AVoxelTerrain::CarveCraters);
+        SCOPE_CYCLE_COUNTER(STAT_TerrainVoxelCarve);
+        LLM_SCOPE_BYTAG(Terrain_Modifications);
+        
+        // Plusieurs cratères reçus ensemble ne remaillent chaque chunk touché qu'une fois
+        for (; AppliedCraterCount < Craters.Num(); ++AppliedCraterCount)
+        {
+            const FVoxelCrater& Crater = Craters[AppliedCraterCount];
+            Volume.CarveSphere(Crater.Center, Crater.Radius, TouchedChunks);
+        }
+    }
+    
+    RemeshChunks(TouchedChunks);
+}
+
+void AVoxelTerrain::RemeshChunks(const TArray<FIntVector>& ChunkCoords)
+{
+    const FTerrainVoxelSettings& Settings = Volume.GetSettings();
+    TWeakObjectPtr<AVoxelTerrain> WeakThis(this);
+    
+    for (const FIntVector& ChunkCoord : ChunkCoords)
+    {
+        const uint32 Version = ++ChunkVersions.FindOrAdd(ChunkCoord);
+        
+        // Le thread de travail ne lit qu'une copie : le volume peut être creusé de nouveau pendant le maillage
+        TArray<int8> PaddedSamples;
+        Volume.CopyPaddedChunk(ChunkCoord, PaddedSamples);
+        
+        const FVector ChunkOrigin = FVector(ChunkCoord * Settings.ChunkSize) * Settings.VoxelSize;
+        const int32 ChunkSamples = Settings.ChunkSize;
+        const float ChunkVoxelSize = Settings.VoxelSize;
+        
+        UE::Tasks::Launch(UE_SOURCE_LOCATION,
+            [WeakThis, ChunkCoord, Version, ChunkOrigin, ChunkSamples, ChunkVoxelSize, PaddedSamples = MoveTemp(PaddedSamples)]()
+            {
+                TRACE_CPUPROFILER_EVENT_SCOPE(AVoxelTerrain::BuildChunkMesh);
+                SCOPE_CYCLE_COUNTER(STAT_TerrainVoxelChunkMesh);
+                
+                TSharedRef<FTerrainVoxelChunkMesh, ESPMode::ThreadSafe> Mesh = MakeShared<FTerrainVoxelChunkMesh, ESPMode::ThreadSafe>();
+                FTerrainVoxelMesher::BuildChunkMesh(PaddedSamples, ChunkSamples, ChunkOrigin, ChunkVoxelSize, *Mesh);
+                
+                AsyncTask(ENamedThreads::GameThread, [WeakThis, ChunkCoord, Version, Mesh]()
+                {
+                    if (AVoxelTerrain* Terrain = WeakThis.Get())
+                    {
+                        Terrain->OnChunkMeshBuilt(ChunkCoord, Version, *Mesh);
+                    }
+                });
+            });
+    }
+}
+
+void AVoxelTerrain::OnChunkMeshBuilt(const FIntVector& ChunkCoord, uint32 Version, const FTerrainVoxelChunkMesh& Mesh)
+{
+    // Un maillage plus récent du même chunk est déjà en route
+    const uint32* CurrentVersion = ChunkVersions.Find(ChunkCoord);
+    if (!CurrentVersion || *CurrentVersion != Version)
+    {
+        return;
+    }
+    
+    TRACE_CPUPROFILER_EVENT_SCOPE(AVoxelTerrain::OnChunkMeshBuilt);
+    SCOPE_CYCLE_COUNTER(STAT_TerrainCreateMesh);
+    LLM_SCOPE_BYTAG(Terrain_MeshData);
+    
+    if (Mesh.IsEmpty())
+    {
+        // Chunk entièrement creusé : son composant reste, vide et sans collision
+        if (UProceduralMeshComponent* const* Existing = ChunkComponents.Find(ChunkCoord))
+        {
+            (*Existing)->ClearAllMeshSections();
+        }
+        return;
+    }
+    
+    UProceduralMeshComponent* ChunkMesh = FindOrCreateChunkComponent(ChunkCoord);
+    ChunkMesh->CreateMeshSection(0, Mesh.Vertices, Mesh.Triangles, Mesh.Normals, TArray<FVector2D>(), TArray<FColor>(),
+        TArray<FProcMeshTangent>(), true);
+    if (TerrainMaterial)
+    {
+        ChunkMesh->SetMaterial(0, TerrainMaterial);
+    }
+}
+
+UProceduralMeshComponent* AVoxelTerrain::FindOrCreateChunkComponent(const FIntVector& ChunkCoord)
+{
+    if (UProceduralMeshComponent* const* Existing = ChunkComponents.Find(ChunkCoord))
+    {
+        return *Existing;
+    }
+    
+    const FName ComponentName(*FString::Printf(TEXT("VoxelChunk_%d_%d_%d"), ChunkCoord.X, ChunkCoord.Y, ChunkCoord.Z));
+    UProceduralMeshComponent* ChunkMesh = NewObject<UProceduralMeshComponent>(this, ComponentName);
+    ChunkMesh->SetupAttachment(VolumeRoot);
+    ChunkMesh->SetIsReplicated(false);
+    
+    // Collision complexe propre au chunk, cuite hors du game thread : un cratère ne recuit que ses chunks
+    ChunkMesh->bUseAsyncCooking = true;
+    ChunkMesh->bUseComplexAsSimpleCollision = true;
+    ChunkMesh->SetCollisionProfileName(TEXT("BlockAll"));
+    ChunkMesh->SetCanEverAffectNavigation(false);
+    ChunkMesh->RegisterComponent();
+    
+    ChunkComponents.Add(ChunkCoord, ChunkMesh);
+    return ChunkMesh;
+}
@@ -5,6 +5,8 @@
 #include "Blueprint/UserWidget.h"
 #include "Kismet/GameplayStatics.h"
 #include "WormGameState.h"
+#include "DestructibleTerrainSubsystem.h"
+#include "TerrainSpawnPlacement.h"
 
 AWormGameMode::AWormGameMode()
 {
@@ -15,6 +17,9 @@ AWormGameMode::AWormGameMode()
     CurrentPlayerIndex = 0;
     NewVar = 0;
     local = false;
+    IslandSize = 600.0f;
+    WormSpawnSeparation = 300.0f;
+    IslandSpacing = 400.0f;
     
     // Définir explicitement la classe du GameState
     GameStateClass = AWormGameState::StaticClass();
@@ -30,9 +35,6 @@ void AWormGameMode::BeginPlay()
     // Collecter tous les controllers
     GatherAllPlayerControllers();
     
-    // Collecter les points de spawn
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AActor::StaticClass(), SpawnPoints);
-    
     GetWorldTimerManager().SetTimer(TerrainSpawnTimerHandle, this, &AWormGameMode::SpawnDestructibleTerrain, 2.0f, false);
     // Initialiser les armes pour tous les joueurs
     GetWorldTimerManager().SetTimer(WeaponSpawnTimerHandle, this, &AWormGameMode::InitializeWeaponsForAllPlayers, 1.0f, false);
@@ -104,6 +106,16 @@ AWormCharacter* AWormGameMode::GetWormCharacterFromController(AController* Contr
     APawn* ControlledPawn = Controller->GetPawn();
     return Cast<AWormCharacter>(ControlledPawn);
 }
+AWormCharacter* AWormGameMode::GetActiveWorm() const
+{
+    if (!AllPlayerControllers.IsValidIndex(CurrentPlayerIndex) || !AllPlayerControllers[CurrentPlayerIndex])
+    {
+        return nullptr;
+    }
+    
+    return Cast<AWormCharacter>(AllPlayerControllers[CurrentPlayerIndex]->GetPawn());
+}
+
 void AWormGameMode::StartNextTurn()
 {
     // Vérifier qu'il y a des controllers actifs
@@ -360,6 +372,16 @@ void AWormGameMode::SpawnDestructibleTerrain()
         return;
     }
 
+    // Scénario multi-îles reproductible sans carte dédiée : option d'URL ?Islands=LxH (ou ?Islands seul pour 4 x 4)
+    if (UGameplayStatics::HasOption(OptionsString, TEXT("Islands")))
+    {
+        FString CountXString, CountYString;
+        const FString IslandOption = UGameplayStatics::ParseOption(OptionsString, TEXT("Islands"));
+        IslandOption.Split(TEXT("x"), &CountXString, &CountYString);
+        SpawnTerrainIslands(FCString::Atoi(*CountXString), FCString::Atoi(*CountYString));
+        return;
+    }
+    
     UE_LOG(LogTemp, Warning, TEXT("Génération du terrain destructible..."));
 
     FActorSpawnParameters SpawnParams;
@@ -397,6 +419,9 @@ void AWormGameMode::SpawnDestructibleTerrain()
                 if (DestructibleTerrain) {
                     DestructibleTerrain->Multicast_ForceVisualUpdate();
                 }
+                
+                // Le terrain est maintenant généré : répartir les vers sur sa surface
+                PlaceWormsOnTerrain();
             },
             2.0f,
             false
@@ -408,6 +433,88 @@ void AWormGameMode::SpawnDestructibleTerrain()
     }
 }
 
+void AWormGameMode::PlaceWormsOnTerrain()
+{
+    UDestructibleTerrainSubsystem* TerrainSubsystem = GetWorld()->GetSubsystem<UDestructibleTerrainSubsystem>();
+    if (!TerrainSubsystem)
+    {
+        return;
+    }
+    
+    TArray<ADestructibleTerrain*> Terrains;
+    TerrainSubsystem->GetAllTerrains(Terrains);
+    
+    TArray<AWormCharacter*> Worms;
+    for (AController* Controller : AllPlayerControllers)
+    {
+        if (AWormCharacter* Worm = GetWormCharacterFromController(Controller))
+        {
+            Worms.Add(Worm);
+        }
+    }
+    
+    FTerrainSpawnPlacementSettings Settings;
+    Settings.MinSeparation = WormSpawnSeparation;
+    
+    const double StartTime = FPlatformTime::Seconds();
+    FTerrainSpawnPlacement::FindSpawnTransforms(Terrains, Worms.Num(), Settings, WormSpawnTransforms);
+    
+    UE_LOG(LogTemp, Log, TEXT("Placed %d/%d worms on %d terrains in %.3f ms"), 
+        WormSpawnTransforms.Num(), Worms.Num(), Terrains.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    
+    for (int32 i = 0; i < Worms.Num() && i < WormSpawnTransforms.Num(); ++i)
+    {
+        Worms[i]->SetActorLocation(WormSpawnTransforms[i].GetLocation(), false, nullptr, ETeleportType::TeleportPhysics);
+    }
+}
+
+void AWormGameMode::SpawnTerrainIslands(int32 CountX, int32 CountY)
+{
+    // Commande console sans argument : les paramètres arrivent à 0 dans un build sans éditeur
+    CountX = CountX > 0 ? CountX : 4;
+    CountY = CountY > 0 ? CountY : 4;
+    
+    TSubclassOf<ADestructibleTerrain> IslandClass = DestructibleTerrainClass ? DestructibleTerrainClass : TSubclassOf<ADestructibleTerrain>(ADestructibleTerrain::StaticClass());
+    
+    UE_LOG(LogTemp, Warning, TEXT("Génération de %d x %d îles de terrain..."), CountX, CountY);
+    
+    // Centrer la grille d'îles sur la position habituelle du terrain
+    const float Pitch = IslandSize + IslandSpacing;
+    const FVector Origin(-0.5f * CountX * Pitch, -100.0f, -2250.0f);
+    
+    for (int32 y = 0; y < CountY; ++y)
+    {
+        for (int32 x = 0; x < CountX; ++x)
+        {
+            FTransform IslandTransform(FRotator::ZeroRotator, Origin + FVector(x * Pitch, 0.0f, y * Pitch));
+            
+            // Spawn différé : chaque île a ses propres dimensions avant son initialisation
+            ADestructibleTerrain* Island = GetWorld()->SpawnActorDeferred<ADestructibleTerrain>(
+                IslandClass, IslandTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+            
+            if (!Island)
+            {
+                continue;
+            }
+            
+            Island->TerrainWidth = IslandSize;
+            Island->TerrainHeight = IslandSize;
+            Island->TerrainDepth = 500.0f;
+            Island->HorizontalResolution = 10;
+            Island->VerticalResolution = 10;
+            Island->FinishSpawning(IslandTransform);
+            
+            TerrainIslands.Add(Island);
+        }
+    }
+    
+    UE_LOG(LogTemp, Warning, TEXT("%d îles de terrain générées"), TerrainIslands.Num());
+    
+    // Les îles s'initialisent après un court délai : répartir ensuite les vers sur l'ensemble des îles
+    FTimerHandle PlacementTimerHandle;
+    GetWorldTimerManager().SetTimer(PlacementTimerHandle, this, &AWormGameMode::PlaceWormsOnTerrain, 2.0f, false);
+}
+
 void AWormGameMode::InitializeWeaponsForAllPlayers()
 {
     // Vérifier qu'on a des armes définies
@@ -4,6 +4,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "UWormGameUI.h"
 #include "WormGameState.h"
+#include "TerrainLODSubsystem.h"
 
 AWormPlayerController::AWormPlayerController()
 {
@@ -22,6 +23,39 @@ void AWormPlayerController::BeginPlay()
         0.5f,
         true // Répéter jusqu'à ce que l'UI soit créée
     );
+    
+    // La caméra locale sert de point de vue pour le LOD du terrain
+    if (IsLocalController())
+    {
+        if (UTerrainLODSubsystem* LODSubsystem = GetWorld()->GetSubsystem<UTerrainLODSubsystem>())
+        {
+            TWeakObjectPtr<AWormPlayerController> WeakThis(this);
+            LODSubsystem->RegisterViewPoint(this, [WeakThis](FVector& OutLocation)
+            {
+                if (!WeakThis.IsValid())
+                {
+                    return false;
+                }
+                
+                FRotator ViewRotation;
+                WeakThis->GetPlayerViewPoint(OutLocation, ViewRotation);
+                return true;
+            });
+        }
+    }
+}
+
+void AWormPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UWorld* World = GetWorld())
+    {
+        if (UTerrainLODSubsystem* LODSubsystem = World->GetSubsystem<UTerrainLODSubsystem>())
+        {
+            LODSubsystem->UnregisterViewPoint(this);
+        }
+    }
+    
+    Super::EndPlay(EndPlayReason);
 }
 
 
@@ -4,8 +4,19 @@
 #include "GameFramework/Actor.h"
 #include "ProceduralMeshComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "TerrainSurfaceNavGraph.h"
+#include "TerrainMemory.h"
+#include "TerrainGrid.h"
+#include "TerrainMeshTopology.h"
+#include "TerrainEditTimeline.h"
+#include "TerrainReplicatedBytes.h"
 #include "ADestructibleTerrain.generated.h"
 
+class UTerrainNavGeometryComponent;
+class UTerrainMinimapComponent;
+class UTerrainSurfacePropsComponent;
+struct FTerrainSnapshot;
+
 
 USTRUCT(BlueprintType)
 struct FTerrainModification
@@ -77,6 +88,21 @@ struct FTerrainModificationArray
     TArray<FTerrainModification> Modifications;
 };
 
+// Anciennes modifications repliées dans le masque de destruction, encodé en plages (FTerrainGrid::EncodeCarvedRuns)
+// Sa taille dépend de la forme des dégâts, pas du nombre de tirs
+USTRUCT()
+struct FTerrainCompactedCoverage
+{
+    GENERATED_BODY()
+    
+    UPROPERTY()
+    TArray<uint8> Runs;
+    
+    // Nombre de modifications repliées depuis le début de la partie
+    UPROPERTY()
+    int32 FoldedCount = 0;
+};
+
 // Structure pour stocker les données du mesh nécessaires à la réplication
 USTRUCT(BlueprintType)
 struct FTerrainMeshData
@@ -89,8 +115,8 @@ struct FTerrainMeshData
     UPROPERTY()
     TArray<int32> Triangles;
     
-    UPROPERTY()
-    TArray<FVector2D> UVs;
+    // Ni UV ni tangente stockés ni répliqués : ils sont déduits de la position locale à l'envoi au composant
+    // (ADestructibleTerrain::BuildRenderAttributes)
     
     UPROPERTY()
     TArray<FVector> Normals;
@@ -102,11 +128,84 @@ struct FTerrainMeshData
     bool bIsValid = false;
 };
 
+// Résultat d'une requête géométrique native sur le terrain (sans passer par la scène physique)
+USTRUCT(BlueprintType)
+struct FTerrainQueryHit
+{
+    GENERATED_BODY()
+    
+    // Fraction du segment [0, 1] au point d'impact
+    UPROPERTY(BlueprintReadOnly)
+    float Time = 1.0f;
+    
+    // Point d'impact et normale, en coordonnées monde
+    UPROPERTY(BlueprintReadOnly)
+    FVector Location = FVector::ZeroVector;
+    
+    UPROPERTY(BlueprintReadOnly)
+    FVector Normal = FVector::ZeroVector;
+    
+    // Cellule de la grille touchée
+    UPROPERTY(BlueprintReadOnly)
+    FIntPoint Cell = FIntPoint(INDEX_NONE, INDEX_NONE);
+};
+
+// Niveaux de détail précalculés d'une section, construits à partir du masque de destruction
+struct FTerrainSectionLODChain
+{
+    // Un mesh par niveau, le niveau 0 étant à pleine résolution
+    TArray<FTerrainMeshData> Levels;
+    
+    // Niveau actuellement envoyé au composant de rendu
+    int32 CurrentLevel = INDEX_NONE;
+    
+    // La section a été modifiée depuis la construction de la chaîne
+    bool bDirty = true;
+};
+
+// Grandeur représentée par la carte de chaleur des sections (Terrain.Debug.SectionHeatmap)
+enum class ETerrainSectionHeatmapMode : uint8
+{
+    Off,
+    RebuildCount,
+    RebuildCost,
+    TriangleDensity
+};
+
+#if !UE_BUILD_SHIPPING
+// Historique des reconstructions d'une section, affiché par la carte de chaleur de débogage
+struct FTerrainSectionDebugStats
+{
+    // Modifications ayant touché la section depuis la génération du terrain
+    int32 RebuildCount = 0;
+    
+    // Coût de la dernière reconstruction de la section (boîtes de collision et chaîne de LOD), en cycles
+    uint64 LastRebuildCycles = 0;
+};
+#endif
+
+// Représentation utilisée pour les collisions du terrain
+UENUM(BlueprintType)
+enum class ETerrainCollisionMode : uint8
+{
+    // Collision complexe cuite à partir des triangles de rendu (comportement historique)
+    ComplexMesh UMETA(DisplayName = "Complex Mesh"),
+
+    // Boîtes convexes construites par section le long du contour X/Z (terrain 2.5D)
+    SimplePrimitives UMETA(DisplayName = "Simple Primitives")
+};
+
 UCLASS()
 class WORMS_3D_API ADestructibleTerrain : public AActor
 {
     GENERATED_BODY()
     
+    friend struct FTerrainSurfaceNavGraph;
+    friend class UTerrainNavGeometryComponent;
+    friend class UTerrainMinimapComponent;
+    friend class UTerrainSurfacePropsComponent;
+    friend struct FTerrainBenchmark;
+    
 public:    
     ADestructibleTerrain();
     
@@ -136,22 +235,107 @@ public:
     UFUNCTION(NetMulticast, Reliable)
     void Multicast_NotifyInitialized(float Width, float Height, float Depth);
 
-    // RPC Multicast pour mettre à jour la géométrie du mesh sur tous les clients
-    UFUNCTION(BlueprintCallable, NetMulticast, Reliable, Category = "Terrain")
-    void Multicast_UpdateTerrainMesh(const FTerrainMeshData& InMeshData);
-
     UFUNCTION(BlueprintCallable, NetMulticast, Reliable, Category = "Terrain")
     void Multicast_ForceVisualUpdate();
 
     UPROPERTY(EditDefaultsOnly, Category = "Terrain")
     UMaterialInterface* TerrainMaterial;
     
+    // Bornes du terrain dans le monde (utilisées par UDestructibleTerrainSubsystem)
+    UFUNCTION(BlueprintCallable, Category = "Terrain")
+    FBox GetTerrainWorldBounds() const;
+    
+    // Met à jour l'entrée du terrain dans le registre spatial après un changement de dimensions
+    void UpdateTerrainRegistration();
+    
+    // Requêtes natives sur la grille du terrain : aucune trace physique, lecture seule, utilisables hors du game thread
+    // tant qu'aucune modification n'est appliquée en parallèle. Un point est dans le terrain s'il est dans une cellule pleine.
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Query")
+    bool IsPointInsideTerrain(const FVector& WorldLocation) const;
+    
+    // Premier impact d'un segment, par parcours DDA des cellules traversées
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Query")
+    bool RaycastTerrain(const FVector& Start, const FVector& End, FTerrainQueryHit& OutHit) const;
+    
+    // Premier contact d'une sphère balayée le long d'un segment
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Query")
+    bool SweepSphereTerrain(const FVector& Start, const FVector& End, float Radius, FTerrainQueryHit& OutHit) const;
+    
+    // Épaisseur de terrain traversée entre Origin et chaque cible, ajoutée à InOutSolidLengths (unités monde)
+    // Requête groupée pour les souffles d'explosion ; le terrain à moins de OriginClearance de l'origine est ignoré
+    void AccumulateOcclusion(const FVector& Origin, TArrayView<const FVector> Targets, float OriginClearance,
+        TArrayView<float> InOutSolidLengths) const;
+    
+    // Cellules pleines dont le dessus est dégagé sur au moins Clearance (surfaces où un ver peut se tenir)
+    void GetStandableSurfaceCells(float Clearance, TArray<FIntPoint>& OutCells) const;
+    
+    // Point monde sur le dessus d'une cellule, Alpha allant de 0 (bord gauche) à 1 (bord droit), à mi-profondeur
+    FVector GetSurfaceLocation(const FIntPoint& Cell, float Alpha) const;
+    
+    // Chemin sur la surface du terrain entre deux points monde (points de passage monde), pour les vers IA
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Navigation")
+    bool FindSurfacePath(const FVector& Start, const FVector& Goal, TArray<FVector>& OutPath);
+    
+    // Met à jour le graphe de navigation dans les seules sections modifiées depuis le dernier appel
+    void UpdateNavGraph();
+    const FTerrainSurfaceNavGraph& GetNavGraph() const { return NavGraph; }
+    
+    // Mémoire occupée par le terrain, par catégorie de tampon (Terrain.MemReport)
+    void GetMemoryReport(FTerrainMemoryReport& OutReport) const;
+    
+#if !UE_BUILD_SHIPPING
+    // Dessine la grille des sections colorée selon Mode, pendant LifeTime secondes (Terrain.Debug.SectionHeatmap)
+    // Les sections en attente de reconstruction sont entourées en magenta
+    void DrawSectionHeatmap(ETerrainSectionHeatmapMode Mode, float LifeTime) const;
+#endif
+    
+    // Passe au niveau de simplification suivant quand le budget mémoire est dépassé ; false si plus rien n'est possible
+    bool IncreaseMemoryPressure();
+    ETerrainMemoryPressure GetMemoryPressure() const { return MemoryPressure; }
+    
+    // Modifications récentes du terrain (les plus anciennes sont repliées dans CompactedCoverage)
+    const TArray<FTerrainModification>& GetTerrainModifications() const { return TerrainModifications; }
+    
+    // Serveur : reprend des modifications sauvegardées, rejouées dès que le terrain est initialisé
+    void RestoreModifications(const TArray<FTerrainModification>& Modifications);
+    
+    // Instantané binaire compact (paramètres de la grille + modifications), pour les points de sauvegarde du serveur
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Snapshot")
+    bool SaveSnapshot(TArray<uint8>& OutBytes) const;
+    
+    // Serveur : restaure un instantané ; le terrain est régénéré et les modifications rejouées s'il est initialisé
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Snapshot")
+    bool LoadSnapshot(const TArray<uint8>& Bytes);
+    
+    // Affichage local d'un état passé du terrain (ralentis, kill-cams) à partir de la chronologie des modifications
+    // Indisponible sur un serveur en réseau : la géométrie y fait autorité pour tous les joueurs
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Timeline")
+    bool RewindTerrainTo(float ServerTime);
+    
+    // Terrain avant les Count dernières modifications (Count = 1 : juste avant le dernier tir)
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Timeline")
+    bool RewindTerrainModifications(int32 Count);
+    
+    // Revient au terrain courant après un retour en arrière
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Timeline")
+    void ResumeLiveTerrain();
+    
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Timeline")
+    bool IsTerrainRewound() const { return bTimelineRewound; }
+    
+    // Serveur : active ou coupe les collisions sans toucher au rendu (chunks éloignés)
+    void SetTerrainCollisionActive(bool bActive);
+    bool IsTerrainCollisionActive() const { return bCollisionActive; }
+    
     // Fonction helper pour créer le mesh à partir des données
     void CreateMeshFromData(const FTerrainMeshData& MeshData);
     
     // Fonction helper pour passer des FColor aux FLinearColor
     TArray<FLinearColor> ConvertColorsToLinear(const TArray<FColor>& Colors);
     
+    // UV (X / TerrainWidth, Z / TerrainHeight) et tangentes selon la largeur, calculés pour l'envoi au composant
+    void BuildRenderAttributes(const TArray<FVector>& Vertices, TArray<FVector2D>& OutUVs, TArray<FProcMeshTangent>& OutTangents) const;
+    
     // Hauteur du terrain
     UPROPERTY(Replicated, EditAnywhere, BlueprintReadWrite, Category = "Terrain")
     float TerrainWidth;
@@ -175,9 +359,12 @@ public:
     UPROPERTY()
     TArray<FTerrainModification> AppliedModifications;
     
-    // Configuration de la structure interne
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Internal")
+    // Configuration de la structure interne ; répliquée car le serveur la coupe sous pression mémoire
+    UPROPERTY(ReplicatedUsing = OnRep_GenerateInternalStructure, EditAnywhere, BlueprintReadWrite, Category = "Terrain|Internal")
     bool bGenerateInternalStructure;
+    
+    UFUNCTION()
+    void OnRep_GenerateInternalStructure();
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Internal", meta = (EditCondition = "bGenerateInternalStructure"))
     int32 InternalLayerCount;
@@ -211,11 +398,9 @@ public:
     // Méthode pour générer la structure interne
     void GenerateInternalStructure();
     
-    // Fonction Tick pour les mises à jour périodiques
-    virtual void Tick(float DeltaTime) override;
-
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void OnConstruction(const FTransform& Transform) override;
     virtual void PostInitializeComponents() override;
     
@@ -223,13 +408,34 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UProceduralMeshComponent* TerrainMesh;
     
-    // Données de mesh répliquées (nouvelle structure)
-    UPROPERTY(ReplicatedUsing = OnRep_MeshData)
+    // Données du mesh courant, construites localement sur chaque machine à partir du journal répliqué
+    UPROPERTY()
     FTerrainMeshData MeshData;
     
-    // Callback pour quand les données de mesh sont répliquées
+    // Incrémenté par le serveur à chaque (ré)initialisation : les clients connectés régénèrent alors le terrain
+    // et rejouent le journal et la couverture répliqués, sans recevoir le mesh
+    UPROPERTY(ReplicatedUsing = OnRep_TerrainGeneration)
+    int32 TerrainGeneration = 0;
+    
+    // Génération du terrain construit localement
+    int32 BuiltTerrainGeneration = INDEX_NONE;
+    
+    UFUNCTION()
+    void OnRep_TerrainGeneration();
+    
+    // Instantané envoyé une seule fois à l'ouverture du canal : un client qui rejoint reconstruit le terrain
+    // localement au lieu de recevoir le mesh complet (découpé en morceaux, vide s'il dépasse la taille réplicable)
+    UPROPERTY(ReplicatedUsing = OnRep_JoinSnapshot)
+    FTerrainReplicatedBytes JoinSnapshot;
+    
     UFUNCTION()
-    void OnRep_MeshData();
+    void OnRep_JoinSnapshot();
+    
+    // Serveur : met à jour JoinSnapshot après chaque changement du terrain
+    void RefreshJoinSnapshot();
+    
+    // Reprend les paramètres de la grille et les modifications d'un instantané
+    void ApplySnapshot(const FTerrainSnapshot& Snapshot);
     
     // Liste des modifications apportées au terrain
     UPROPERTY(ReplicatedUsing = OnRep_TerrainModifications)
@@ -239,6 +445,65 @@ protected:
     UFUNCTION()
     void OnRep_TerrainModifications();
     
+    // Modifications repliées : TerrainModifications ne garde que les plus récentes
+    UPROPERTY()
+    FTerrainCompactedCoverage CompactedCoverage;
+    
+    // CompactedCoverage sérialisée et découpée en morceaux : les plages dépassent vite net.MaxRepArraySize
+    UPROPERTY(ReplicatedUsing = OnRep_CompactedCoverage)
+    FTerrainReplicatedBytes ReplicatedCoverage;
+    
+    UFUNCTION()
+    void OnRep_CompactedCoverage();
+    
+    // Sérialise une couverture pour ReplicatedCoverage
+    static void WriteCoverageBytes(const FTerrainCompactedCoverage& Coverage, TArray<uint8>& OutBytes);
+    
+    // Au-delà de ce nombre de modifications, les plus anciennes sont repliées dans CompactedCoverage
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Replication", meta = (ClampMin = "1"))
+    int32 MaxLoggedModifications;
+    
+    // Modifications récentes conservées telles quelles après un repli
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Replication", meta = (ClampMin = "0"))
+    int32 ModificationTailLength;
+    
+    // Masque décodé de CompactedCoverage, à reporter dans Grid quand bCoveragePending est vrai
+    // (après une régénération de la grille ou la réception d'une nouvelle couverture)
+    FTerrainGrid CoverageGrid;
+    bool bCoveragePending = false;
+    
+    // Chronologie des modifications appliquées, avec un point de contrôle toutes les TimelineCheckpointInterval
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Timeline", meta = (ClampMin = "1"))
+    int32 TimelineCheckpointInterval;
+    
+    // Mémoire maximale de la chronologie ; les états les plus anciens sont oubliés au-delà
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Timeline", meta = (ClampMin = "0"))
+    int32 TimelineMemoryBudgetKB;
+    
+    FTerrainEditTimeline Timeline;
+    
+    // Un état passé est affiché par TerrainLODMesh, le terrain courant restant intact mais masqué
+    bool bTimelineRewound = false;
+    
+    // Temps serveur : les instants enregistrés par le serveur et par les clients sont comparables
+    double GetTimelineTime() const;
+    
+    // Affiche le masque donné (état passé) sans toucher au terrain courant : rendu seul, aucune collision
+    bool ShowGridState(const FTerrainGrid& State);
+    
+    // Serveur : replie les modifications les plus anciennes quand le journal dépasse MaxLoggedModifications
+    void CompactModificationLog();
+    
+    // Décode une couverture reçue ou restaurée dans CoverageGrid
+    bool DecodeCoverage(const FTerrainCompactedCoverage& Coverage);
+    
+    // Collisions actives (coupées par le gestionnaire de chunks loin des joueurs)
+    UPROPERTY(ReplicatedUsing = OnRep_CollisionActive)
+    bool bCollisionActive;
+    
+    UFUNCTION()
+    void OnRep_CollisionActive();
+    
     // Vérifie si un vertex est dans une zone rectangulaire
     bool IsVertexInModification(const FVector& Vertex, const FTerrainModification& Modification);
     
@@ -246,12 +511,8 @@ protected:
     UPROPERTY(Replicated)
     bool bIsInitialized;
     
-    // Initialisation des tangentes (méthode séparée pour être appelée une seule fois)
-    void InitializeTangents();
-    
-    // Tableau des tangentes du terrain (pas besoin de répliquer)
-    UPROPERTY()
-    TArray<FProcMeshTangent> Tangents;
+    // Adjacence du mesh courant pour le recalcul incrémental des normales
+    FTerrainMeshTopology Topology;
     
     // Flag pour indiquer que les modifications de terrain ont été appliquées
     UPROPERTY(Replicated)
@@ -264,9 +525,6 @@ protected:
     UPROPERTY()
     TArray<int32> InternalTriangles;
 
-    UPROPERTY()
-    TArray<FVector2D> InternalUVs;
-
     UPROPERTY()
     TArray<FVector> InternalNormals;
 
@@ -294,29 +552,153 @@ protected:
     void RegenerateSections(const TArray<FIntPoint>& SectionCoords);
     bool IsVertexInSection(const FVector& Vertex, const FIntPoint& SectionCoord);
     
-    // Configuration du LOD
+    // Configuration du LOD (purement local : chaque client choisit le niveau de ses sections selon sa caméra)
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|LOD")
     bool bUseLOD;
 
+    // Distance couverte par chaque niveau de LOD : le niveau N est utilisé au-delà de N * LODDistanceThreshold
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|LOD", meta = (EditCondition = "bUseLOD"))
     float LODDistanceThreshold;
 
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|LOD", meta = (EditCondition = "bUseLOD"))
-    int32 LODHorizontalResolution;
+    // Nombre de niveaux précalculés par section (le niveau N saute 2^N vertices de la grille)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|LOD", meta = (EditCondition = "bUseLOD", ClampMin = "1", ClampMax = "6"))
+    int32 LODLevelCount;
 
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|LOD", meta = (EditCondition = "bUseLOD"))
-    int32 LODVerticalResolution;
+    // Marge relative autour des seuils pour éviter qu'une section oscille entre deux niveaux
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|LOD", meta = (EditCondition = "bUseLOD", ClampMin = "0.0", ClampMax = "0.5"))
+    float LODHysteresis;
+
+    // Minimap du terrain, mise à jour par régions à chaque modification (absente d'un serveur dédié)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    UTerrainMinimapComponent* Minimap;
+    
+    // Props de surface (rochers, herbe, débris) en HISM, repris section par section à chaque modification
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    UTerrainSurfacePropsComponent* SurfaceProps;
+    
+    // Profondeur des jupes ajoutées sur les bords de section pour masquer les fissures entre niveaux différents
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|LOD", meta = (EditCondition = "bUseLOD", ClampMin = "0.0"))
+    float LODSkirtDepth;
+
+    // Mesh de rendu par section, jamais répliqué ni utilisé pour les collisions
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    UProceduralMeshComponent* TerrainLODMesh;
+
+    // Chaîne de LOD de chaque section, reconstruite uniquement quand la section est modifiée
+    TMap<FIntPoint, FTerrainSectionLODChain> SectionLODChains;
 
-    // Méthodes pour la gestion du LOD
+public:
+    // Réévalue le LOD des sections à partir des points de vue du UTerrainLODSubsystem
     UFUNCTION()
     void UpdateLOD();
 
+protected:
+    bool IsLODActive() const;
+    int32 GetSectionRenderIndex(const FIntPoint& SectionCoord) const;
+    void ResetLODSections();
+    void BuildSectionLODChain(const FIntPoint& SectionCoord, FTerrainSectionLODChain& OutChain) const;
+    void BuildSectionLODMesh(const FIntPoint& SectionCoord, int32 Stride, FTerrainMeshData& OutMeshData) const;
+    void AddSectionSkirts(const FIntPoint& Min, const FIntPoint& Max, const TArray<int32>& Columns, const TArray<int32>& Rows, int32 Stride, FTerrainMeshData& InOutMeshData) const;
+    int32 SelectSectionLODLevel(float Distance, int32 CurrentLevel) const;
+    void UploadSectionLOD(const FIntPoint& SectionCoord, FTerrainSectionLODChain& Chain, int32 Level);
+
+    // Configuration de la navigation de surface
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Navigation")
+    float NavAgentHeight;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Navigation")
+    float NavMaxJumpDistance;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Navigation")
+    float NavMaxJumpHeight;
+
+    // Graphe de navigation et sections à reconstruire
+    FTerrainSurfaceNavGraph NavGraph;
+    TSet<FIntPoint> DirtyNavSections;
+
+    // Géométrie fournie à la navmesh du moteur, tuile par tuile
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    UTerrainNavGeometryComponent* NavGeometry;
+
+    // Nombre maximal de sections dont la navmesh est invalidée par frame après une modification
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Navigation", meta = (ClampMin = "1"))
+    int32 NavDirtySectionsPerFrame;
+
+    // Sections en attente d'invalidation de la navmesh
+    TSet<FIntPoint> PendingNavDirtySections;
+    bool bNavFlushScheduled = false;
+
+    // Invalide la navmesh sur les seules sections modifiées, par lots limités à chaque frame
+    void ScheduleNavDirtyFlush();
+    void FlushNavDirtySections();
+    void RebuildNavGeometry();
+    FBox GetSectionWorldBounds(const FIntPoint& SectionCoord) const;
+
+    // Configuration des collisions ; répliquée pour que le serveur et les clients collisionnent sur la même géométrie
+    UPROPERTY(ReplicatedUsing = OnRep_CollisionMode, EditAnywhere, BlueprintReadOnly, Category = "Terrain|Collision")
+    ETerrainCollisionMode CollisionMode;
+    
     UFUNCTION()
-    float GetDistanceToNearestPlayer();
+    void OnRep_CollisionMode();
 
-    UPROPERTY()
-    bool bIsUsingLOD;
+    // Masque 2D (X/Z) des vertices de la grille détruits par les modifications (module TerrainCore)
+    // Le terrain étant extrudé selon Y, un seul masque suffit pour toutes les faces et couches
+    FTerrainGrid Grid;
+
+    // Boîtes de collision simples mises en cache par section
+    TMap<FIntPoint, TArray<FBox>> SectionCollisionBoxes;
+
+    // Sections dont les boîtes de collision doivent être reconstruites
+    TSet<FIntPoint> DirtyCollisionSections;
+
+#if !UE_BUILD_SHIPPING
+    // Reconstructions par section pour la carte de chaleur (absent des builds Shipping)
+    TMap<FIntPoint, FTerrainSectionDebugStats> SectionDebugStats;
+    void AddSectionRebuildCycles(const FIntPoint& SectionCoord, uint64 Cycles);
+    
+    // Triangles affichés par section : niveau de LOD courant, sinon mesh complet
+    void CountSectionTriangles(TMap<FIntPoint, int32>& OutCounts) const;
+#endif
+
+    // Méthodes pour le masque de destruction
+    FVector2D GetGridStep() const;
+    FTerrainGridSettings MakeGridSettings() const;
+    void SyncGridSettings();
+    void ResetCarvedVertices();
+    void CarveVertices(const FTerrainModification& Modification, TArray<int32>* OutNewlyCarved = nullptr);
+    
+    // CarvedCells : cellules [Min, Max] touchées, pour la minimap ; à défaut, toutes les cellules des sections
+    void MarkCarvedSectionsDirty(const FIntPoint& MinSection, const FIntPoint& MaxSection, const FIntRect* CarvedCells = nullptr);
+    
+    // Retire du mesh les triangles des vertices de la grille détruits et recalcule les normales touchées
+    // FallbackModifications sert au test par position quand la disposition du mesh ne suit pas la grille
+    void RemoveCarvedGeometry(const TArray<int32>& NewlyCarved, const TArray<FTerrainModification>& FallbackModifications);
+    bool IsGridVertexCarved(int32 X, int32 Y) const;
+    bool IsCellSolid(int32 X, int32 Y) const;
+
+    // Correspondance entre cellules de la grille et sections
+    FIntPoint GetSectionCount() const;
+    FIntPoint GetSectionForCell(int32 X, int32 Y) const;
+    
+    // Plage de cellules [Min, Max[ appartenant à une section
+    void GetSectionCellRange(const FIntPoint& SectionCoord, FIntPoint& OutMin, FIntPoint& OutMax) const;
+
+    // Boîte locale d'une cellule sur toute la profondeur du terrain
+    FBox GetCellBox(int32 X, int32 Y) const;
+    
+    // Une sphère (en coordonnées locales) recouvre-t-elle une cellule pleine ?
+    bool OverlapSphereLocal(const FVector& Center, float Radius, FVector* OutClosestPoint = nullptr, FIntPoint* OutCell = nullptr) const;
+
+    // Méthodes pour les collisions simples
+    void BuildSectionCollisionBoxes(const FIntPoint& SectionCoord, TArray<FBox>& OutBoxes) const;
+    void UpdateSimpleCollision();
+
+    // Niveau de simplification imposé par le budget mémoire (propre à chaque machine)
+    ETerrainMemoryPressure MemoryPressure = ETerrainMemoryPressure::None;
+
+    // Libère les tampons de travail et la marge des tableaux
+    void TrimMemory();
 
-    // Méthode pour basculer entre les résolutions
-    void SwitchResolution(bool bUseLowResolution);
+    // Premier niveau de LOD construit et affiché (les niveaux plus fins sont sacrifiés sous pression mémoire)
+    int32 GetMinLODLevel() const;
 };
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DestructibleTerrainSubsystem.generated.h"
+
+class ADestructibleTerrain;
+class AVoxelTerrain;
+struct FTerrainQueryHit;
+enum class ETerrainSectionHeatmapMode : uint8;
+
+// Registre des terrains destructibles du monde, indexés par une grille spatiale uniforme
+// Permet à une explosion de ne toucher que les terrains dont les bornes la recouvrent
+UCLASS()
+class WORMS_3D_API UDestructibleTerrainSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+    
+public:
+    virtual void Deinitialize() override;
+    
+    // Enregistre un terrain ou met à jour ses bornes (dimensions ou position modifiées)
+    void RegisterTerrain(ADestructibleTerrain* Terrain);
+    void UnregisterTerrain(ADestructibleTerrain* Terrain);
+    
+    // Terrains dont les bornes monde recouvrent la boîte
+    void FindTerrainsInBox(const FBox& WorldBox, TArray<ADestructibleTerrain*>& OutTerrains) const;
+    
+    // Terrains recouvrant une sphère (explosions)
+    void FindTerrainsInSphere(const FVector& Center, float Radius, TArray<ADestructibleTerrain*>& OutTerrains) const;
+    
+    // Premier impact d'un segment sur l'ensemble des terrains qu'il traverse (requête native, sans physique)
+    bool RaycastTerrains(const FVector& Start, const FVector& End, FTerrainQueryHit& OutHit, ADestructibleTerrain** OutTerrain = nullptr) const;
+    
+    // Épaisseur de terrain (unités monde) entre Origin et chaque cible, cumulée sur tous les terrains traversés
+    // Un appel pour toutes les cibles d'une explosion : aucune trace physique, seulement les grilles des terrains
+    void GetTerrainOcclusion(const FVector& Origin, const TArray<FVector>& Targets, float OriginClearance, TArray<float>& OutSolidLengths) const;
+    
+    // Tous les terrains enregistrés
+    void GetAllTerrains(TArray<ADestructibleTerrain*>& OutTerrains) const;
+    
+    int32 GetTerrainCount() const { return TerrainBounds.Num(); }
+    
+    // Terrains voxel (AVoxelTerrain) : peu nombreux et volumineux, une simple liste suffit
+    void RegisterVoxelTerrain(AVoxelTerrain* Terrain);
+    void UnregisterVoxelTerrain(AVoxelTerrain* Terrain);
+    
+    // Terrains voxel dont les bornes monde recouvrent la sphère (explosions)
+    void FindVoxelTerrainsInSphere(const FVector& Center, float Radius, TArray<AVoxelTerrain*>& OutTerrains) const;
+    
+    // Compare la mémoire de tous les terrains au budget (Terrain.MemoryBudgetMB) ;
+    // s'il est dépassé, les plus gros terrains sont simplifiés un niveau à la fois jusqu'à repasser dessous
+    void EnforceMemoryBudget();
+    
+    // Taille des cellules de la grille spatiale
+    float CellSize = 2500.0f;
+    
+#if !UE_BUILD_SHIPPING
+    // Carte de chaleur des sections de tous les terrains, redessinée à intervalle régulier (Off l'arrête)
+    void SetSectionHeatmapMode(ETerrainSectionHeatmapMode Mode);
+    ETerrainSectionHeatmapMode GetSectionHeatmapMode() const { return SectionHeatmapMode; }
+#endif
+    
+private:
+    // Bornes monde de chaque terrain enregistré
+    TMap<TWeakObjectPtr<ADestructibleTerrain>, FBox> TerrainBounds;
+    
+    // Cellule -> terrains qui la recouvrent
+    TMap<FIntVector, TArray<TWeakObjectPtr<ADestructibleTerrain>>> Cells;
+    
+    TArray<TWeakObjectPtr<AVoxelTerrain>> VoxelTerrains;
+    
+    // Évite la réentrance : simplifier un terrain reconstruit son mesh, qui redemande une vérification
+    bool bEnforcingMemoryBudget = false;
+    
+    // Le budget ne peut plus être respecté : prévenu une seule fois
+    bool bMemoryBudgetExhausted = false;
+    
+#if !UE_BUILD_SHIPPING
+    ETerrainSectionHeatmapMode SectionHeatmapMode = {};
+    FTimerHandle SectionHeatmapTimerHandle;
+    
+    void DrawSectionHeatmaps();
+#endif
+    
+    void GetCellRange(const FBox& Box, FIntVector& OutMin, FIntVector& OutMax) const;
+    void RemoveFromCells(ADestructibleTerrain* Terrain, const FBox& Bounds);
+};
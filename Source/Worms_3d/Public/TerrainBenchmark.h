@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+// Mesures d'un scénario : une résolution de grille et une séquence de modifications
+struct FTerrainBenchmarkResult
+{
+    int32 Resolution = 0;
+    int32 ModificationCount = 0;
+
+    // Temps médians (ms)
+    double GenerateMs = 0.0;
+    double CreateMeshMs = 0.0;
+
+    // ApplyTerrainModifications, une modification par appel (comme une partie)
+    double ApplyMsPerModification = 0.0;
+    double ApplyMsMax = 0.0;
+
+    // Triangles restants et mémoire du terrain (FTerrainMemoryReport) en fin de séquence
+    int32 TriangleCount = 0;
+    int64 MemoryBytes = 0;
+};
+
+// Micro-benchmark du terrain destructible, lancé par la commande console Terrain.Benchmark
+// ou par le test d'automatisation Worms3d.Terrain.Benchmark (un test par résolution).
+// Exécution sans rendu : UnrealEditor-Cmd Worms_3d.uproject <Map> -game -nullrhi -unattended -ExecCmds="Terrain.Benchmark Exit"
+// ou -ExecCmds="Automation RunTests Worms3d.Terrain.Benchmark; Quit" -TestExit="Automation Test Queue Empty"
+// Les résultats sont écrits en CSV dans Saved/Profiling/TerrainBenchmark et comparés à la référence versionnée
+// Config/TerrainBenchmarkBaseline.csv (remplacée avec l'argument WriteBaseline) ; une référence absente est un échec
+struct WORMS_3D_API FTerrainBenchmark
+{
+    TArray<int32> Resolutions = { 16, 64, 128 };
+    TArray<int32> ModificationCounts = { 10, 100, 1000 };
+
+    // Répétitions des mesures de génération et de création du mesh (la médiane est retenue)
+    int32 Repeats = 3;
+
+    // Graine des séquences de modifications, identiques d'une exécution à l'autre
+    int32 Seed = 1234;
+
+    // Régression : au-delà de (1 + Threshold) fois la référence, et d'au moins MinTimeDeltaMs pour les temps
+    float RegressionThreshold = 0.2f;
+    double MinTimeDeltaMs = 0.05;
+
+    // Exécute tous les scénarios dans le monde donné (terrains temporaires, détruits à la fin)
+    void Run(UWorld* World, TArray<FTerrainBenchmarkResult>& OutResults) const;
+
+    // Nombre de métriques en régression par rapport à la référence (détails dans le log)
+    int32 CompareToBaseline(const TArray<FTerrainBenchmarkResult>& Results, const TArray<FTerrainBenchmarkResult>& Baseline) const;
+
+    // Run(), écriture du CSV de sortie puis comparaison à la référence (ou remplacement de celle-ci avec bWriteBaseline)
+    // false si aucun résultat, si la référence est absente ou illisible, ou si une métrique régresse
+    bool RunAndCompare(UWorld* World, bool bWriteBaseline, TArray<FTerrainBenchmarkResult>& OutResults) const;
+
+    static bool WriteCsv(const FString& Path, const TArray<FTerrainBenchmarkResult>& Results);
+    // false si le fichier est absent ou ne contient aucune ligne de résultat
+    static bool ReadCsv(const FString& Path, TArray<FTerrainBenchmarkResult>& OutResults);
+
+    static FString GetBaselinePath();
+    static FString GetOutputPath();
+
+private:
+    void RunResolution(UWorld* World, int32 Resolution, TArray<FTerrainBenchmarkResult>& OutResults) const;
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ADestructibleTerrain.h"
+#include "TerrainChunkManager.generated.h"
+
+// État d'un chunk, conservé même quand son acteur est déchargé
+USTRUCT()
+struct FTerrainChunkRecord
+{
+    GENERATED_BODY()
+    
+    // Acteur du chunk (nullptr tant qu'il n'est pas chargé)
+    UPROPERTY()
+    ADestructibleTerrain* Chunk = nullptr;
+    
+    // Instantané sauvegardé au déchargement (modifications et couverture repliée), rejoué au rechargement
+    UPROPERTY()
+    TArray<uint8> Snapshot;
+};
+
+// Terrain découpé en une grille de chunks de taille fixe, chacun étant un ADestructibleTerrain indépendant
+// (mesh, collisions et liste de modifications propres). Le serveur charge les chunks proches des joueurs
+// et du ver actif, coupe les collisions des chunks à mi-distance et décharge les plus lointains.
+UCLASS()
+class WORMS_3D_API ATerrainChunkManager : public AActor
+{
+    GENERATED_BODY()
+    
+public:
+    ATerrainChunkManager();
+    
+    // Classe des chunks (ADestructibleTerrain par défaut)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Chunks")
+    TSubclassOf<ADestructibleTerrain> ChunkClass;
+    
+    // Nombre de chunks en largeur (X) et en hauteur (Z)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Chunks", meta = (ClampMin = "1"))
+    int32 ChunkCountX;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Chunks", meta = (ClampMin = "1"))
+    int32 ChunkCountY;
+    
+    // Dimensions d'un chunk
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Chunks")
+    float ChunkWidth;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Chunks")
+    float ChunkHeight;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Chunks")
+    float ChunkDepth;
+    
+    // Résolution de la grille de chaque chunk
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Chunks", meta = (ClampMin = "2"))
+    int32 ChunkHorizontalResolution;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Chunks", meta = (ClampMin = "2"))
+    int32 ChunkVerticalResolution;
+    
+    // Distance en deçà de laquelle un chunk est chargé
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Streaming")
+    float StreamInDistance;
+    
+    // Distance au-delà de laquelle un chunk chargé est déchargé (supérieure à StreamInDistance)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Streaming")
+    float StreamOutDistance;
+    
+    // Distance en deçà de laquelle les collisions d'un chunk sont actives
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Streaming")
+    float CollisionDistance;
+    
+    // Intervalle entre deux évaluations du streaming
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Streaming")
+    float StreamingInterval;
+    
+    // Chunk contenant un point du monde (INDEX_NONE si hors de la grille)
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Chunks")
+    FIntPoint GetChunkAt(const FVector& WorldLocation) const;
+    
+    // Chunk chargé à ces coordonnées, s'il existe
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Chunks")
+    ADestructibleTerrain* GetLoadedChunk(FIntPoint ChunkCoord) const;
+    
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    
+    // Chunks connus, chargés ou non
+    UPROPERTY()
+    TMap<FIntPoint, FTerrainChunkRecord> Chunks;
+    
+    FTimerHandle StreamingTimerHandle;
+    
+    // Charge, met en veille ou décharge les chunks selon la distance aux points d'intérêt
+    void UpdateStreaming();
+    
+    // Joueurs (points de vue et pions) et ver actif
+    void GatherFocusPoints(TArray<FVector>& OutPoints) const;
+    
+    FBox GetChunkWorldBounds(const FIntPoint& ChunkCoord) const;
+    void LoadChunk(const FIntPoint& ChunkCoord, FTerrainChunkRecord& Record);
+    void UnloadChunk(FTerrainChunkRecord& Record);
+};
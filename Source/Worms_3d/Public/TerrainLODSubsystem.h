@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TerrainLODSubsystem.generated.h"
+
+class ADestructibleTerrain;
+
+// Fonction fournissant la position d'un point de vue (false si indisponible pour le moment)
+typedef TFunction<bool(FVector&)> FTerrainViewPointGetter;
+
+// Registre des points de vue locaux et des terrains, à la manière du significance manager :
+// les terrains ne tickent pas, ils sont réévalués uniquement quand un point de vue s'est déplacé
+UCLASS()
+class WORMS_3D_API UTerrainLODSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+    
+public:
+    virtual void Deinitialize() override;
+    
+    // Points de vue (caméras locales) ; Owner sert de clé pour le désenregistrement
+    void RegisterViewPoint(const UObject* Owner, FTerrainViewPointGetter Getter);
+    void UnregisterViewPoint(const UObject* Owner);
+    
+    // Terrains dont le LOD dépend des points de vue
+    void RegisterTerrain(ADestructibleTerrain* Terrain);
+    void UnregisterTerrain(ADestructibleTerrain* Terrain);
+    
+    // Dernières positions échantillonnées des points de vue
+    const TArray<FVector>& GetViewLocations() const { return ViewLocations; }
+    
+    // Intervalle entre deux échantillonnages des points de vue
+    float UpdateInterval = 0.25f;
+    
+    // Déplacement minimal d'un point de vue avant de réévaluer les terrains
+    float MoveThreshold = 100.0f;
+    
+private:
+    struct FViewPoint
+    {
+        TWeakObjectPtr<const UObject> Owner;
+        FTerrainViewPointGetter Getter;
+    };
+    
+    TArray<FViewPoint> ViewPoints;
+    TArray<TWeakObjectPtr<ADestructibleTerrain>> Terrains;
+    
+    // Positions utilisées lors de la dernière évaluation des terrains
+    TArray<FVector> ViewLocations;
+    
+    FTimerHandle UpdateTimerHandle;
+    
+    // Force une réévaluation au prochain échantillonnage (nouveau terrain ou point de vue)
+    bool bForceUpdate = false;
+    
+    void UpdateTimerState();
+    void SampleViewPoints();
+};
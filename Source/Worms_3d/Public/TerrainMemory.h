@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// Tags LLM des tampons du terrain (visibles avec -llm, "stat LLMFULL" ou memreport)
+// Chaque catégorie est une copie distincte : mesh répliqué, adjacence, staging interne, LOD, rendu, collision, navigation
+// Les tags Terrain_* sont des enfants de Terrain (voir TerrainMemory.cpp) ; Terrain seul reste utilisable pour le reste
+LLM_DECLARE_TAG(Terrain);
+LLM_DECLARE_TAG(Terrain_MeshData);
+LLM_DECLARE_TAG(Terrain_Topology);
+LLM_DECLARE_TAG(Terrain_Internal);
+LLM_DECLARE_TAG(Terrain_LOD);
+LLM_DECLARE_TAG(Terrain_Render);
+LLM_DECLARE_TAG(Terrain_Collision);
+LLM_DECLARE_TAG(Terrain_Navigation);
+LLM_DECLARE_TAG(Terrain_Modifications);
+
+// Niveaux de simplification imposés à un terrain quand le budget mémoire est dépassé
+// Chaque niveau inclut les précédents ; un terrain ne redescend jamais de niveau
+enum class ETerrainMemoryPressure : uint8
+{
+    None,
+
+    // Libère les tampons de travail (structure interne, marge des tableaux, caches de collision inutilisés)
+    TrimBuffers,
+
+    // Ne construit plus les niveaux de LOD les plus fins (clients)
+    CoarseLOD,
+
+    // Collision par boîtes au lieu du mesh complexe cuit (serveur uniquement, répliqué aux clients)
+    SimpleCollision,
+
+    // Régénère le terrain sans ses couches internes (serveur uniquement, répliqué aux clients)
+    DropInternalLayers
+};
+
+// Mémoire occupée par un terrain, par catégorie (octets alloués côté CPU)
+struct FTerrainMemoryReport
+{
+    int64 MeshDataBytes = 0;
+    int64 TopologyBytes = 0;
+    int64 InternalBytes = 0;
+    int64 LODBytes = 0;
+
+    // Copies CPU des sections des meshes procéduraux (les tampons GPU sont suivis par le RHI)
+    int64 RenderBytes = 0;
+
+    // Données cuites du body setup et boîtes simples en cache
+    int64 CollisionBytes = 0;
+    int64 NavigationBytes = 0;
+    int64 ModificationBytes = 0;
+
+    int64 GetTotalBytes() const
+    {
+        return MeshDataBytes + TopologyBytes + InternalBytes + LODBytes + RenderBytes +
+               CollisionBytes + NavigationBytes + ModificationBytes;
+    }
+
+    FTerrainMemoryReport& operator+=(const FTerrainMemoryReport& Other);
+
+    // Une ligne lisible, en Kio par catégorie
+    FString ToString() const;
+};
+
+// Budget mémoire de l'ensemble des terrains d'un monde, en Mio (0 = pas de limite)
+int32 GetTerrainMemoryBudgetMB();
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TerrainMinimapComponent.generated.h"
+
+class ADestructibleTerrain;
+class UTexture2D;
+
+// Minimap du terrain destructible : une texture transitoire remplie sur le CPU à partir du masque de destruction
+// Seul le rectangle touché par une modification est renvoyé au GPU (UpdateTextureRegions), au plus une fois par frame :
+// entre deux explosions, la minimap ne coûte rien (contrairement à une capture de scène rendue à chaque frame).
+UCLASS(ClassGroup = (Terrain), meta = (BlueprintSpawnableComponent))
+class WORMS_3D_API UTerrainMinimapComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UTerrainMinimapComponent();
+    
+    // Texture de la minimap (nulle sur un serveur dédié ou avant la génération du terrain)
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Minimap")
+    UTexture2D* GetTexture() const { return Texture; }
+    
+    // Position monde -> coordonnées [0, 1] de la texture (0, 0 en haut à gauche) ; false hors du terrain
+    UFUNCTION(BlueprintCallable, Category = "Terrain|Minimap")
+    bool WorldToMinimapUV(const FVector& WorldLocation, FVector2D& OutUV) const;
+    
+    // Cellules [MinCell, MaxCell] modifiées : le rectangle correspondant sera renvoyé à la prochaine frame
+    void MarkCellsDirty(const FIntPoint& MinCell, const FIntPoint& MaxCell);
+    
+    // Grille régénérée ou redimensionnée : toute la texture est reconstruite
+    void MarkAllDirty();
+    
+    SIZE_T GetAllocatedSize() const { return Pixels.GetAllocatedSize(); }
+    
+    // Plus grand côté de la texture, en pixels ; une grille plus fine est sous-échantillonnée
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Minimap", meta = (ClampMin = "16", ClampMax = "2048"))
+    int32 MaxTextureSize;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Minimap")
+    FColor SolidColor;
+    
+    // Couleur des cellules détruites (transparente par défaut : le fond du widget reste visible)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Minimap")
+    FColor EmptyColor;
+
+protected:
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    ADestructibleTerrain* GetTerrain() const;
+    
+    void ScheduleFlush();
+    void FlushDirtyRegion();
+    
+    // Recrée la texture si la grille a changé de taille ; true si elle a été recréée (et entièrement remplie)
+    bool EnsureTexture();
+    
+    // Remplit les pixels [Min, Max] à partir des cellules de la grille
+    void FillPixels(const FIntPoint& Min, const FIntPoint& Max);
+    
+    UPROPERTY(Transient)
+    UTexture2D* Texture;
+    
+    // Copie CPU de la texture (BGRA, ligne 0 en haut)
+    TArray<FColor> Pixels;
+    FIntPoint TextureSize = FIntPoint::ZeroValue;
+    
+    // Rectangle de cellules modifiées depuis le dernier envoi
+    FIntPoint DirtyMin = FIntPoint(MAX_int32, MAX_int32);
+    FIntPoint DirtyMax = FIntPoint(MIN_int32, MIN_int32);
+    bool bAllDirty = true;
+    bool bFlushScheduled = false;
+};
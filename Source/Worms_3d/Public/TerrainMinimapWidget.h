@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Styling/SlateBrush.h"
+#include "TerrainMinimapWidget.generated.h"
+
+class ADestructibleTerrain;
+
+// Widget de minimap : textures des terrains (UTerrainMinimapComponent) et position des vers par-dessus
+// Chaque terrain est dessiné à sa place dans le rectangle englobant de tous les terrains (monde en chunks).
+// Les vers sont lus dans le GameState (pions des joueurs) et dessinés à chaque paint, sans toucher aux textures.
+UCLASS()
+class WORMS_3D_API UTerrainMinimapWidget : public UUserWidget
+{
+    GENERATED_BODY()
+
+public:
+    // Terrain affiché seul ; par défaut tous les terrains du monde (UDestructibleTerrainSubsystem)
+    UPROPERTY(BlueprintReadWrite, Category = "Terrain|Minimap")
+    ADestructibleTerrain* Terrain;
+    
+    // Côté des marqueurs de vers, en unités Slate
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Minimap")
+    float WormMarkerSize = 6.0f;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Minimap")
+    FLinearColor WormColor = FLinearColor(1.0f, 0.85f, 0.2f);
+    
+    // Ver du joueur actif, dessiné plus gros
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Minimap")
+    FLinearColor ActiveWormColor = FLinearColor::Red;
+
+protected:
+    virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+private:
+    void FindTerrains(TArray<ADestructibleTerrain*>& OutTerrains) const;
+    
+    // Pinceaux des textures des terrains, mis à jour au paint
+    mutable TArray<FSlateBrush> TerrainBrushes;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "TerrainNavGeometryComponent.generated.h"
+
+class ADestructibleTerrain;
+
+// Géométrie de navigation du terrain destructible, fournie tuile par tuile au générateur de navmesh
+// Remplace l'export du mesh procédural, qui salissait toute la navmesh du terrain à chaque cratère
+UCLASS()
+class WORMS_3D_API UTerrainNavGeometryComponent : public UPrimitiveComponent
+{
+    GENERATED_BODY()
+    
+public:
+    UTerrainNavGeometryComponent();
+    
+    // Copie les boîtes pleines des sections depuis le terrain (game thread)
+    void UpdateSections(const TArray<FIntPoint>& SectionCoords);
+    void UpdateAllSections();
+    
+    // Mémoire occupée par les boîtes en cache
+    SIZE_T GetAllocatedSize() const;
+    
+    // UPrimitiveComponent
+    virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+    virtual bool IsNavigationRelevant() const override { return true; }
+    virtual bool DoCustomNavigableGeometryExport(FNavigableGeometryExport& GeomExport) const override;
+    
+    // INavRelevantInterface : la géométrie n'est rassemblée que pour les tuiles en reconstruction
+    // Le mode Lazy est imposé ici : en mode Instant (défaut du projet), GatherGeometrySlice() ne serait jamais appelé
+    virtual ENavDataGatheringMode GetGeometryGatheringMode() const override { return ENavDataGatheringMode::Lazy; }
+    virtual bool SupportsGatheringGeometrySlices() const override { return true; }
+    virtual void GatherGeometrySlice(FNavigableGeometryExport& GeomExport, const FBox& SliceBox) const override;
+    
+private:
+    ADestructibleTerrain* GetTerrain() const;
+    
+    // Exporte les boîtes pleines recouvrant LocalSlice (toutes si nullptr)
+    void ExportSectionBoxes(FNavigableGeometryExport& GeomExport, const FBox* LocalSlice) const;
+    
+    // Boîtes locales par section, lues par les tâches de génération asynchrones
+    TMap<FIntPoint, TArray<FBox>> SectionBoxes;
+    mutable FCriticalSection SectionBoxesLock;
+};
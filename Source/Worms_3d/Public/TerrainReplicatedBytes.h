@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "TerrainReplicatedBytes.generated.h"
+
+// Morceau d'un tableau d'octets répliqué (FTerrainReplicatedBytes)
+USTRUCT()
+struct FTerrainByteChunk : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+    
+    // Position du morceau et nombre de morceaux du tableau complet : l'ordre des éléments n'est pas garanti côté client
+    UPROPERTY()
+    int32 Index = 0;
+    
+    UPROPERTY()
+    int32 ChunkCount = 0;
+    
+    UPROPERTY()
+    TArray<uint8> Data;
+};
+
+// Tableau d'octets répliqué par morceaux
+// Un TArray<uint8> répliqué tel quel est tronqué par net.MaxRepArraySize (2048 éléments) : chaque morceau reste
+// sous cette limite, et seuls les morceaux modifiés sont renvoyés. Doit être une propriété de premier niveau de l'acteur.
+USTRUCT()
+struct WORMS_3D_API FTerrainReplicatedBytes : public FFastArraySerializer
+{
+    GENERATED_BODY()
+    
+    static constexpr int32 ChunkSize = 1024;
+    
+    // Au-delà, le serveur refuse d'envoyer : les tableaux complets d'un acteur partent dans un seul paquet à l'ouverture
+    // du canal, et un paquet fractionné est limité à net.MaxConstructedPartialBunchSizeBytes (64 Ko)
+    static constexpr int32 MaxBytes = 24 * 1024;
+    
+    UPROPERTY()
+    TArray<FTerrainByteChunk> Items;
+    
+    // Serveur : découpe Bytes en ne marquant que les morceaux modifiés ; false sans rien changer au-delà de MaxBytes
+    bool SetBytes(const TArray<uint8>& Bytes);
+    
+    void Reset();
+    
+    // Réassemble les morceaux ; false s'il en manque ou s'ils ne forment pas un seul tableau
+    bool GetBytes(TArray<uint8>& OutBytes) const;
+    
+    SIZE_T GetAllocatedSize() const;
+    
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FTerrainByteChunk, FTerrainReplicatedBytes>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FTerrainReplicatedBytes> : public TStructOpsTypeTraitsBase2<FTerrainReplicatedBytes>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TerrainGrid.h"
+#include "ADestructibleTerrain.h"
+
+// Versions du format binaire des instantanés (toute évolution du contenu ajoute une version)
+enum class ETerrainSnapshotVersion : uint16
+{
+    Initial = 1,
+    
+    // Masque des modifications repliées (FTerrainCompactedCoverage)
+    CompactedCoverage,
+    
+    // -----
+    VersionPlusOne,
+    Latest = VersionPlusOne - 1
+};
+
+// Instantané compact d'un terrain destructible : paramètres de la grille, modifications repliées et journal récent
+// Le mesh n'est pas stocké : il est reconstruit en rejouant les modifications sur un terrain généré.
+//
+// Format : en-tête non compressé (magie, version, format de compression, tailles, CRC32 des données brutes)
+// suivi des données compressées (Oodle, ou brutes si la compression ne gagne rien)
+struct WORMS_3D_API FTerrainSnapshot
+{
+    static constexpr uint32 Magic = 0x504E5354; // "TSNP"
+    
+    FTerrainGridSettings GridSettings;
+    TArray<FTerrainModification> Modifications;
+    
+    // Masque des modifications repliées, en plages (FTerrainGrid::EncodeCarvedRuns)
+    TArray<uint8> CoverageRuns;
+    int32 FoldedCount = 0;
+    
+    // Écrit l'instantané complet (en-tête + données compressées)
+    bool Save(TArray<uint8>& OutBytes) const;
+    
+    // Lit un instantané ; échoue sur une magie, une version, une taille ou un checksum invalide
+    bool Load(const TArray<uint8>& Bytes);
+    
+    bool SaveToFile(const FString& Path) const;
+    bool LoadFromFile(const FString& Path);
+
+private:
+    // Données brutes, avant compression
+    void SerializePayload(FArchive& Ar, ETerrainSnapshotVersion Version);
+};
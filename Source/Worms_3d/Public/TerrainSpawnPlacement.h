@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ADestructibleTerrain;
+
+// Paramètres du placement des points d'apparition
+struct FTerrainSpawnPlacementSettings
+{
+    // Distance minimale entre deux points d'apparition
+    float MinSeparation = 300.0f;
+    
+    // Espace libre nécessaire au-dessus de la surface
+    float Clearance = 200.0f;
+    
+    // Décalage vertical appliqué au point de surface (demi-hauteur de la capsule)
+    float HeightOffset = 100.0f;
+    
+    // Graine du tirage (0 : tirage différent à chaque appel)
+    int32 Seed = 0;
+};
+
+// Placement des vers sur les surfaces praticables des terrains destructibles, par échantillonnage
+// de Poisson (disques de rayon MinSeparation) parmi les cellules dont le dessus est dégagé
+struct WORMS_3D_API FTerrainSpawnPlacement
+{
+    // Remplit OutTransforms avec au plus Count points et retourne le nombre trouvé
+    static int32 FindSpawnTransforms(const TArray<ADestructibleTerrain*>& Terrains, int32 Count,
+        const FTerrainSpawnPlacementSettings& Settings, TArray<FTransform>& OutTransforms);
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+class ADestructibleTerrain;
+struct FTerrainModification;
+
+// "stat Terrain" : coût des étapes de construction du terrain et taille des mises à jour répliquées
+DECLARE_STATS_GROUP(TEXT("Terrain"), STATGROUP_Terrain, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate Terrain"), STAT_TerrainGenerate, STATGROUP_Terrain, WORMS_3D_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Modifications"), STAT_TerrainApplyModifications, STATGROUP_Terrain, WORMS_3D_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compute Normals"), STAT_TerrainComputeNormals, STATGROUP_Terrain, WORMS_3D_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Create Mesh From Data"), STAT_TerrainCreateMesh, STATGROUP_Terrain, WORMS_3D_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Collision Cooking"), STAT_TerrainCollisionCooking, STATGROUP_Terrain, WORMS_3D_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update LOD"), STAT_TerrainUpdateLOD, STATGROUP_Terrain, WORMS_3D_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Explosion Occlusion"), STAT_TerrainOcclusionQuery, STATGROUP_Terrain, WORMS_3D_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Voxel Carve"), STAT_TerrainVoxelCarve, STATGROUP_Terrain, WORMS_3D_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Voxel Chunk Meshing"), STAT_TerrainVoxelChunkMesh, STATGROUP_Terrain, WORMS_3D_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Modifications Applied"), STAT_TerrainModificationsApplied, STATGROUP_Terrain, WORMS_3D_API);
+
+// Canal Insights "Terrain" (-trace=cpu,terrain) : un événement par modification appliquée
+UE_TRACE_CHANNEL_EXTERN(TerrainChannel, WORMS_3D_API);
+
+// Émet l'événement d'une modification : instant de début et coût total (en cycles) de son application
+void TraceTerrainModification(const ADestructibleTerrain& Terrain, const FTerrainModification& Modification,
+    uint64 StartCycle, uint64 DurationCycles, int32 CarvedVertexCount);
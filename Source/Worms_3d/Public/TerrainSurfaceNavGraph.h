@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ADestructibleTerrain;
+
+// Lien entre deux portions de surface praticable
+struct FTerrainNavLink
+{
+    int32 Target = INDEX_NONE;
+    float Cost = 0.0f;
+    
+    // Saut (ou chute) plutôt que marche continue
+    bool bJump = false;
+};
+
+// Portion de surface praticable : suite de cellules pleines contiguës d'une même ligne,
+// toutes dégagées au-dessus, et limitée à une section du terrain
+struct FTerrainNavSpan
+{
+    int32 Row = 0;
+    int32 MinX = 0;    // Première cellule (incluse)
+    int32 MaxX = 0;    // Dernière cellule (incluse)
+    FIntPoint Section = FIntPoint::ZeroValue;
+    TArray<FTerrainNavLink> Links;
+};
+
+// Graphe de navigation 2D sur la surface du terrain, reconstruit section par section après une modification
+// Tout est exprimé dans le repère local du terrain (X en largeur, Z en hauteur)
+struct WORMS_3D_API FTerrainSurfaceNavGraph
+{
+    // Vide le graphe : la prochaine mise à jour reconstruit tout
+    void Reset();
+    bool IsBuilt() const { return bBuilt; }
+    
+    // Reconstruit les portions des sections données et leurs liens avec les sections voisines
+    void Update(const ADestructibleTerrain& Terrain, const TSet<FIntPoint>& DirtySections);
+    
+    // A* entre les portions les plus proches des deux points locaux ; OutPath reçoit les points de passage locaux
+    bool FindPath(const ADestructibleTerrain& Terrain, const FVector& LocalStart, const FVector& LocalGoal, TArray<FVector>& OutPath) const;
+    
+    // Portion la plus proche d'un point local (INDEX_NONE si le graphe est vide)
+    int32 FindNearestSpan(const ADestructibleTerrain& Terrain, const FVector& LocalPoint) const;
+    
+    // Milieu du dessus d'une portion, à mi-profondeur
+    FVector GetSpanLocation(const ADestructibleTerrain& Terrain, int32 SpanId) const;
+    
+    int32 GetSpanCount() const { return Spans.Num(); }
+    
+    // Mémoire allouée par le graphe (rapport mémoire du terrain)
+    SIZE_T GetAllocatedSize() const;
+    
+private:
+    TSparseArray<FTerrainNavSpan> Spans;
+    TMap<FIntPoint, TArray<int32>> SectionSpans;
+    bool bBuilt = false;
+    
+    void RemoveSectionSpans(const FIntPoint& SectionCoord);
+    void BuildSectionSpans(const ADestructibleTerrain& Terrain, const FIntPoint& SectionCoord);
+    bool EvaluateLink(const ADestructibleTerrain& Terrain, const FTerrainNavSpan& From, const FTerrainNavSpan& To, FTerrainNavLink& OutLink) const;
+    
+    // Trajectoire de saut dégagée dans la grille, pieds et tête (NavAgentHeight) compris
+    bool IsJumpClear(const ADestructibleTerrain& Terrain, const FTerrainNavSpan& From, const FTerrainNavSpan& To) const;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "TerrainSurfacePropsComponent.generated.h"
+
+class ADestructibleTerrain;
+struct FTerrainGrid;
+class UStaticMesh;
+class UHierarchicalInstancedStaticMeshComponent;
+
+// Type de prop dispersé sur le dessus du terrain (rochers, herbe, débris)
+USTRUCT(BlueprintType)
+struct FTerrainPropType
+{
+    GENERATED_BODY()
+    
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Props")
+    UStaticMesh* Mesh = nullptr;
+    
+    // Instances pour 1000 unités de largeur de terrain
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Props", meta = (ClampMin = "0.0"))
+    float Density = 20.0f;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Props")
+    FVector2D ScaleRange = FVector2D(0.8f, 1.2f);
+    
+    // Enfoncement dans le sol, en unités locales
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Props")
+    float SinkDepth = 0.0f;
+    
+    // Part de la profondeur du terrain, depuis sa face avant (Y = 0), sur laquelle les instances sont réparties
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Props", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float DepthFraction = 1.0f;
+    
+    // Sol détruit : l'instance tombe sur le nouveau dessus de sa colonne (débris) au lieu de disparaître (herbe)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Props")
+    bool bDropToNewSurface = false;
+    
+    // Distance au-delà de laquelle les instances ne sont plus affichées (0 = jamais)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Props", meta = (ClampMin = "0.0"))
+    float CullDistance = 0.0f;
+};
+
+// Props de surface du terrain destructible : un HISM par type (un seul draw call par mesh, quel que soit le nombre d'instances)
+// Les instances sont indexées par section de la grille ; une modification ne reprend que celles des sections touchées,
+// et toutes les modifications d'une frame sont envoyées au rendu en une seule mise à jour par type.
+UCLASS(ClassGroup = (Terrain), meta = (BlueprintSpawnableComponent))
+class WORMS_3D_API UTerrainSurfacePropsComponent : public USceneComponent
+{
+    GENERATED_BODY()
+
+public:
+    UTerrainSurfacePropsComponent();
+    
+    // Sections modifiées : leurs instances sans support tombent ou disparaissent à la prochaine frame
+    void MarkSectionsDirty(const FIntPoint& MinSection, const FIntPoint& MaxSection);
+    
+    // Grille régénérée ou redimensionnée : toutes les instances sont redispersées
+    void MarkAllDirty();
+    
+    SIZE_T GetAllocatedSize() const;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Props")
+    TArray<FTerrainPropType> PropTypes;
+    
+    // Graine de la dispersion : la même sur toutes les machines, indépendante des dégâts déjà subis
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terrain|Props")
+    int32 Seed;
+
+protected:
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    // Instance d'un type : sa colonne de la grille et la cellule qui la porte
+    struct FPropInstance
+    {
+        FVector Location = FVector::ZeroVector;
+        float Yaw = 0.0f;
+        float Scale = 1.0f;
+        FIntPoint SupportCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+        bool bRemoved = false;
+    };
+    
+    struct FPropLayer
+    {
+        TArray<FPropInstance> Instances;
+        
+        // Section -> instances posées sur une cellule de la section
+        TMap<FIntPoint, TArray<int32>> SectionInstances;
+    };
+    
+    ADestructibleTerrain* GetTerrain() const;
+    
+    void ScheduleFlush();
+    void FlushDirtySections();
+    
+    // Recrée les HISM, disperse toutes les instances sur le dessus du terrain intact puis applique le masque courant
+    void ScatterAll();
+    
+    // Support détruit : l'instance tombe sur le dessus restant de sa colonne ou disparaît ; false si elle ne change pas
+    bool SettleInstance(const FTerrainGrid& Grid, const FTerrainPropType& Type, FPropInstance& Instance) const;
+    
+    // Reprend les instances des sections modifiées dont la cellule support a été détruite
+    void UpdateSections(const TArray<FIntPoint>& Sections);
+    
+    FTransform MakeInstanceTransform(const FTerrainPropType& Type, const FPropInstance& Instance) const;
+    
+    UPROPERTY(Transient)
+    TArray<UHierarchicalInstancedStaticMeshComponent*> PropMeshes;
+    
+    // Données CPU de chaque type, dans l'ordre de PropTypes (index d'instance = index dans le HISM)
+    TArray<FPropLayer> Layers;
+    
+    TSet<FIntPoint> DirtySections;
+    bool bAllDirty = true;
+    bool bFlushScheduled = false;
+};
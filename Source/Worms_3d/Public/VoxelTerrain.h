@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "TerrainVoxelVolume.h"
+#include "TerrainReplicatedBytes.h"
+#include "VoxelTerrain.generated.h"
+
+class UProceduralMeshComponent;
+class UMaterialInterface;
+struct FTerrainVoxelChunkMesh;
+
+// Cratère sphérique creusé dans un terrain voxel (repère local de l'acteur), quantifié au huitième de voxel
+// par le serveur avant d'être appliqué : toutes les machines creusent exactement la même sphère
+struct FVoxelCrater
+{
+    FVector Center = FVector::ZeroVector;
+    float Radius = 0.0f;
+    
+    // Un cratère entièrement contenu dans Other ne change rien au volume une fois Other creusé
+    bool IsContainedIn(const FVoxelCrater& Other) const
+    {
+        return FVector::Dist(Center, Other.Center) + Radius <= Other.Radius;
+    }
+};
+
+// Terrain destructible en volume : densité voxel creuse par chunks (FTerrainVoxelVolume), surface extraite chunk par chunk
+// sur des threads de travail (FTerrainVoxelMesher) et un UProceduralMeshComponent par chunk, à collision cuite en asynchrone.
+// Une explosion ne modifie, ne remaille et ne recuit que les chunks qu'elle touche, quelle que soit la taille du volume.
+// Le serveur réplique la liste des cratères (par morceaux) ; chaque machine régénère le même volume et rejoue les cratères reçus.
+UCLASS()
+class WORMS_3D_API AVoxelTerrain : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AVoxelTerrain();
+    
+    // Creuse une sphère (coordonnées monde) ; côté serveur uniquement, répliqué aux clients
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Voxel Terrain")
+    void CarveCrater(const FVector& WorldCenter, float Radius);
+    
+    // Le point monde est-il dans la matière ?
+    UFUNCTION(BlueprintCallable, Category = "Voxel Terrain")
+    bool IsPointInsideTerrain(const FVector& WorldLocation) const;
+    
+    // Bornes monde du volume
+    FBox GetTerrainWorldBounds() const;
+    
+    SIZE_T GetAllocatedSize() const
+    {
+        return Volume.GetAllocatedSize() + Craters.GetAllocatedSize() + ReplicatedCraters.GetAllocatedSize();
+    }
+    
+    // Distance entre deux échantillons
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Voxel Terrain", meta = (ClampMin = "1.0"))
+    float VoxelSize;
+    
+    // Échantillons par arête de chunk : un cratère remaille quelques chunks de ChunkSize^3 échantillons
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Voxel Terrain", meta = (ClampMin = "4", ClampMax = "64"))
+    int32 ChunkSize;
+    
+    // Étendue du volume, en chunks
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Voxel Terrain")
+    FIntVector ChunkCount;
+    
+    // Hauteur moyenne du sol, en fraction de la hauteur du volume
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Voxel Terrain|Generation", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float GroundLevel;
+    
+    // Amplitude des collines (unités monde)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Voxel Terrain|Generation", meta = (ClampMin = "0.0"))
+    float HillAmplitude;
+    
+    // Largeur typique d'une colline (unités monde)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Voxel Terrain|Generation", meta = (ClampMin = "1.0"))
+    float HillWavelength;
+    
+    // Graine du relief, identique sur toutes les machines
+    UPROPERTY(Replicated, EditAnywhere, BlueprintReadOnly, Category = "Voxel Terrain|Generation")
+    int32 Seed;
+    
+    UPROPERTY(EditDefaultsOnly, Category = "Voxel Terrain|Materials")
+    UMaterialInterface* TerrainMaterial;
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+    
+    // Cratères creusés par le serveur, dans l'ordre ; un client ne rejoue que ceux qu'il n'a pas encore appliqués
+    TArray<FVoxelCrater> Craters;
+    
+    // Craters quantifiés et découpés en morceaux (8 octets par cratère) : un ajout ne renvoie que le dernier morceau.
+    // En tête, une époque incrémentée quand la liste est élaguée : les clients régénèrent alors le volume.
+    UPROPERTY(ReplicatedUsing = OnRep_Craters)
+    FTerrainReplicatedBytes ReplicatedCraters;
+    
+    UFUNCTION()
+    void OnRep_Craters();
+
+private:
+    // Génère le volume et lance le maillage de tous les chunks traversés par la surface
+    void GenerateVolume();
+    
+    // Applique les cratères reçus depuis le dernier appel
+    void ApplyPendingCraters();
+    
+    // Serveur : sérialise Craters dans ReplicatedCraters ; false au-delà de FTerrainReplicatedBytes::MaxBytes
+    bool ReplicateCraters();
+    
+    // Conversion entre un cratère et ses valeurs entières répliquées (huitièmes de voxel)
+    void WriteCrater(FArchive& Ar, const FVoxelCrater& Crater) const;
+    FVoxelCrater ReadCrater(FArchive& Ar) const;
+    
+    // Copie les échantillons de chaque chunk et lance leur maillage sur le pool de threads
+    void RemeshChunks(const TArray<FIntVector>& ChunkCoords);
+    
+    // Retour sur le game thread : ignoré si le chunk a été modifié depuis le lancement
+    void OnChunkMeshBuilt(const FIntVector& ChunkCoord, uint32 Version, const FTerrainVoxelChunkMesh& Mesh);
+    
+    UProceduralMeshComponent* FindOrCreateChunkComponent(const FIntVector& ChunkCoord);
+    
+    UPROPERTY(VisibleAnywhere, Category = "Components")
+    USceneComponent* VolumeRoot;
+    
+    // Un composant par chunk non vide, créé à la demande
+    UPROPERTY(Transient)
+    TMap<FIntVector, UProceduralMeshComponent*> ChunkComponents;
+    
+    // Version de chaque chunk, incrémentée à chaque demande de maillage
+    TMap<FIntVector, uint32> ChunkVersions;
+    
+    FTerrainVoxelVolume Volume;
+    bool bVolumeGenerated = false;
+    
+    // Nombre de cratères de Craters déjà appliqués au volume local
+    int32 AppliedCraterCount = 0;
+    
+    // Serveur : époque courante de la liste ; client : époque de la liste appliquée au volume
+    int32 CraterEpoch = 0;
+};
@@ -37,14 +37,30 @@ public:
     UPROPERTY(BlueprintReadWrite, Category = "Turns")
     TArray<AController*> AllPlayerControllers;
     
-    // Points de spawn
+    // Points de spawn (n'est plus rempli automatiquement : voir PlaceWormsOnTerrain)
     UPROPERTY(BlueprintReadWrite, Category = "Game")
     TArray<AActor*> SpawnPoints;
 
+    // Positions d'apparition calculées sur la surface des terrains destructibles
+    UPROPERTY(BlueprintReadOnly, Category = "Game")
+    TArray<FTransform> WormSpawnTransforms;
+
+    // Distance minimale entre deux vers lors du placement
+    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Game")
+    float WormSpawnSeparation;
+
+    // Place tous les vers sur la surface des terrains, espacés par échantillonnage de Poisson
+    UFUNCTION(BlueprintCallable, Category = "Game")
+    void PlaceWormsOnTerrain();
+
     // Fonction utilitaire pour obtenir le personnage contrôlé par un controller
     UFUNCTION(BlueprintCallable, Category = "Helpers")
     AWormCharacter* GetWormCharacterFromController(AController* Controller);
 
+    // Personnage du joueur dont c'est le tour (nullptr entre deux tours)
+    UFUNCTION(BlueprintCallable, Category = "Turns")
+    AWormCharacter* GetActiveWorm() const;
+
     // Index du controller actif
     UPROPERTY(BlueprintReadWrite, Category = "Turns")
     int32 CurrentPlayerIndex;
@@ -67,6 +83,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Test")
     void SpawnTestTerrain();
 
+    // Niveau de test : grille d'îles indépendantes (4 x 4 par défaut), chacune étant son propre terrain
+    // Les valeurs par défaut d'une UFUNCTION Exec ne sont pas appliquées hors éditeur : 0 ou moins vaut 4
+    // Également lancé au démarrage par l'option d'URL ?Islands=LxH (ex. "open Map01?Islands=4x4")
+    UFUNCTION(Exec, BlueprintCallable, Category = "Test")
+    void SpawnTerrainIslands(int32 CountX = 4, int32 CountY = 4);
+
+    UPROPERTY(EditDefaultsOnly, Category = "Test")
+    float IslandSize;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Test")
+    float IslandSpacing;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Test")
+    TArray<ADestructibleTerrain*> TerrainIslands;
+
     UPROPERTY(EditDefaultsOnly, Category = "Weapons")
     TArray<TSubclassOf<AWormWeapon>> AvailableWeaponTypes;
 
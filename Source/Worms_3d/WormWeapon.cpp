@@ -11,6 +11,7 @@
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "DestructibleTerrainSubsystem.h"
 
 
 AWormWeapon::AWormWeapon()
@@ -248,38 +249,45 @@ void AWormWeapon::UpdateTrajectory()
     // Ajouter le point initial
     SimulatedTrajectoryPoints.Add(CurrentLocation);
     
-    // Préparer les paramètres de collision
-    FCollisionQueryParams CollisionParams;
-    CollisionParams.AddIgnoredActor(this);
-    CollisionParams.AddIgnoredActor(GetOwner());
+    // Les impacts sur le terrain sont cherchés directement dans la grille des terrains (requête native) ;
+    // le reste du niveau (murs, décor statique) passe par une trace physique qui ignore les terrains
+    UDestructibleTerrainSubsystem* TerrainSubsystem = GetWorld()->GetSubsystem<UDestructibleTerrainSubsystem>();
+    
+    // Trace complexe, comme avant le passage à la grille : le décor statique est touché au triangle près
+    FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrajectory), true, this);
+    TraceParams.AddIgnoredActor(GetOwner());
+    TraceParams.bReturnPhysicalMaterial = true;
     
     // IMPORTANT: Ignorer tous les personnages Worm et leurs armes
     TArray<AActor*> AllWormCharacters;
     UGameplayStatics::GetAllActorsOfClass(GetWorld(), AWormCharacter::StaticClass(), AllWormCharacters);
     for (AActor* Actor : AllWormCharacters)
     {
-        CollisionParams.AddIgnoredActor(Actor);
+        TraceParams.AddIgnoredActor(Actor);
         
         // Ignorer aussi les armes attachées
         AWormCharacter* Character = Cast<AWormCharacter>(Actor);
         if (Character && Character->CurrentWeapon)
         {
-            CollisionParams.AddIgnoredActor(Character->CurrentWeapon);
+            TraceParams.AddIgnoredActor(Character->CurrentWeapon);
         }
     }
     
     // Ignorer aussi toutes les armes
     TArray<AActor*> AllWeapons;
     UGameplayStatics::GetAllActorsOfClass(GetWorld(), AWormWeapon::StaticClass(), AllWeapons);
-    for (AActor* Weapon : AllWeapons)
+    TraceParams.AddIgnoredActors(AllWeapons);
+    
+    if (TerrainSubsystem)
     {
-        CollisionParams.AddIgnoredActor(Weapon);
+        TArray<ADestructibleTerrain*> Terrains;
+        TerrainSubsystem->GetAllTerrains(Terrains);
+        for (ADestructibleTerrain* Terrain : Terrains)
+        {
+            TraceParams.AddIgnoredActor(Terrain);
+        }
     }
     
-    // Configuration de la collision (plus de détails et d'informations)
-    CollisionParams.bTraceComplex = true;
-    CollisionParams.bReturnPhysicalMaterial = true;
-    
     // Simuler chaque étape
     bool bHitSomething = false;
     for (float CurrentTime = 0.0f; CurrentTime < MaxSimTime && SimulatedTrajectoryPoints.Num() < TrajectoryPointCount; CurrentTime += TimeStep)
@@ -295,21 +303,30 @@ void AWormWeapon::UpdateTrajectory()
         SimulatedTrajectoryPoints.Add(CurrentLocation);
         
         // Vérifier si le point a touché quelque chose
-        FHitResult HitResult;
+        FTerrainQueryHit HitResult;
+        ADestructibleTerrain* HitTerrain = nullptr;
         FVector EndTrace = CurrentLocation + CurrentVelocity * TimeStep;
         
-        // Tracer la ligne pour détecter les collisions (utiliser ECC_Visibility au lieu de ECC_WorldStatic)
-        if (GetWorld()->LineTraceSingleByChannel(HitResult, CurrentLocation, EndTrace, ECC_Visibility, CollisionParams))
+        // Segment contre la grille des terrains traversés, puis contre le reste du niveau : le plus proche l'emporte
+        const bool bHitTerrain = TerrainSubsystem && TerrainSubsystem->RaycastTerrains(CurrentLocation, EndTrace, HitResult, &HitTerrain);
+        
+        FHitResult WorldHit;
+        const bool bHitWorld = GetWorld()->LineTraceSingleByChannel(WorldHit, CurrentLocation, EndTrace, ECC_Visibility, TraceParams) &&
+            (!bHitTerrain || WorldHit.Time < HitResult.Time);
+        
+        if (bHitTerrain || bHitWorld)
         {
+            const FVector ImpactLocation = bHitWorld ? FVector(WorldHit.Location) : HitResult.Location;
+            
             // Debug
             UE_LOG(LogTemp, Verbose, TEXT("Trajectory hit: %s at %s"), 
-                *HitResult.GetActor()->GetName(), *HitResult.Location.ToString());
+                bHitWorld ? *GetNameSafe(WorldHit.GetActor()) : *HitTerrain->GetName(), *ImpactLocation.ToString());
             
             // Dessiner un point de débug à l'emplacement de l'impact (visible en PIE)
-            DrawDebugSphere(GetWorld(), HitResult.Location, 20.0f, 8, FColor::Red, false, 0.1f);
+            DrawDebugSphere(GetWorld(), ImpactLocation, 20.0f, 8, FColor::Red, false, 0.1f);
             
             // Ajouter le point d'impact et arrêter la simulation
-            SimulatedTrajectoryPoints.Add(HitResult.Location);
+            SimulatedTrajectoryPoints.Add(ImpactLocation);
             bHitSomething = true;
             break;
         }
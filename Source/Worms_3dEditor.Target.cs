@@ -10,6 +10,6 @@ public class Worms_3dEditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 
-		ExtraModuleNames.AddRange( new string[] { "Worms_3d" } );
+		ExtraModuleNames.AddRange( new string[] { "Worms_3d", "TerrainCore", "TerrainCoreTests" } );
 	}
 }